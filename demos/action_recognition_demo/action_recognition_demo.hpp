@@ -0,0 +1,132 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <string>
+#include <vector>
+#include <gflags/gflags.h>
+#include <iostream>
+
+/// @brief message for help argument
+static const char help_message[] = "Print a usage message.";
+
+/// @brief message for video argument
+static const char video_message[] = "Required. Paths to video files separated by a space (specify \"cam\" to work with camera). "
+"Every input is processed as a separate stream.";
+
+/// @brief message for encoder model argument
+static const char encoder_model_message[] = "Required. Path to an .xml file with a trained encoder model.";
+
+/// @brief message for decoder model argument
+static const char decoder_model_message[] = "Required. Path to an .xml file with a trained decoder model.";
+
+/// @brief message for assigning encoder calculation to device
+static const char target_device_encoder_message[] = "Optional. Specify the target device to infer the encoder on (the list of available devices is shown below). " \
+"Default value is CPU. Use \"-d_en HETERO:<comma-separated_devices_list>\" format to specify HETERO plugin. " \
+"The demo will look for a suitable plugin for a specified device.";
+
+/// @brief message for assigning decoder calculation to device
+static const char target_device_decoder_message[] = "Optional. Specify the target device to infer the decoder on (the list of available devices is shown below). " \
+"Default value is CPU. Use \"-d_de HETERO:<comma-separated_devices_list>\" format to specify HETERO plugin. " \
+"The demo will look for a suitable plugin for a specified device.";
+
+/// @brief message for performance counters
+static const char performance_counter_message[] = "Optional. Enables per-layer performance report.";
+
+/// @brief message for clDNN custom kernels desc
+static const char custom_cldnn_message[] = "Required for GPU custom kernels. "\
+"Absolute path to the .xml file with the kernels descriptions.";
+
+/// @brief message for user library argument
+static const char custom_cpu_library_message[] = "Required for CPU custom layers. " \
+"Absolute path to a shared library with the kernels implementations.";
+
+/// @brief message for labels argument
+static const char labels_message[] = "Optional. Path to a file with label names, one label per line.";
+
+/// @brief message for encoder batch size argument
+static const char encoder_batch_message[] = "Optional. Number of frames encoded in one infer request. " \
+"Frames are taken from all streams in turn. Default value is the number of streams.";
+
+/// @brief message for window stride argument
+static const char window_stride_message[] = "Optional. Number of frames between two consecutive windows " \
+"processed by the decoder for a stream. Default value is 1.";
+
+/// @brief message for no show processed video
+static const char no_show_processed_video[] = "Optional. Do not show processed video.";
+
+/// \brief Define flag for showing help message <br>
+DEFINE_bool(h, false, help_message);
+
+/// \brief Define parameter for set video file <br>
+/// It is a required parameter
+DEFINE_string(i, "", video_message);
+
+/// \brief Define parameter for set encoder model file <br>
+/// It is a required parameter
+DEFINE_string(m_en, "", encoder_model_message);
+
+/// \brief Define parameter for set decoder model file <br>
+/// It is a required parameter
+DEFINE_string(m_de, "", decoder_model_message);
+
+/// \brief device the target device to infer the encoder on <br>
+DEFINE_string(d_en, "CPU", target_device_encoder_message);
+
+/// \brief device the target device to infer the decoder on <br>
+DEFINE_string(d_de, "CPU", target_device_decoder_message);
+
+/// \brief Enable per-layer performance report
+DEFINE_bool(pc, false, performance_counter_message);
+
+/// @brief clDNN custom kernels path <br>
+/// Default is ./lib
+DEFINE_string(c, "", custom_cldnn_message);
+
+/// @brief Absolute path to CPU library with user layers <br>
+/// It is a optional parameter
+DEFINE_string(l, "", custom_cpu_library_message);
+
+/// \brief Define parameter for labels file <br>
+/// It is a optional parameter
+DEFINE_string(lb, "", labels_message);
+
+/// \brief Define parameter for encoder batch size <br>
+/// It is a optional parameter
+DEFINE_uint32(b, 0, encoder_batch_message);
+
+/// \brief Define parameter for decoder window stride <br>
+/// It is a optional parameter
+DEFINE_uint32(s, 1, window_stride_message);
+
+/// \brief Flag to disable processed video showing<br>
+/// It is an optional parameter
+DEFINE_bool(no_show, false, no_show_processed_video);
+
+
+/**
+* \brief This function show a help message
+*/
+static void showUsage() {
+    std::cout << std::endl;
+    std::cout << "action_recognition_demo [OPTION]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << std::endl;
+    std::cout << "    -h                        " << help_message << std::endl;
+    std::cout << "    -i \"<path1>\" \"<path2>\"    " << video_message << std::endl;
+    std::cout << "    -m_en \"<path>\"            " << encoder_model_message << std::endl;
+    std::cout << "    -m_de \"<path>\"            " << decoder_model_message << std::endl;
+    std::cout << "      -l \"<absolute_path>\"    " << custom_cpu_library_message << std::endl;
+    std::cout << "          Or" << std::endl;
+    std::cout << "      -c \"<absolute_path>\"    " << custom_cldnn_message << std::endl;
+    std::cout << "    -d_en \"<device>\"          " << target_device_encoder_message << std::endl;
+    std::cout << "    -d_de \"<device>\"          " << target_device_decoder_message << std::endl;
+    std::cout << "    -pc                       " << performance_counter_message << std::endl;
+    std::cout << "    -lb \"<path>\"              " << labels_message << std::endl;
+    std::cout << "    -b                        " << encoder_batch_message << std::endl;
+    std::cout << "    -s                        " << window_stride_message << std::endl;
+    std::cout << "    -no_show                  " << no_show_processed_video << std::endl;
+}
@@ -0,0 +1,51 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Ring buffer keeping embeddings of the last frames of a stream.
+ * Every frame is encoded once, a decoder window is assembled from the stored embeddings.
+ */
+class EmbeddingsBuffer {
+public:
+    EmbeddingsBuffer(size_t windowSize, size_t embeddingSize) :
+        windowSize(windowSize), embeddingSize(embeddingSize),
+        data(windowSize * embeddingSize), first(0), size(0) {}
+
+    void push(const float* embedding) {
+        size_t slot = (first + size) % windowSize;
+        std::copy(embedding, embedding + embeddingSize, data.begin() + slot * embeddingSize);
+        if (size < windowSize) {
+            ++size;
+        } else {
+            first = (first + 1) % windowSize;
+        }
+    }
+
+    bool full() const {
+        return size == windowSize;
+    }
+
+    /**
+     * @brief Copies the stored embeddings from the oldest to the newest one into a decoder input,
+     * the buffer must be full
+     */
+    void copyWindow(float* dst) const {
+        auto begin = data.begin() + first * embeddingSize;
+        dst = std::copy(begin, data.end(), dst);
+        std::copy(data.begin(), begin, dst);
+    }
+
+private:
+    const size_t windowSize;
+    const size_t embeddingSize;
+    std::vector<float> data;
+    size_t first;
+    size_t size;
+};
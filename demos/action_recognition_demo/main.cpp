@@ -0,0 +1,434 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+* \brief The entry point for the Inference Engine action_recognition demo application
+* \file action_recognition_demo/main.cpp
+* \example action_recognition_demo/main.cpp
+*/
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+#include <samples/ocv_common.hpp>
+#include <samples/slog.hpp>
+
+#include "action_recognition_demo.hpp"
+#include "embeddings_buffer.hpp"
+#include <ext_list.hpp>
+
+using namespace InferenceEngine;
+
+namespace {
+
+bool ParseAndCheckCommandLine(int argc, char *argv[]) {
+    // ---------------------------Parsing and validation of input args--------------------------------------
+    gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+    if (FLAGS_h) {
+        showUsage();
+        showAvailableDevices();
+        return false;
+    }
+    slog::info << "Parsing input parameters" << slog::endl;
+
+    if (FLAGS_i.empty()) {
+        throw std::logic_error("Parameter -i is not set");
+    }
+    if (FLAGS_m_en.empty()) {
+        throw std::logic_error("Parameter -m_en is not set");
+    }
+    if (FLAGS_m_de.empty()) {
+        throw std::logic_error("Parameter -m_de is not set");
+    }
+    if (FLAGS_s == 0) {
+        throw std::logic_error("Parameter -s can not be zero");
+    }
+    return true;
+}
+
+/**
+* \brief Collects all values of the -i parameter, as inputs may be cameras they are not checked for existence
+*/
+std::vector<std::string> parseInputs() {
+    std::vector<std::string> inputs;
+    std::vector<std::string> args = gflags::GetArgvs();
+    bool readArguments = false;
+    for (size_t i = 0; i < args.size(); i++) {
+        if (args[i] == "-i" || args[i] == "--i") {
+            readArguments = true;
+            continue;
+        }
+        if (!readArguments) {
+            continue;
+        }
+        if (args[i].c_str()[0] == '-') {
+            break;
+        }
+        inputs.push_back(args[i]);
+    }
+    if (inputs.empty()) {
+        inputs.push_back(FLAGS_i);
+    }
+    return inputs;
+}
+
+std::vector<std::string> readLabels(const std::string& path) {
+    std::vector<std::string> labels;
+    if (path.empty()) {
+        return labels;
+    }
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open labels file: " + path);
+    }
+    std::string label;
+    while (std::getline(file, label)) {
+        labels.push_back(trim(label));
+    }
+    return labels;
+}
+
+CNNNetwork readNetwork(const std::string& modelPath, size_t batchSize) {
+    CNNNetReader netReader;
+    netReader.ReadNetwork(modelPath);
+    netReader.ReadWeights(fileNameNoExt(modelPath) + ".bin");
+    CNNNetwork network = netReader.getNetwork();
+    if (network.getInputsInfo().size() != 1) {
+        throw std::logic_error("Demo supports topologies only with 1 input: " + modelPath);
+    }
+    if (network.getOutputsInfo().size() != 1) {
+        throw std::logic_error("Demo supports topologies only with 1 output: " + modelPath);
+    }
+    network.setBatchSize(batchSize);
+    return network;
+}
+
+/**
+* \brief Resizes the smaller side of a frame to the encoder input size and crops the center of it
+*/
+cv::Mat cropToEncoderInput(const cv::Mat& frame, const cv::Size& inputSize) {
+    double scale = std::max(static_cast<double>(inputSize.width) / frame.cols,
+                            static_cast<double>(inputSize.height) / frame.rows);
+    cv::Mat resized;
+    cv::resize(frame, resized, cv::Size(std::max(static_cast<int>(std::round(frame.cols * scale)), inputSize.width),
+                                        std::max(static_cast<int>(std::round(frame.rows * scale)), inputSize.height)));
+    cv::Rect crop((resized.cols - inputSize.width) / 2, (resized.rows - inputSize.height) / 2,
+                  inputSize.width, inputSize.height);
+    return resized(crop);
+}
+
+struct Stream {
+    std::string name;
+    cv::VideoCapture capture;
+    bool finished = false;
+    EmbeddingsBuffer embeddings;
+    size_t framesSinceWindow = 0;
+    cv::Mat lastFrame;
+    int label = -1;
+    float confidence = 0.f;
+
+    Stream(const std::string& name, size_t windowSize, size_t embeddingSize) :
+        name(name), embeddings(windowSize, embeddingSize) {
+        bool opened = name == "cam" ? capture.open(0) : capture.open(name);
+        if (!opened) {
+            throw std::logic_error("Cannot open input file or camera: " + name);
+        }
+    }
+};
+
+/**
+* \brief Encoder infer request with the streams of the frames it holds
+*/
+struct EncoderJob {
+    InferRequest::Ptr request;
+    std::vector<std::pair<size_t, cv::Mat>> frames;
+};
+
+struct DecoderJob {
+    InferRequest::Ptr request;
+    size_t streamId;
+};
+
+void renderStreams(const std::vector<std::unique_ptr<Stream>>& streams, const std::vector<std::string>& labels,
+                   double fps) {
+    const cv::Size cellSize(640, 360);
+    const int cols = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(streams.size()))));
+    const int rows = static_cast<int>((streams.size() + cols - 1) / cols);
+    cv::Mat canvas = cv::Mat::zeros(cellSize.height * rows, cellSize.width * cols, CV_8UC3);
+    for (size_t i = 0; i < streams.size(); i++) {
+        const Stream& stream = *streams[i];
+        if (stream.lastFrame.empty()) {
+            continue;
+        }
+        cv::Mat cell = canvas(cv::Rect(cellSize.width * static_cast<int>(i % cols),
+                                       cellSize.height * static_cast<int>(i / cols), cellSize.width, cellSize.height));
+        cv::resize(stream.lastFrame, cell, cellSize);
+        std::string text = "Preparing...";
+        if (stream.label >= 0) {
+            text = static_cast<size_t>(stream.label) < labels.size() ? labels[stream.label] : "#" + std::to_string(stream.label);
+            text += cv::format(" - %.2f%%", stream.confidence * 100.f);
+        }
+        cv::rectangle(cell, cv::Rect(0, 0, cellSize.width, 40), cv::Scalar(0, 0, 0), cv::FILLED);
+        cv::putText(cell, text, cv::Point(10, 28), cv::FONT_HERSHEY_DUPLEX, 0.8, cv::Scalar(255, 255, 255));
+    }
+    cv::putText(canvas, cv::format("%.1f fps", fps), cv::Point(10, canvas.rows - 15), cv::FONT_HERSHEY_DUPLEX, 0.8,
+                cv::Scalar(0, 255, 0));
+    cv::imshow("Action Recognition", canvas);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        std::cout << "InferenceEngine: " << GetInferenceEngineVersion() << std::endl;
+
+        // ------------------------------ Parsing and validation of input args ---------------------------------
+        if (!ParseAndCheckCommandLine(argc, argv)) {
+            return 0;
+        }
+        const std::vector<std::string> inputs = parseInputs();
+        const std::vector<std::string> labels = readLabels(FLAGS_lb);
+        const size_t encoderBatch = FLAGS_b == 0 ? inputs.size() : FLAGS_b;
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 1. Load inference engine -------------------------------------
+        slog::info << "Loading Inference Engine" << slog::endl;
+        Core ie;
+
+        std::set<std::string> devices = {FLAGS_d_en, FLAGS_d_de};
+        for (const auto& device : devices) {
+            slog::info << "Device info: " << slog::endl;
+            std::cout << ie.GetVersions(device);
+            if (device.find("CPU") != std::string::npos) {
+                ie.AddExtension(std::make_shared<Extensions::Cpu::CpuExtensions>(), "CPU");
+            }
+        }
+        if (!FLAGS_l.empty()) {
+            // CPU(MKLDNN) extensions are loaded as a shared library and passed as a pointer to base extension
+            IExtensionPtr extension_ptr = make_so_pointer<IExtension>(FLAGS_l.c_str());
+            ie.AddExtension(extension_ptr, "CPU");
+        }
+        if (!FLAGS_c.empty()) {
+            // clDNN Extensions are loaded from an .xml description and OpenCL kernel files
+            ie.SetConfig({{PluginConfigParams::KEY_CONFIG_FILE, FLAGS_c}}, "GPU");
+        }
+        if (FLAGS_pc) {
+            ie.SetConfig({ { PluginConfigParams::KEY_PERF_COUNT, PluginConfigParams::YES } });
+        }
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 2. Read and load the encoder and the decoder ----------------------------
+        slog::info << "Loading encoder " << FLAGS_m_en << " with batch size " << encoderBatch << slog::endl;
+        CNNNetwork encoderNetwork = readNetwork(FLAGS_m_en, encoderBatch);
+        InputInfo::Ptr encoderInputInfo = encoderNetwork.getInputsInfo().begin()->second;
+        encoderInputInfo->setPrecision(Precision::U8);
+        encoderInputInfo->setLayout(Layout::NCHW);
+        const std::string encoderInputName = encoderNetwork.getInputsInfo().begin()->first;
+        const std::string encoderOutputName = encoderNetwork.getOutputsInfo().begin()->first;
+        encoderNetwork.getOutputsInfo().begin()->second->setPrecision(Precision::FP32);
+        const SizeVector encoderInputDims = encoderInputInfo->getTensorDesc().getDims();
+        const cv::Size encoderInputSize(static_cast<int>(encoderInputDims[3]), static_cast<int>(encoderInputDims[2]));
+
+        slog::info << "Loading decoder " << FLAGS_m_de << slog::endl;
+        CNNNetwork decoderNetwork = readNetwork(FLAGS_m_de, 1);
+        InputInfo::Ptr decoderInputInfo = decoderNetwork.getInputsInfo().begin()->second;
+        decoderInputInfo->setPrecision(Precision::FP32);
+        const std::string decoderInputName = decoderNetwork.getInputsInfo().begin()->first;
+        const std::string decoderOutputName = decoderNetwork.getOutputsInfo().begin()->first;
+        decoderNetwork.getOutputsInfo().begin()->second->setPrecision(Precision::FP32);
+        const SizeVector decoderInputDims = decoderInputInfo->getTensorDesc().getDims();
+        if (decoderInputDims.size() != 3) {
+            throw std::logic_error("Decoder input is expected to have [batch, frames, embedding] layout");
+        }
+        const size_t windowSize = decoderInputDims[1];
+        const size_t embeddingSize = decoderInputDims[2];
+
+        ExecutableNetwork encoder = ie.LoadNetwork(encoderNetwork, FLAGS_d_en);
+        ExecutableNetwork decoder = ie.LoadNetwork(decoderNetwork, FLAGS_d_de);
+
+        // Two encoder requests: a batch of frames is read and preprocessed while the previous one is encoded
+        std::vector<EncoderJob> encoderJobs(2);
+        for (auto& job : encoderJobs) {
+            job.request = encoder.CreateInferRequestPtr();
+        }
+        const size_t encoderOutputSize = encoderJobs[0].request->GetBlob(encoderOutputName)->size() / encoderBatch;
+        if (encoderOutputSize != embeddingSize) {
+            throw std::logic_error("Encoder output size " + std::to_string(encoderOutputSize)
+                                   + " does not match decoder embedding size " + std::to_string(embeddingSize));
+        }
+        // Decoder requests are shared by the streams, windows are decoded in the order they are completed
+        std::vector<InferRequest::Ptr> freeDecoderRequests;
+        for (size_t i = 0; i < std::max(encoderBatch, inputs.size()); i++) {
+            freeDecoderRequests.push_back(decoder.CreateInferRequestPtr());
+        }
+        std::deque<DecoderJob> busyDecoderRequests;
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 3. Open inputs ----------------------------------------------------------
+        std::vector<std::unique_ptr<Stream>> streams;
+        for (const auto& input : inputs) {
+            slog::info << "Opening input " << input << slog::endl;
+            streams.emplace_back(new Stream(input, windowSize, embeddingSize));
+        }
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 4. Processing -----------------------------------------------------------
+        auto finishDecoding = [&](const DecoderJob& job) {
+            job.request->Wait(IInferRequest::WaitMode::RESULT_READY);
+            Blob::Ptr output = job.request->GetBlob(decoderOutputName);
+            const float* logits = output->buffer().as<float*>();
+            const size_t classesNum = output->size();
+            const float maxLogit = *std::max_element(logits, logits + classesNum);
+            float sum = 0.f;
+            for (size_t i = 0; i < classesNum; i++) {
+                sum += std::exp(logits[i] - maxLogit);
+            }
+            Stream& stream = *streams[job.streamId];
+            stream.label = static_cast<int>(std::max_element(logits, logits + classesNum) - logits);
+            stream.confidence = 1.f / sum;
+            freeDecoderRequests.push_back(job.request);
+        };
+
+        auto startDecoding = [&](size_t streamId) {
+            if (freeDecoderRequests.empty()) {
+                finishDecoding(busyDecoderRequests.front());
+                busyDecoderRequests.pop_front();
+            }
+            InferRequest::Ptr request = freeDecoderRequests.back();
+            freeDecoderRequests.pop_back();
+            streams[streamId]->embeddings.copyWindow(request->GetBlob(decoderInputName)->buffer().as<float*>());
+            request->StartAsync();
+            busyDecoderRequests.push_back({request, streamId});
+        };
+
+        size_t nextStream = 0;
+        // Reads the next frame of every stream in turn until the batch is full
+        auto fillBatch = [&](EncoderJob& job) {
+            Blob::Ptr inputBlob = job.request->GetBlob(encoderInputName);
+            size_t finishedStreams = 0;
+            while (job.frames.size() < encoderBatch && finishedStreams < streams.size()) {
+                size_t streamId = nextStream;
+                nextStream = (nextStream + 1) % streams.size();
+                Stream& stream = *streams[streamId];
+                cv::Mat frame;
+                if (stream.finished || !stream.capture.read(frame)) {
+                    stream.finished = true;
+                    ++finishedStreams;
+                    continue;
+                }
+                finishedStreams = 0;
+                matU8ToBlob<uint8_t>(cropToEncoderInput(frame, encoderInputSize), inputBlob,
+                                     static_cast<int>(job.frames.size()));
+                job.frames.emplace_back(streamId, frame);
+            }
+            return !job.frames.empty();
+        };
+
+        // Every frame is encoded once, its embedding is shared by all windows the frame belongs to
+        auto harvestBatch = [&](EncoderJob& job) {
+            job.request->Wait(IInferRequest::WaitMode::RESULT_READY);
+            const float* embeddings = job.request->GetBlob(encoderOutputName)->buffer().as<float*>();
+            for (size_t i = 0; i < job.frames.size(); i++) {
+                Stream& stream = *streams[job.frames[i].first];
+                stream.embeddings.push(embeddings + i * embeddingSize);
+                stream.lastFrame = job.frames[i].second;
+                if (++stream.framesSinceWindow >= FLAGS_s && stream.embeddings.full()) {
+                    stream.framesSinceWindow = 0;
+                    startDecoding(job.frames[i].first);
+                }
+            }
+            job.frames.clear();
+            while (!busyDecoderRequests.empty()
+                   && busyDecoderRequests.front().request->Wait(IInferRequest::WaitMode::STATUS_ONLY) == StatusCode::OK) {
+                finishDecoding(busyDecoderRequests.front());
+                busyDecoderRequests.pop_front();
+            }
+        };
+
+        std::cout << "To close the application, press 'CTRL+C' here";
+        if (!FLAGS_no_show) {
+            std::cout << " or switch to the output window and press ESC key";
+        }
+        std::cout << std::endl;
+
+        typedef std::chrono::duration<double, std::ratio<1, 1>> sec;
+        const auto t0 = std::chrono::steady_clock::now();
+        size_t framesNum = 0;
+        size_t current = 0;
+        bool running = true;
+        while (running) {
+            EncoderJob& currentJob = encoderJobs[current];
+            EncoderJob& previousJob = encoderJobs[1 - current];
+            const bool haveFrames = fillBatch(currentJob);
+            if (haveFrames) {
+                currentJob.request->StartAsync();
+            }
+            if (!previousJob.frames.empty()) {
+                framesNum += previousJob.frames.size();
+                harvestBatch(previousJob);
+                if (!FLAGS_no_show) {
+                    double fps = framesNum / std::chrono::duration_cast<sec>(std::chrono::steady_clock::now() - t0).count();
+                    renderStreams(streams, labels, fps);
+                    const int key = cv::waitKey(1);
+                    if (27 == key) {  // Esc
+                        running = false;
+                    }
+                }
+            }
+            running = running && haveFrames;
+            current = 1 - current;
+        }
+        for (auto& job : encoderJobs) {
+            if (!job.frames.empty()) {
+                framesNum += job.frames.size();
+                harvestBatch(job);
+            }
+        }
+        while (!busyDecoderRequests.empty()) {
+            finishDecoding(busyDecoderRequests.front());
+            busyDecoderRequests.pop_front();
+        }
+        const double elapsed = std::chrono::duration_cast<sec>(std::chrono::steady_clock::now() - t0).count();
+        // -----------------------------------------------------------------------------------------------------
+
+        slog::info << "Processed " << framesNum << " frames of " << streams.size() << " streams: "
+                   << framesNum / elapsed << " fps" << slog::endl;
+        for (const auto& stream : streams) {
+            slog::info << stream->name << ": "
+                       << (stream->label < 0 ? std::string("no prediction")
+                           : static_cast<size_t>(stream->label) < labels.size() ? labels[stream->label]
+                           : "#" + std::to_string(stream->label)) << slog::endl;
+        }
+
+        /** Show performace results **/
+        if (FLAGS_pc) {
+            printPerformanceCounts(*encoderJobs[0].request, std::cout, getFullDeviceName(ie, FLAGS_d_en));
+            printPerformanceCounts(*freeDecoderRequests[0], std::cout, getFullDeviceName(ie, FLAGS_d_de));
+        }
+    }
+    catch (const std::exception& error) {
+        slog::err << error.what() << slog::endl;
+        return 1;
+    }
+    catch (...) {
+        slog::err << "Unknown/internal exception happened." << slog::endl;
+        return 1;
+    }
+
+    slog::info << "Execution successful" << slog::endl;
+    return 0;
+}
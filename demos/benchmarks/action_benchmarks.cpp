@@ -0,0 +1,43 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core/core.hpp>
+
+#include "action_detector.hpp"
+#include "alloc_counter.hpp"
+
+namespace {
+
+// Parameters of ActionDetectorConfig
+const float nmsSigma = 0.6f;
+const int keepTopK = 200;
+const float detectionConfidenceThreshold = 0.65f;
+
+// Arguments: number of valid detections, number of persons they are clustered around
+void BM_SoftNonMaxSuppression(benchmark::State& state) {
+    cv::RNG rng(0);
+    std::vector<cv::Rect> persons;
+    for (int i = 0; i < state.range(1); i++) {
+        persons.emplace_back(rng.uniform(0, 1800), rng.uniform(0, 900), rng.uniform(40, 120), rng.uniform(100, 180));
+    }
+    DetectedActions detections;
+    for (int i = 0; i < state.range(0); i++) {
+        cv::Rect rect = persons[i % persons.size()];
+        rect += cv::Point(rng.uniform(-8, 8), rng.uniform(-8, 8));
+        detections.emplace_back(rect, rng.uniform(0, 3), rng.uniform(0.65f, 1.f), rng.uniform(0.5f, 1.f));
+    }
+    std::vector<int> indices;
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        ActionDetection::SoftNonMaxSuppression(detections, nmsSigma, keepTopK, detectionConfidenceThreshold,
+                                               &indices);
+        benchmark::DoNotOptimize(indices.data());
+    }
+}
+BENCHMARK(BM_SoftNonMaxSuppression)->Args({50, 10})->Args({200, 20})->Args({1000, 50});
+
+}  // namespace
@@ -0,0 +1,32 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+/// Returns the number of operator new calls made by the process so far
+std::size_t allocationsCount();
+
+/**
+ * @brief Reports heap allocations per iteration of a benchmark as the "allocs" counter.
+ * Create it right before the benchmark loop so that setup allocations are not counted.
+ * Buffers of cv::Mat are allocated by cv::fastMalloc and are not counted.
+ */
+class AllocationsReporter {
+public:
+    explicit AllocationsReporter(benchmark::State& state)
+        : state(state), start(allocationsCount()) {}
+
+    ~AllocationsReporter() {
+        state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocationsCount() - start),
+                                                      benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& state;
+    std::size_t start;
+};
@@ -0,0 +1,106 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inference_engine.hpp>
+#include <opencv2/core/core.hpp>
+
+#include "detectionoutput.h"
+#include "alloc_counter.hpp"
+
+namespace {
+
+const size_t classesNumber = 21;
+const size_t keepTopK = 200;
+
+Blob::Ptr makeBlob(const DataPtr& data) {
+    Blob::Ptr blob = make_shared_blob<float>(data->getTensorDesc());
+    blob->allocate();
+    return blob;
+}
+
+/**
+ * @brief DetectionOutput layer of Faster R-CNN (not normalized ROIs, class-specific
+ * box regression) with its input and output blobs filled for the given number of ROIs
+ */
+struct FasterRcnnOutputs {
+    DataPtr location;
+    DataPtr confidence;
+    DataPtr proposals;
+    DataPtr detections;
+    CNNLayer layer;
+    std::vector<Blob::Ptr> inputs;
+    std::vector<Blob::Ptr> outputs;
+
+    explicit FasterRcnnOutputs(size_t roisNumber)
+        : location(std::make_shared<Data>("bbox_pred",
+              TensorDesc(Precision::FP32, {roisNumber, classesNumber * 4}, Layout::NC))),
+          confidence(std::make_shared<Data>("cls_prob",
+              TensorDesc(Precision::FP32, {roisNumber, classesNumber}, Layout::NC))),
+          proposals(std::make_shared<Data>("proposals",
+              TensorDesc(Precision::FP32, {roisNumber, 5}, Layout::NC))),
+          detections(std::make_shared<Data>("detection_out",
+              TensorDesc(Precision::FP32, {1, 1, keepTopK, 7}, Layout::NCHW))),
+          layer(LayerParams{"detection_out", "DetectionOutput", Precision::FP32}) {
+        layer.params["num_classes"] = std::to_string(classesNumber);
+        layer.params["share_location"] = "0";
+        layer.params["normalized"] = "0";
+        layer.params["nms_threshold"] = "0.3";
+        layer.params["confidence_threshold"] = "0.01";
+        layer.params["keep_top_k"] = std::to_string(keepTopK);
+        layer.params["code_type"] = "caffe.PriorBoxParameter.CENTER_SIZE";
+        layer.params["input_height"] = "600";
+        layer.params["input_width"] = "1000";
+        layer.insData = {location, confidence, proposals};
+        layer.outData = {detections};
+
+        cv::RNG rng(0);
+        inputs = {makeBlob(location), makeBlob(confidence), makeBlob(proposals)};
+        outputs = {makeBlob(detections)};
+
+        float* deltas = inputs[0]->buffer();
+        for (size_t i = 0; i < inputs[0]->size(); i++) {
+            deltas[i] = static_cast<float>(rng.gaussian(0.1));
+        }
+        float* scores = inputs[1]->buffer();
+        for (size_t roi = 0; roi < roisNumber; roi++) {
+            // Background is the most probable class for most of the ROIs
+            float* roiScores = scores + roi * classesNumber;
+            size_t classId = rng.uniform(0.0, 1.0) < 0.2 ? rng.uniform(1, static_cast<int>(classesNumber)) : 0;
+            float restScore = 0.1f / (classesNumber - 1);
+            for (size_t c = 0; c < classesNumber; c++) {
+                roiScores[c] = c == classId ? 0.9f : restScore;
+            }
+        }
+        float* rois = inputs[2]->buffer();
+        for (size_t roi = 0; roi < roisNumber; roi++) {
+            float x = rng.uniform(0.f, 900.f);
+            float y = rng.uniform(0.f, 500.f);
+            rois[roi * 5 + 0] = 0.f;
+            rois[roi * 5 + 1] = x;
+            rois[roi * 5 + 2] = y;
+            rois[roi * 5 + 3] = x + rng.uniform(10.f, 100.f);
+            rois[roi * 5 + 4] = y + rng.uniform(10.f, 100.f);
+        }
+    }
+};
+
+// Argument: number of ROIs produced by the proposal layer
+void BM_DetectionOutputPostProcessor(benchmark::State& state) {
+    FasterRcnnOutputs data(static_cast<size_t>(state.range(0)));
+    DetectionOutputPostProcessor postProcessor(&data.layer);
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        postProcessor.execute(data.inputs, data.outputs, nullptr);
+        benchmark::DoNotOptimize(data.outputs[0]->buffer().as<float*>());
+    }
+}
+// Scratch buffers of the post-processor grow as ROIs^2 * classes^2, so larger ROI counts
+// do not fit into memory of a typical machine
+BENCHMARK(BM_DetectionOutputPostProcessor)->Arg(16)->Arg(32)->Arg(64);
+
+}  // namespace
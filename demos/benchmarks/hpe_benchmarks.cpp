@@ -0,0 +1,128 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "peak.hpp"
+#include "alloc_counter.hpp"
+
+using namespace human_pose_estimation;
+
+namespace {
+
+const size_t keypointsNumber = 18;
+const size_t pafsNumber = 38;
+// Limbs as they are decoded by groupPeaksToPoses: keypoint ids and PAF ids are 1-based,
+// PAF ids are offset by the number of heat maps
+const std::vector<std::pair<int, int> > limbIdsHeatmap = {
+    {2, 3}, {2, 6}, {3, 4}, {4, 5}, {6, 7}, {7, 8}, {2, 9}, {9, 10}, {10, 11}, {2, 12}, {12, 13}, {13, 14},
+    {2, 1}, {1, 15}, {15, 17}, {1, 16}, {16, 18}, {3, 17}, {6, 18}
+};
+const std::vector<std::pair<int, int> > limbIdsPaf = {
+    {31, 32}, {39, 40}, {33, 34}, {35, 36}, {41, 42}, {43, 44}, {19, 20}, {21, 22}, {23, 24}, {25, 26},
+    {27, 28}, {29, 30}, {47, 48}, {49, 50}, {53, 54}, {51, 52}, {55, 56}, {37, 38}, {45, 46}
+};
+
+// Parameters of HumanPoseEstimator
+const float minPeaksDistance = 3.0f;
+const float midPointsScoreThreshold = 0.05f;
+const float foundMidPointsRatioThreshold = 0.8f;
+const int minJointsNumber = 3;
+const float minSubsetScore = 0.2f;
+
+/**
+ * @brief Upsampled network output with the given number of synthetic people:
+ * Gaussian peaks on heat maps and unit vectors along limbs on PAFs.
+ */
+struct PoseMaps {
+    std::vector<cv::Mat> heatMaps;
+    std::vector<cv::Mat> pafs;
+
+    PoseMaps(const cv::Size& size, int posesNumber) {
+        cv::RNG rng(0);
+        for (size_t i = 0; i < keypointsNumber + 1; i++) {
+            heatMaps.push_back(cv::Mat::zeros(size, CV_32FC1));
+        }
+        for (size_t i = 0; i < pafsNumber; i++) {
+            pafs.push_back(cv::Mat::zeros(size, CV_32FC1));
+        }
+
+        const int poseSize = std::max(size.height / 4, 16);
+        for (int pose = 0; pose < posesNumber; pose++) {
+            cv::Point center(rng.uniform(poseSize / 2, size.width - poseSize / 2),
+                             rng.uniform(poseSize / 2, size.height - poseSize / 2));
+            std::vector<cv::Point> keypoints(keypointsNumber);
+            for (size_t i = 0; i < keypointsNumber; i++) {
+                keypoints[i] = center + cv::Point(rng.uniform(-poseSize / 2, poseSize / 2),
+                                                  rng.uniform(-poseSize / 2, poseSize / 2));
+                cv::circle(heatMaps[i], keypoints[i], 2, cv::Scalar(0.9), -1);
+            }
+            const int mapIdxOffset = keypointsNumber + 1;
+            for (size_t k = 0; k < limbIdsPaf.size(); k++) {
+                const cv::Point& jointA = keypoints[limbIdsHeatmap[k].first - 1];
+                const cv::Point& jointB = keypoints[limbIdsHeatmap[k].second - 1];
+                cv::Point2f direction = jointB - jointA;
+                float norm = static_cast<float>(cv::norm(direction));
+                if (norm > 0) {
+                    direction /= norm;
+                }
+                cv::line(pafs[limbIdsPaf[k].first - mapIdxOffset], jointA, jointB, cv::Scalar(direction.x), 3);
+                cv::line(pafs[limbIdsPaf[k].second - mapIdxOffset], jointA, jointB, cv::Scalar(direction.y), 3);
+            }
+        }
+        for (auto& heatMap : heatMaps) {
+            cv::GaussianBlur(heatMap, heatMap, cv::Size(7, 7), 2);
+        }
+    }
+
+    std::vector<std::vector<Peak> > findAllPeaks() const {
+        std::vector<std::vector<Peak> > allPeaks(heatMaps.size());
+        for (size_t i = 0; i < heatMaps.size(); i++) {
+            findPeaks(heatMaps, minPeaksDistance, allPeaks, static_cast<int>(i));
+        }
+        int peaksBefore = 0;
+        for (size_t i = 1; i < allPeaks.size(); i++) {
+            peaksBefore += static_cast<int>(allPeaks[i - 1].size());
+            for (auto& peak : allPeaks[i]) {
+                peak.id += peaksBefore;
+            }
+        }
+        return allPeaks;
+    }
+};
+
+// Arguments: upsampled feature map height (width is 16:9), number of people
+void BM_FindPeaks(benchmark::State& state) {
+    const int height = static_cast<int>(state.range(0));
+    PoseMaps maps(cv::Size(height * 16 / 9, height), static_cast<int>(state.range(1)));
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        std::vector<std::vector<Peak> > allPeaks(maps.heatMaps.size());
+        for (size_t i = 0; i < maps.heatMaps.size(); i++) {
+            findPeaks(maps.heatMaps, minPeaksDistance, allPeaks, static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(allPeaks.data());
+    }
+}
+BENCHMARK(BM_FindPeaks)->Args({128, 1})->Args({128, 8})->Args({256, 8})->Args({256, 32});
+
+void BM_GroupPeaksToPoses(benchmark::State& state) {
+    const int height = static_cast<int>(state.range(0));
+    PoseMaps maps(cv::Size(height * 16 / 9, height), static_cast<int>(state.range(1)));
+    auto allPeaks = maps.findAllPeaks();
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        auto poses = groupPeaksToPoses(allPeaks, maps.pafs, keypointsNumber, midPointsScoreThreshold,
+                                       foundMidPointsRatioThreshold, minJointsNumber, minSubsetScore);
+        benchmark::DoNotOptimize(poses.data());
+    }
+}
+BENCHMARK(BM_GroupPeaksToPoses)->Args({128, 1})->Args({128, 8})->Args({256, 8})->Args({256, 32});
+
+}  // namespace
@@ -0,0 +1,34 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <benchmark/benchmark.h>
+#include <inference_engine.hpp>
+#include <opencv2/core/core.hpp>
+
+#include <samples/ocv_common.hpp>
+
+#include "alloc_counter.hpp"
+
+namespace {
+
+// Arguments: source frame height (width is 16:9), network input side
+void BM_MatU8ToBlob(benchmark::State& state) {
+    const int height = static_cast<int>(state.range(0));
+    cv::Mat frame(height, height * 16 / 9, CV_8UC3);
+    cv::RNG rng(0);
+    rng.fill(frame, cv::RNG::UNIFORM, 0, 256);
+
+    const size_t side = static_cast<size_t>(state.range(1));
+    InferenceEngine::Blob::Ptr blob = InferenceEngine::make_shared_blob<uint8_t>(
+        InferenceEngine::TensorDesc(InferenceEngine::Precision::U8, {1, 3, side, side}, InferenceEngine::Layout::NCHW));
+    blob->allocate();
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        matU8ToBlob<uint8_t>(frame, blob);
+        benchmark::DoNotOptimize(blob->buffer().as<uint8_t*>());
+    }
+}
+BENCHMARK(BM_MatU8ToBlob)->Args({1080, 300})->Args({1080, 416})->Args({1080, 608})->Args({2160, 608});
+
+}  // namespace
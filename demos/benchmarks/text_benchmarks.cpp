@@ -0,0 +1,124 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "text_detection.hpp"
+#include "text_recognition.hpp"
+#include "alloc_counter.hpp"
+
+namespace {
+
+const int neighboursNumber = 8;
+const float clsConfThreshold = 0.8f;
+const float linkConfThreshold = 0.8f;
+
+/**
+ * @brief Dense view of a synthetic buffer in the logical order of its dimensions
+ */
+TensorView<const float> denseView(const std::vector<float>& data, const SizeVector& dims, Layout layout) {
+    SizeVector strides(dims.size(), 1);
+    for (size_t i = dims.size() - 1; i > 0; i--) {
+        strides[i - 1] = strides[i] * dims[i];
+    }
+    return TensorView<const float>(data.data(), dims, strides, layout);
+}
+
+/**
+ * @brief Two-class pixel and link scores of PixelLink in NCHW with the given number of text lines,
+ * as they are read by decodeImageByJoin from the network outputs
+ */
+struct PixelLinkOutputs {
+    std::vector<float> clsData;
+    std::vector<float> linkData;
+    TensorView<const float> cls;
+    TensorView<const float> link;
+
+    PixelLinkOutputs(const cv::Size& size, int textLinesNumber)
+        : clsData(2 * size.area()), linkData(2 * neighboursNumber * size.area()),
+          cls(denseView(clsData, {1, 2, static_cast<size_t>(size.height), static_cast<size_t>(size.width)},
+                        Layout::NCHW)),
+          link(denseView(linkData, {1, 2 * neighboursNumber, static_cast<size_t>(size.height),
+                                    static_cast<size_t>(size.width)}, Layout::NCHW)) {
+        cv::RNG rng(0);
+        cv::Mat textMask = cv::Mat::zeros(size, CV_8UC1);
+        for (int i = 0; i < textLinesNumber; i++) {
+            cv::Point2f center(rng.uniform(0.f, static_cast<float>(size.width)),
+                               rng.uniform(0.f, static_cast<float>(size.height)));
+            cv::Size2f lineSize(rng.uniform(size.width / 20.f, size.width / 4.f),
+                                rng.uniform(3.f, size.height / 20.f + 4.f));
+            cv::Point2f vertices[4];
+            cv::RotatedRect(center, lineSize, rng.uniform(-15.f, 15.f)).points(vertices);
+            std::vector<cv::Point> polygon(vertices, vertices + 4);
+            cv::fillConvexPoly(textMask, polygon, cv::Scalar(1));
+        }
+
+        // the second class is text (a link), its softmax probability is above the thresholds for text pixels only
+        const size_t plane = static_cast<size_t>(size.area());
+        for (int y = 0; y < size.height; y++) {
+            for (int x = 0; x < size.width; x++) {
+                const bool isText = textMask.at<uchar>(y, x) != 0;
+                const size_t pixel = static_cast<size_t>(y * size.width + x);
+                clsData[plane + pixel] = isText ? rng.uniform(2.f, 5.f) : rng.uniform(-5.f, -1.f);
+                for (int n = 0; n < neighboursNumber; n++) {
+                    linkData[(2 * n + 1) * plane + pixel] = isText ? rng.uniform(2.f, 5.f) : rng.uniform(-5.f, -1.f);
+                }
+            }
+        }
+    }
+
+    PixelLinkOutputs(const PixelLinkOutputs&) = delete;
+    PixelLinkOutputs& operator=(const PixelLinkOutputs&) = delete;
+};
+
+// Arguments: output map height (width is 5:3 as in text-detection-0003), number of text lines
+void BM_DecodeImageByJoin(benchmark::State& state) {
+    const int height = static_cast<int>(state.range(0));
+    PixelLinkOutputs outputs(cv::Size(height * 5 / 3, height), static_cast<int>(state.range(1)));
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        cv::Mat mask = decodeImageByJoin(outputs.cls, outputs.link, clsConfThreshold, linkConfThreshold);
+        benchmark::DoNotOptimize(mask.data);
+    }
+}
+BENCHMARK(BM_DecodeImageByJoin)->Args({96, 10})->Args({192, 10})->Args({192, 50})->Args({384, 50});
+
+void BM_MaskToBoxes(benchmark::State& state) {
+    const int height = static_cast<int>(state.range(0));
+    PixelLinkOutputs outputs(cv::Size(height * 5 / 3, height), static_cast<int>(state.range(1)));
+    cv::Mat mask = decodeImageByJoin(outputs.cls, outputs.link, clsConfThreshold, linkConfThreshold);
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        auto boxes = maskToBoxes(mask, 300.f, 10.f, cv::Size(1280, 768));
+        benchmark::DoNotOptimize(boxes.data());
+    }
+}
+BENCHMARK(BM_MaskToBoxes)->Args({96, 10})->Args({192, 10})->Args({192, 50})->Args({384, 50});
+
+// Argument: number of time steps of text-recognition-0012 output
+void BM_CTCGreedyDecoder(benchmark::State& state) {
+    const std::string alphabet = "0123456789abcdefghijklmnopqrstuvwxyz#";
+    const char padSymbol = '#';
+    cv::RNG rng(0);
+    const size_t steps = static_cast<size_t>(state.range(0));
+    std::vector<float> data(steps * alphabet.size());
+    for (auto& value : data) {
+        value = rng.uniform(-5.f, 5.f);
+    }
+    // the scores are indexed by time step, batch and class
+    const TensorView<const float> scores = denseView(data, {steps, 1, alphabet.size()}, Layout::CHW);
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        double conf = 0;
+        auto text = CTCGreedyDecoder(scores, alphabet, padSymbol, &conf);
+        benchmark::DoNotOptimize(text.data());
+    }
+}
+BENCHMARK(BM_CTCGreedyDecoder)->Arg(30)->Arg(120)->Arg(480);
+
+}  // namespace
@@ -0,0 +1,28 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core/core.hpp>
+
+#include "kuhn_munkres.hpp"
+#include "alloc_counter.hpp"
+
+namespace {
+
+// Arguments: number of tracks, number of detections
+void BM_KuhnMunkresSolve(benchmark::State& state) {
+    cv::Mat dissimilarity(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)), CV_32F);
+    cv::RNG rng(0);
+    rng.fill(dissimilarity, cv::RNG::UNIFORM, 0.0f, 1.0f);
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        auto assignment = KuhnMunkres().Solve(dissimilarity);
+        benchmark::DoNotOptimize(assignment.data());
+    }
+}
+BENCHMARK(BM_KuhnMunkresSolve)->Args({10, 10})->Args({50, 50})->Args({50, 100})->Args({200, 200});
+
+}  // namespace
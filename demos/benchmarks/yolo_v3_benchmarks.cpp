@@ -0,0 +1,78 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <inference_engine.hpp>
+#include <opencv2/core/core.hpp>
+
+#include "yolo_v3_output.hpp"
+#include "alloc_counter.hpp"
+
+namespace {
+
+const int coords = 4;
+const int classes = 80;
+const int anchorsPerScale = 3;
+
+/**
+ * @brief RegionYolo layers and output blobs of YOLO v3 for a square input of the given size
+ * with the given number of confident objects in every output.
+ * Other cells have objectness and class probabilities below the detection threshold.
+ */
+struct YoloOutputs {
+    std::vector<CNNLayerPtr> layers;
+    std::vector<Blob::Ptr> blobs;
+
+    YoloOutputs(int inputSize, int objectsNumber) {
+        cv::RNG rng(0);
+        const std::vector<std::string> masks = {"6,7,8", "3,4,5", "0,1,2"};
+        for (size_t scale = 0; scale < masks.size(); scale++) {
+            CNNLayerPtr layer = std::make_shared<CNNLayer>(
+                LayerParams{"RegionYolo" + std::to_string(scale), "RegionYolo", Precision::FP32});
+            layer->params["num"] = "9";
+            layer->params["coords"] = std::to_string(coords);
+            layer->params["classes"] = std::to_string(classes);
+            layer->params["mask"] = masks[scale];
+            layers.push_back(layer);
+
+            const size_t side = static_cast<size_t>(inputSize / (32 >> scale));
+            Blob::Ptr blob = make_shared_blob<float>(TensorDesc(Precision::FP32,
+                {1, static_cast<size_t>(anchorsPerScale * (coords + 1 + classes)), side, side}, Layout::NCHW));
+            blob->allocate();
+            cv::Mat data(1, static_cast<int>(blob->size()), CV_32FC1, blob->buffer().as<float*>());
+            rng.fill(data, cv::RNG::UNIFORM, 0.0f, 0.3f);
+
+            const int sideSquare = static_cast<int>(side * side);
+            for (int i = 0; i < objectsNumber; i++) {
+                int n = rng.uniform(0, anchorsPerScale);
+                int location = n * sideSquare + rng.uniform(0, sideSquare);
+                data.at<float>(EntryIndex(static_cast<int>(side), coords, classes, location, coords)) = 0.95f;
+                int classId = rng.uniform(0, classes);
+                data.at<float>(EntryIndex(static_cast<int>(side), coords, classes, location, coords + 1 + classId)) = 0.9f;
+            }
+            blobs.push_back(blob);
+        }
+    }
+};
+
+// Arguments: network input size, number of objects per output
+void BM_ParseYOLOV3Output(benchmark::State& state) {
+    const unsigned long inputSize = static_cast<unsigned long>(state.range(0));
+    YoloOutputs outputs(static_cast<int>(inputSize), static_cast<int>(state.range(1)));
+    std::vector<DetectionObject> objects;
+    AllocationsReporter allocs(state);
+    for (auto _ : state) {
+        objects.clear();
+        for (size_t i = 0; i < outputs.layers.size(); i++) {
+            ParseYOLOV3Output(outputs.layers[i], outputs.blobs[i], inputSize, inputSize, 1080, 1920, 0.5, objects);
+        }
+        benchmark::DoNotOptimize(objects.data());
+    }
+}
+BENCHMARK(BM_ParseYOLOV3Output)->Args({320, 10})->Args({416, 10})->Args({608, 10})->Args({608, 100});
+
+}  // namespace
@@ -0,0 +1,244 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <IdxDataset.h>
+
+using namespace FormatReader;
+
+namespace {
+/**
+ * \class MappedIdxFile
+ * \brief Read-only memory mapping of an IDX file of unsigned bytes with its parsed header
+ */
+class MappedIdxFile {
+public:
+    MappedIdxFile() = default;
+    MappedIdxFile(const MappedIdxFile&) = delete;
+    MappedIdxFile& operator=(const MappedIdxFile&) = delete;
+
+    ~MappedIdxFile() {
+        unmap();
+    }
+
+    bool open(const std::string &filename) {
+        if (!map(filename)) {
+            std::cout << "[IDX] Cannot map " << filename << std::endl;
+            return false;
+        }
+        // Magic number: two zero bytes, the type of the elements and the number of dimensions
+        const unsigned char ubyteType = 0x08;
+        if (_size < 4 || _mapping[0] != 0 || _mapping[1] != 0) {
+            std::cout << "[IDX] " << filename << " is not an IDX file" << std::endl;
+            return false;
+        }
+        if (_mapping[2] != ubyteType) {
+            std::cout << "[IDX] " << filename << " has elements of type " << static_cast<int>(_mapping[2])
+                      << ", only unsigned bytes are supported" << std::endl;
+            return false;
+        }
+        size_t nDims = _mapping[3];
+        size_t headerSize = 4 + 4 * nDims;
+        if (0 == nDims || _size < headerSize) {
+            std::cout << "[IDX] " << filename << " has a broken header" << std::endl;
+            return false;
+        }
+        _dims.resize(nDims);
+        size_t dataSize = 1;
+        for (size_t i = 0; i < nDims; i++) {
+            const unsigned char *dim = _mapping + 4 + 4 * i;
+            // The dimensions are stored in big-endian order
+            _dims[i] = (static_cast<size_t>(dim[0]) << 24) | (static_cast<size_t>(dim[1]) << 16)
+                       | (static_cast<size_t>(dim[2]) << 8) | static_cast<size_t>(dim[3]);
+            dataSize *= _dims[i];
+        }
+        if (_size - headerSize < dataSize) {
+            std::cout << "[IDX] " << filename << " is truncated" << std::endl;
+            return false;
+        }
+        _data = _mapping + headerSize;
+        return true;
+    }
+
+    const std::vector<size_t>& dims() const { return _dims; }
+    const unsigned char *data() const { return _data; }
+
+private:
+#ifdef _WIN32
+    bool map(const std::string &filename) {
+        _file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (INVALID_HANDLE_VALUE == _file) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size) || 0 == size.QuadPart) {
+            return false;
+        }
+        _size = static_cast<size_t>(size.QuadPart);
+        _fileMapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (nullptr == _fileMapping) {
+            return false;
+        }
+        _mapping = static_cast<const unsigned char *>(MapViewOfFile(_fileMapping, FILE_MAP_READ, 0, 0, 0));
+        return nullptr != _mapping;
+    }
+
+    void unmap() {
+        if (nullptr != _mapping) UnmapViewOfFile(_mapping);
+        if (nullptr != _fileMapping) CloseHandle(_fileMapping);
+        if (INVALID_HANDLE_VALUE != _file) CloseHandle(_file);
+    }
+
+    HANDLE _file = INVALID_HANDLE_VALUE;
+    HANDLE _fileMapping = nullptr;
+#else
+    bool map(const std::string &filename) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0 || 0 == status.st_size) {
+            close(fd);
+            return false;
+        }
+        _size = static_cast<size_t>(status.st_size);
+        void *mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps the file referenced
+        close(fd);
+        if (MAP_FAILED == mapping) {
+            return false;
+        }
+        // The records are mostly read in order, so let the kernel read ahead
+        madvise(mapping, _size, MADV_SEQUENTIAL);
+        _mapping = static_cast<const unsigned char *>(mapping);
+        return true;
+    }
+
+    void unmap() {
+        if (nullptr != _mapping) munmap(const_cast<unsigned char *>(_mapping), _size);
+    }
+#endif
+
+    const unsigned char *_mapping = nullptr;
+    size_t _size = 0;
+    const unsigned char *_data = nullptr;
+    std::vector<size_t> _dims;
+};
+
+/**
+ * \class MappedIdxDataset
+ * \brief IdxDataset reading the records and labels in place from memory-mapped files
+ */
+class MappedIdxDataset : public IdxDataset {
+public:
+    bool open(const char *recordsFile, const char *labelsFile) {
+        if (nullptr == recordsFile || !_records.open(recordsFile)) {
+            return false;
+        }
+        _recordDims.assign(_records.dims().begin() + 1, _records.dims().end());
+        _recordSize = 1;
+        for (size_t dim : _recordDims) {
+            _recordSize *= dim;
+        }
+        if (nullptr != labelsFile) {
+            _labels.reset(new MappedIdxFile);
+            if (!_labels->open(labelsFile)) {
+                return false;
+            }
+            if (_labels->dims().size() != 1 || _labels->dims()[0] != count()) {
+                std::cout << "[IDX] " << labelsFile << " does not contain a label for each record of "
+                          << recordsFile << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t count() const override {
+        return _records.dims()[0];
+    }
+
+    const std::vector<size_t>& recordDims() const override {
+        return _recordDims;
+    }
+
+    size_t recordSize() const override {
+        return _recordSize;
+    }
+
+    const unsigned char* record(size_t index) const override {
+        return index < count() ? _records.data() + index * _recordSize : nullptr;
+    }
+
+    bool hasLabels() const override {
+        return nullptr != _labels;
+    }
+
+    int label(size_t index) const override {
+        return hasLabels() && index < count() ? static_cast<int>(_labels->data()[index]) : -1;
+    }
+
+    size_t fillBatch(size_t first, size_t batchSize, unsigned char* dst) const override {
+        size_t filled = batchRecords(first, batchSize);
+        if (0 == filled) {
+            return 0;
+        }
+        // The records of a batch are contiguous in the file
+        std::memcpy(dst, record(first), filled * _recordSize);
+        return filled;
+    }
+
+    size_t fillBatch(size_t first, size_t batchSize, float* dst) const override {
+        size_t filled = batchRecords(first, batchSize);
+        if (0 == filled) {
+            return 0;
+        }
+        const unsigned char *src = record(first);
+        std::copy(src, src + filled * _recordSize, dst);
+        return filled;
+    }
+
+    void Release() noexcept override {
+        delete this;
+    }
+
+private:
+    size_t batchRecords(size_t first, size_t batchSize) const {
+        return first < count() ? std::min(batchSize, count() - first) : 0;
+    }
+
+    MappedIdxFile _records;
+    std::unique_ptr<MappedIdxFile> _labels;
+    std::vector<size_t> _recordDims;
+    size_t _recordSize = 0;
+};
+}  // namespace
+
+FORMAT_READER_API(IdxDataset*) CreateIdxDataset(const char *recordsFile, const char *labelsFile) {
+    MappedIdxDataset *dataset = new MappedIdxDataset;
+    if (!dataset->open(recordsFile, labelsFile)) {
+        dataset->Release();
+        return nullptr;
+    }
+    return dataset;
+}
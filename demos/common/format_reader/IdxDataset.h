@@ -0,0 +1,141 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * \brief IDX (MNIST ubyte) dataset reader
+ * \file IdxDataset.h
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <format_reader.h>
+
+namespace FormatReader {
+/**
+ * \class IdxDataset
+ * \brief Random and batched access to all records of an IDX file of unsigned bytes, for example
+ * MNIST images, with the labels of an optional IDX labels file. The files are memory-mapped,
+ * so the records are read in place without decoding.
+ */
+class IdxDataset {
+public:
+    /**
+     * \brief Get number of records
+     * @return number of records
+     */
+    virtual size_t count() const = 0;
+
+    /**
+     * \brief Get dimensions of a record, for example height and width of an image
+     * @return record dimensions
+     */
+    virtual const std::vector<size_t>& recordDims() const = 0;
+
+    /**
+     * \brief Get size of a record
+     * @return number of bytes of a record
+     */
+    virtual size_t recordSize() const = 0;
+
+    /**
+     * \brief Get record data
+     * @param index - record index
+     * @return pointer to the mapped record, valid while the dataset is alive
+     */
+    virtual const unsigned char* record(size_t index) const = 0;
+
+    /**
+     * \brief Indicates whether the labels file is given
+     */
+    virtual bool hasLabels() const = 0;
+
+    /**
+     * \brief Get record label
+     * @param index - record index
+     * @return label or -1 if there are no labels
+     */
+    virtual int label(size_t index) const = 0;
+
+    /**
+     * \brief Copies consecutive records to a batch buffer, e.g. of an input blob of N x 1 x H x W
+     * @param first - index of the first record
+     * @param batchSize - maximal number of records to copy
+     * @param dst - buffer for batchSize records
+     * @return number of copied records, less than batchSize at the end of the dataset
+     */
+    virtual size_t fillBatch(size_t first, size_t batchSize, unsigned char* dst) const = 0;
+
+    /**
+     * \brief Converts consecutive records to floats in a batch buffer, e.g. of an input blob of N x 1 x H x W
+     * @param first - index of the first record
+     * @param batchSize - maximal number of records to convert
+     * @param dst - buffer for batchSize records
+     * @return number of converted records, less than batchSize at the end of the dataset
+     */
+    virtual size_t fillBatch(size_t first, size_t batchSize, float* dst) const = 0;
+
+    virtual void Release() noexcept = 0;
+
+protected:
+    virtual ~IdxDataset() {}
+};
+
+/**
+ * \class IdxDatasetPtr
+ * \brief Owns an IDX dataset, the pointer is empty if the files cannot be read
+ */
+class IdxDatasetPtr {
+public:
+    /**
+     * \brief Opens a dataset
+     * @param recordsFile - path to IDX file of the records
+     * @param labelsFile - path to IDX file of the labels or nullptr
+     */
+    explicit IdxDatasetPtr(const char *recordsFile, const char *labelsFile = nullptr);
+
+    IdxDataset *operator->() const noexcept {
+        return dataset.get();
+    }
+
+    IdxDataset *get() const noexcept {
+        return dataset.get();
+    }
+
+    explicit operator bool() const noexcept {
+        return nullptr != dataset;
+    }
+
+    /**
+     * \brief Iterates over the dataset in batches
+     * @param batchSize - number of records in a batch
+     * @param onBatch - callback with the index of the first record and the number of records of a batch
+     */
+    void forEachBatch(size_t batchSize, const std::function<void(size_t first, size_t size)>& onBatch) const {
+        for (size_t first = 0; first < dataset->count(); first += batchSize) {
+            onBatch(first, std::min(batchSize, dataset->count() - first));
+        }
+    }
+
+protected:
+    std::unique_ptr<IdxDataset, std::function<void(IdxDataset *)>> dataset;
+};
+}  // namespace FormatReader
+
+/**
+ * \brief Function for opening an IDX dataset
+ * @param recordsFile - path to IDX file of the records
+ * @param labelsFile - path to IDX file of the labels or nullptr
+ * @return IdxDataset pointer or nullptr if the files cannot be read
+ */
+FORMAT_READER_API(FormatReader::IdxDataset*) CreateIdxDataset(const char *recordsFile, const char *labelsFile);
+
+inline FormatReader::IdxDatasetPtr::IdxDatasetPtr(const char *recordsFile, const char *labelsFile) :
+    dataset(CreateIdxDataset(recordsFile, labelsFile), [](IdxDataset *p) {
+        if (p != nullptr) p->Release();
+    }) {}
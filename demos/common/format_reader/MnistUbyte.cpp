@@ -42,21 +42,14 @@ MnistUbyte::MnistUbyte(const std::string &filename) {
     _width = (size_t) n_cols;
     if (number_of_images > 1) {
         std::cout << "[MNIST] Warning: number_of_images  in mnist file equals " << number_of_images
-                  << ". Only a first image will be read." << std::endl;
+                  << ". Only a first image will be read, use IdxDataset to read all of them." << std::endl;
     }
 
     size_t size = _width * _height * 1;
 
     _data.reset(new unsigned char[size], std::default_delete<unsigned char[]>());
-    size_t count = 0;
     if (0 < number_of_images) {
-        for (int r = 0; r < n_rows; ++r) {
-            for (int c = 0; c < n_cols; ++c) {
-                unsigned char temp = 0;
-                file.read(reinterpret_cast<char *>(&temp), sizeof(temp));
-                _data.get()[count++] = temp;
-            }
-        }
+        file.read(reinterpret_cast<char *>(_data.get()), size);
     }
 
     file.close();
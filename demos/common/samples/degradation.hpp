@@ -0,0 +1,199 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with a controller trading processing quality for throughput of an overloaded pipeline
+ * @file degradation.hpp
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <samples/slog.hpp>
+
+/**
+ * @class DegradationController
+ * @brief Steps through degradation levels while a pipeline is overloaded and restores the quality when the load drops.
+ * Level 0 is the full quality, every next level degrades the processing further. The load is evaluated once per period:
+ * the frame latency is the sum of the mean latencies of the pipeline stages and the queue depth is the mean of the sampled
+ * depths. The pipeline is overloaded if any of them exceeds its limit. The level is restored one step back only after
+ * the load has stayed below a share of the limits for several periods, and the period after a level change is not
+ * evaluated, so the frames processed at the previous level do not cause another change.
+ */
+class DegradationController {
+public:
+    struct Params {
+        /// Frame latency above which the pipeline is overloaded
+        std::chrono::milliseconds latencyBudget{200};
+        /// Mean queue depth above which the pipeline is overloaded, 0 ignores the queue depth
+        double maxQueueDepth = 0;
+        /// Interval the load is averaged over
+        std::chrono::milliseconds period{1000};
+        /// Share of the limits the load has to drop below to restore the quality
+        double recoveryRatio = 0.7;
+        /// Number of consecutive periods the load has to stay low to restore the quality
+        unsigned recoveryPeriods = 3;
+    };
+
+    /**
+     * @param levelNames names of the levels for logging, the first one is the full quality
+     */
+    DegradationController(const std::vector<std::string>& levelNames, const Params& params) :
+        levelNames(levelNames), params(params), currentLevel(0), levelChanges(0),
+        queueDepthSum(0), queueDepthSamples(0), lowLoadPeriods(0), settling(false) {
+        if (levelNames.empty()) {
+            throw std::logic_error("Degradation controller requires at least the full quality level");
+        }
+        if (params.recoveryRatio <= 0 || params.recoveryRatio >= 1) {
+            throw std::logic_error("Degradation recovery ratio must be between 0 and 1");
+        }
+    }
+
+    DegradationController(const DegradationController&) = delete;
+    DegradationController& operator=(const DegradationController&) = delete;
+
+    /** @brief Accounts the time a frame has spent in a stage */
+    void addLatency(const std::string& stage, std::chrono::steady_clock::duration latency) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = stages.begin();
+        while (it != stages.end() && it->first != stage) {
+            ++it;
+        }
+        if (stages.end() == it) {
+            it = stages.emplace(stages.end(), stage, StageLatency());
+        }
+        it->second.sum += latency;
+        it->second.count++;
+    }
+
+    /** @brief Accounts a sample of the number of frames waiting in the queue */
+    void addQueueDepth(std::size_t depth) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queueDepthSum += depth;
+        queueDepthSamples++;
+    }
+
+    /**
+     * @brief Evaluates the load if the period has passed and changes the level
+     * @return current level
+     */
+    std::size_t update(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (std::chrono::steady_clock::time_point() == periodStart) {
+            periodStart = now;
+        }
+        if (now - periodStart < params.period) {
+            return currentLevel;
+        }
+
+        bool hasFrames = false;
+        double latencyMs = 0;
+        for (const auto& stage : stages) {
+            if (0 != stage.second.count) {
+                hasFrames = true;
+                latencyMs += std::chrono::duration_cast<Ms>(stage.second.sum).count() / stage.second.count;
+            }
+        }
+        const double queueDepth = 0 == queueDepthSamples ? 0. : static_cast<double>(queueDepthSum) / queueDepthSamples;
+        const double budgetMs = static_cast<double>(params.latencyBudget.count());
+
+        // without completed frames, e.g. on pause, there is nothing to evaluate
+        if (hasFrames && !settling) {
+            const bool overloaded = latencyMs > budgetMs || (params.maxQueueDepth > 0 && queueDepth > params.maxQueueDepth);
+            const bool lowLoad = latencyMs < params.recoveryRatio * budgetMs
+                && (params.maxQueueDepth <= 0 || queueDepth < params.recoveryRatio * params.maxQueueDepth);
+            if (overloaded) {
+                lowLoadPeriods = 0;
+                if (currentLevel + 1 < levelNames.size()) {
+                    changeLevel(currentLevel + 1, latencyMs, queueDepth);
+                }
+            } else if (lowLoad && currentLevel > 0) {
+                if (++lowLoadPeriods >= params.recoveryPeriods) {
+                    lowLoadPeriods = 0;
+                    changeLevel(currentLevel - 1, latencyMs, queueDepth);
+                }
+            } else {
+                lowLoadPeriods = 0;
+            }
+        } else if (hasFrames) {
+            settling = false;
+        }
+
+        for (auto& stage : stages) {
+            stage.second = StageLatency();
+        }
+        queueDepthSum = 0;
+        queueDepthSamples = 0;
+        periodStart = now;
+        return currentLevel;
+    }
+
+    std::size_t level() const {
+        return currentLevel;
+    }
+
+    std::size_t levelCount() const {
+        return levelNames.size();
+    }
+
+    const std::string& levelName(std::size_t level) const {
+        return levelNames.at(level);
+    }
+
+    /** @brief Number of level changes since the start */
+    std::size_t changes() const {
+        return levelChanges;
+    }
+
+private:
+    typedef std::chrono::duration<double, std::ratio<1, 1000>> Ms;
+
+    struct StageLatency {
+        std::chrono::steady_clock::duration sum = std::chrono::steady_clock::duration::zero();
+        std::size_t count = 0;
+    };
+
+    void changeLevel(std::size_t level, double latencyMs, double queueDepth) {
+        // the numbers are formatted locally, the manipulators would stick to the shared log stream
+        std::ostringstream stageLatencies;
+        stageLatencies << std::fixed << std::setprecision(1);
+        for (const auto& stage : stages) {
+            if (0 != stage.second.count) {
+                stageLatencies << (stageLatencies.tellp() > 0 ? ", " : "") << stage.first << " "
+                               << std::chrono::duration_cast<Ms>(stage.second.sum).count() / stage.second.count << " ms";
+            }
+        }
+        std::ostringstream load;
+        load << std::fixed << std::setprecision(1) << "frame latency " << latencyMs << " ms ("
+             << stageLatencies.str() << "), queue depth " << queueDepth;
+        slog::info << "Degradation level " << currentLevel << " (" << levelNames[currentLevel] << ") -> "
+                   << level << " (" << levelNames[level] << "): " << load.str() << slog::endl;
+        currentLevel = level;
+        levelChanges++;
+        settling = true;
+    }
+
+    const std::vector<std::string> levelNames;
+    const Params params;
+    std::atomic<std::size_t> currentLevel;
+    std::atomic<std::size_t> levelChanges;
+
+    std::mutex mutex;
+    std::vector<std::pair<std::string, StageLatency>> stages;
+    std::size_t queueDepthSum;
+    std::size_t queueDepthSamples;
+    std::chrono::steady_clock::time_point periodStart;
+    unsigned lowLoadPeriods;
+    bool settling;
+};
@@ -0,0 +1,390 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with allocators placing large frames and tensors on NUMA-local huge pages
+ * The -huge_pages option is provided by object_detection_demo_ssd_async, object_detection_demo_faster_rcnn,
+ * security_barrier_camera_demo and the multichannel demos, the other demos keep the default allocators.
+ * @file huge_pages.hpp
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+#include <opencv2/core/core.hpp>
+
+#include <samples/slog.hpp>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class HugePageArena
+ * @brief Allocates large buffers in 2 MB pages, either transparent huge pages (madvise) or explicit ones
+ * (MAP_HUGETLB, falls back to transparent if none are reserved). A buffer is bound to the NUMA node of
+ * the allocating thread and is recycled for the allocations made on the same node.
+ * Huge pages are supported on Linux only, elsewhere the arena does not allocate and callers use the heap.
+ */
+class HugePageArena {
+public:
+    enum Mode {
+        DISABLED,
+        TRANSPARENT,
+        EXPLICIT
+    };
+
+    static const size_t hugePageSize = 2 << 20;
+
+    /// @brief The arena is never destroyed, as frames and blobs allocated from it may outlive main
+    static HugePageArena& instance() {
+        static HugePageArena* arena = new HugePageArena();
+        return *arena;
+    }
+
+    static Mode modeFromString(const std::string& mode) {
+        if (mode.empty() || mode == "none") return DISABLED;
+        if (mode == "thp") return TRANSPARENT;
+        if (mode == "explicit") return EXPLICIT;
+        throw std::logic_error("Unknown huge pages mode \"" + mode + "\", expected thp or explicit");
+    }
+
+    void setMode(Mode newMode) {
+        std::lock_guard<std::mutex> lock(mutex);
+        mode = newMode;
+    }
+
+    Mode getMode() const {
+        return mode;
+    }
+
+    /**
+     * @brief Returns a buffer of at least size bytes aligned to a huge page
+     * or nullptr if the arena is disabled, the size is below the threshold or the mapping fails
+     */
+    void* allocate(size_t size) {
+        if (DISABLED == mode || size < minAllocationSize) {
+            return nullptr;
+        }
+#ifdef __linux__
+        const size_t mappedSize = (size + hugePageSize - 1) / hugePageSize * hugePageSize;
+        const int node = currentNode();
+        std::lock_guard<std::mutex> lock(mutex);
+        ++allocations;
+        auto& freeBlocks = cache[{node, mappedSize}];
+        if (!freeBlocks.empty()) {
+            void* ptr = freeBlocks.back();
+            freeBlocks.pop_back();
+            cachedBytes -= mappedSize;
+            ++recycled;
+            used[ptr] = {node, mappedSize};
+            return ptr;
+        }
+
+        void* ptr = MAP_FAILED;
+        bool explicitPages = false;
+        if (EXPLICIT == mode) {
+            ptr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            explicitPages = ptr != MAP_FAILED;
+            if (!explicitPages) {
+                ++explicitFailures;
+            }
+        }
+        if (MAP_FAILED == ptr) {
+            // Over-allocate to align the buffer to a huge page, otherwise THP can not back its edges
+            void* raw = mmap(nullptr, mappedSize + hugePageSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (MAP_FAILED == raw) {
+                --allocations;
+                return nullptr;
+            }
+            uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (begin + hugePageSize - 1) / hugePageSize * hugePageSize;
+            if (aligned > begin) {
+                munmap(raw, aligned - begin);
+            }
+            munmap(reinterpret_cast<void*>(aligned + mappedSize), begin + hugePageSize - aligned);
+            ptr = reinterpret_cast<void*>(aligned);
+            madvise(ptr, mappedSize, MADV_HUGEPAGE);
+        }
+        bindToNode(ptr, mappedSize, node);
+        mappedBytes += mappedSize;
+        if (explicitPages) {
+            explicitBytes += mappedSize;
+        }
+        used[ptr] = {node, mappedSize};
+        return ptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    /**
+     * @brief Returns a buffer to the cache of its node, the buffers above the cache limit are unmapped
+     * @return false if the buffer was not allocated by the arena
+     */
+    bool deallocate(void* ptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = used.find(ptr);
+        if (it == used.end()) {
+            return false;
+        }
+        const std::pair<int, size_t> key = it->second;
+        used.erase(it);
+        if (cachedBytes + key.second <= maxCachedBytes) {
+            cache[key].push_back(ptr);
+            cachedBytes += key.second;
+        } else {
+#ifdef __linux__
+            munmap(ptr, key.second);
+#endif
+            mappedBytes -= key.second;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Formats the allocation counters, the resident huge pages of the process and
+     * the page fault rate since the previous report
+     */
+    std::string report() {
+        std::ostringstream report;
+        std::lock_guard<std::mutex> lock(mutex);
+        report << "huge page buffers: " << allocations << " allocated, " << recycled << " recycled, "
+               << (mappedBytes >> 20) << " MB mapped";
+        if (EXPLICIT == mode) {
+            report << " (" << (explicitBytes >> 20) << " MB explicit, " << explicitFailures << " fallbacks to THP)";
+        }
+#ifdef __linux__
+        std::ifstream smaps("/proc/self/smaps_rollup");
+        std::string line;
+        while (std::getline(smaps, line)) {
+            if (0 == line.compare(0, 14, "AnonHugePages:")) {
+                std::istringstream value(line.substr(14));
+                size_t kilobytes = 0;
+                value >> kilobytes;
+                report << ", " << (kilobytes >> 10) << " MB resident in THP";
+            }
+        }
+        rusage usage;
+        if (0 == getrusage(RUSAGE_SELF, &usage)) {
+            auto now = std::chrono::steady_clock::now();
+            double seconds = std::chrono::duration<double>(now - lastReportTime).count();
+            if (seconds > 0.) {
+                report << ", page faults: " << static_cast<long>((usage.ru_minflt - lastMinorFaults) / seconds)
+                       << " minor/s, " << static_cast<long>((usage.ru_majflt - lastMajorFaults) / seconds) << " major/s";
+            }
+            lastMinorFaults = usage.ru_minflt;
+            lastMajorFaults = usage.ru_majflt;
+            lastReportTime = now;
+        }
+#endif
+        return report.str();
+    }
+
+private:
+    HugePageArena() : mode(DISABLED), allocations(0), recycled(0), mappedBytes(0), explicitBytes(0),
+        explicitFailures(0), cachedBytes(0), lastMinorFaults(0), lastMajorFaults(0),
+        lastReportTime(std::chrono::steady_clock::now()) {}
+
+    static const size_t minAllocationSize = 1 << 20;
+    static const size_t maxCachedBytes = size_t(512) << 20;
+
+#ifdef __linux__
+    static int currentNode() {
+        unsigned cpu = 0, node = 0;
+        if (0 != syscall(SYS_getcpu, &cpu, &node, nullptr)) {
+            return 0;
+        }
+        return static_cast<int>(node);
+    }
+
+    static void bindToNode(void* ptr, size_t size, int node) {
+        // MPOL_PREFERRED without libnuma, the pages fall back to other nodes if the node is exhausted
+        const int preferredPolicy = 1;
+        if (node >= 64) {
+            return;
+        }
+        unsigned long nodeMask = 1ul << node;
+        syscall(SYS_mbind, ptr, size, preferredPolicy, &nodeMask, static_cast<unsigned long>(node + 2), 0u);
+    }
+#endif
+
+    Mode mode;
+    std::mutex mutex;
+    /// @brief (node, size) of the buffers in use
+    std::map<void*, std::pair<int, size_t>> used;
+    /// @brief free buffers by (node, size)
+    std::map<std::pair<int, size_t>, std::vector<void*>> cache;
+    size_t allocations;
+    size_t recycled;
+    size_t mappedBytes;
+    size_t explicitBytes;
+    size_t explicitFailures;
+    size_t cachedBytes;
+    long lastMinorFaults;
+    long lastMajorFaults;
+    std::chrono::steady_clock::time_point lastReportTime;
+};
+
+/**
+ * @class HugePageMatAllocator
+ * @brief cv::MatAllocator taking large matrices from HugePageArena and the rest from the OpenCV heap
+ */
+class HugePageMatAllocator : public cv::MatAllocator {
+public:
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 2)
+    using AccessFlags = cv::AccessFlag;
+#else
+    using AccessFlags = int;
+#endif
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data0, size_t* step,
+                           AccessFlags /*flags*/, cv::UMatUsageFlags /*usageFlags*/) const override {
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims - 1; i >= 0; i--) {
+            if (step) {
+                if (data0 && step[i] != CV_AUTOSTEP) {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                } else {
+                    step[i] = total;
+                }
+            }
+            total *= sizes[i];
+        }
+        uchar* data = static_cast<uchar*>(data0);
+        if (!data) {
+            data = static_cast<uchar*>(HugePageArena::instance().allocate(total));
+        }
+        if (!data) {
+            data = static_cast<uchar*>(cv::fastMalloc(total));
+        }
+        cv::UMatData* u = new cv::UMatData(this);
+        u->data = u->origdata = data;
+        u->size = total;
+        if (data0) {
+            u->flags |= cv::UMatData::USER_ALLOCATED;
+        }
+        return u;
+    }
+
+    bool allocate(cv::UMatData* u, AccessFlags /*accessFlags*/, cv::UMatUsageFlags /*usageFlags*/) const override {
+        return u != nullptr;
+    }
+
+    void deallocate(cv::UMatData* u) const override {
+        if (!u) {
+            return;
+        }
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+            if (!HugePageArena::instance().deallocate(u->origdata)) {
+                cv::fastFree(u->origdata);
+            }
+            u->origdata = 0;
+        }
+        delete u;
+    }
+};
+
+/**
+ * @class HugePageBlobAllocator
+ * @brief Inference Engine blob allocator taking large tensors from HugePageArena and the rest from the heap
+ */
+class HugePageBlobAllocator : public InferenceEngine::IAllocator {
+public:
+    void* lock(void* handle, InferenceEngine::LockOp = InferenceEngine::LOCK_FOR_WRITE) noexcept override {
+        return handle;
+    }
+
+    void unlock(void*) noexcept override {}
+
+    void* alloc(size_t size) noexcept override {
+        void* ptr = HugePageArena::instance().allocate(size);
+        return ptr ? ptr : cv::fastMalloc(size);
+    }
+
+    bool free(void* handle) noexcept override {
+        if (!HugePageArena::instance().deallocate(handle)) {
+            cv::fastFree(handle);
+        }
+        return true;
+    }
+
+    void Release() noexcept override {
+        delete this;
+    }
+};
+
+/**
+ * @brief Switches the default cv::Mat allocator of the process to huge pages in the given mode
+ * ("thp" or "explicit", empty keeps the default allocator)
+ */
+inline void enableHugePages(const std::string& mode) {
+    HugePageArena::Mode arenaMode = HugePageArena::modeFromString(mode);
+    if (HugePageArena::DISABLED == arenaMode) {
+        return;
+    }
+#ifndef __linux__
+    slog::warn << "Huge pages are supported on Linux only, the default allocator is used" << slog::endl;
+#endif
+    HugePageArena::instance().setMode(arenaMode);
+    static HugePageMatAllocator* matAllocator = new HugePageMatAllocator();
+    cv::Mat::setDefaultAllocator(matAllocator);
+}
+
+/**
+ * @brief Returns the blob allocator if huge pages are enabled, otherwise nullptr for the default one
+ */
+inline std::shared_ptr<InferenceEngine::IAllocator> hugePageBlobAllocator() {
+    if (HugePageArena::DISABLED == HugePageArena::instance().getMode()) {
+        return nullptr;
+    }
+    return std::make_shared<HugePageBlobAllocator>();
+}
+
+/**
+ * @brief Replaces the input blobs of an infer request with blobs of the same shape allocated on huge pages.
+ * Does nothing if huge pages are disabled.
+ */
+inline void allocateInputsOnHugePages(InferenceEngine::InferRequest& request,
+                                      const InferenceEngine::ConstInputsDataMap& inputs) {
+    std::shared_ptr<InferenceEngine::IAllocator> allocator = hugePageBlobAllocator();
+    if (!allocator) {
+        return;
+    }
+    for (const auto& input : inputs) {
+        InferenceEngine::TensorDesc desc = request.GetBlob(input.first)->getTensorDesc();
+        InferenceEngine::Blob::Ptr blob;
+        switch (desc.getPrecision()) {
+        case InferenceEngine::Precision::U8:
+            blob = InferenceEngine::make_shared_blob<uint8_t>(desc, allocator);
+            break;
+        case InferenceEngine::Precision::FP32:
+            blob = InferenceEngine::make_shared_blob<float>(desc, allocator);
+            break;
+        default:
+            continue;
+        }
+        blob->allocate();
+        request.SetBlob(input.first, blob);
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with helpers reporting the resident memory taken by loaded models
+ * @file memory_usage.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <samples/slog.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#endif
+
+/**
+ * @brief Returns the resident memory of the process in bytes or 0 if it is not available
+ */
+inline size_t residentMemory() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+#else
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0, resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/**
+ * @brief Returns the memory freed by the process to the system. The allocator keeps freed blocks
+ * for reuse, so the parsed IR released after loading a network does not leave the process otherwise.
+ */
+inline void trimFreedMemory() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
+/**
+ * @class ModelMemoryReport
+ * @brief Reports the growth of the resident memory during the object lifetime as the memory taken by a model.
+ * The object is meant to outlive the network reader, so that the parsed network is released
+ * and trimmed before the measurement.
+ */
+class ModelMemoryReport {
+public:
+    explicit ModelMemoryReport(const std::string& modelPath) : modelPath(modelPath), initial(residentMemory()) {}
+
+    ModelMemoryReport(const ModelMemoryReport&) = delete;
+    ModelMemoryReport& operator=(const ModelMemoryReport&) = delete;
+
+    ~ModelMemoryReport() {
+        trimFreedMemory();
+        size_t current = residentMemory();
+        if (0 == current) {
+            return;
+        }
+        slog::info << "Model " << modelPath << " takes " << toMegabytes(current > initial ? current - initial : 0)
+                   << " MB of resident memory, " << toMegabytes(current) << " MB in total" << slog::endl;
+    }
+
+private:
+    static size_t toMegabytes(size_t bytes) {
+        return (bytes + (1 << 19)) >> 20;
+    }
+
+    const std::string modelPath;
+    const size_t initial;
+};
@@ -44,6 +44,108 @@ void matU8ToBlob(const cv::Mat& orig_image, InferenceEngine::Blob::Ptr& blob, in
     }
 }
 
+/**
+ * @brief Returns the affine map from pixel coordinates of an image of dst size to pixel coordinates
+ * of an image of src size stretched to it, the same mapping as cv::resize uses.
+ * @param src - size of the sampled image.
+ * @param dst - size of the resulting image.
+ * @return 2x3 affine map.
+ */
+inline cv::Matx23d resizeAffine(const cv::Size& src, const cv::Size& dst) {
+    double sx = static_cast<double>(src.width) / dst.width;
+    double sy = static_cast<double>(src.height) / dst.height;
+    return cv::Matx23d(sx, 0., 0.5 * sx - 0.5,
+                       0., sy, 0.5 * sy - 0.5);
+}
+
+/**
+ * @brief Composes two affine maps.
+ * @param first - map applied first.
+ * @param second - map applied to the result of the first one.
+ * @return 2x3 affine map equal to applying first and then second.
+ */
+inline cv::Matx23d composeAffine(const cv::Matx23d& first, const cv::Matx23d& second) {
+    cv::Matx33d a(first(0, 0), first(0, 1), first(0, 2),
+                  first(1, 0), first(1, 1), first(1, 2),
+                  0., 0., 1.);
+    cv::Matx33d b(second(0, 0), second(0, 1), second(0, 2),
+                  second(1, 0), second(1, 1), second(1, 2),
+                  0., 0., 1.);
+    cv::Matx33d c = b * a;
+    return cv::Matx23d(c(0, 0), c(0, 1), c(0, 2),
+                       c(1, 0), c(1, 1), c(1, 2));
+}
+
+/**
+* @brief Samples an affine transformed image directly into a given Blob object with bilinear interpolation.
+* Warping, resizing to the blob size and conversion to the planar layout are done in one pass
+* without intermediate images.
+* @param image - given cv::Mat object with an image data (CV_8UC3).
+* @param transform - affine map from pixel coordinates of the blob to pixel coordinates of the image.
+* @param blob - Blob object which to be filled by an image data.
+* @param batchIndex - batch index of an image inside of the blob.
+* @param borderMode - cv::BORDER_CONSTANT fills the samples outside of the image with zeros,
+* cv::BORDER_REPLICATE repeats the border pixels.
+*/
+template <typename T>
+void warpAffineToBlob(const cv::Mat& image, const cv::Matx23d& transform, InferenceEngine::Blob::Ptr& blob,
+                      int batchIndex = 0, int borderMode = cv::BORDER_CONSTANT) {
+    InferenceEngine::SizeVector blobSize = blob->getTensorDesc().getDims();
+    const size_t width = blobSize[3];
+    const size_t height = blobSize[2];
+    const size_t channels = blobSize[1];
+    if (image.type() != CV_8UC3 || channels != 3) {
+        THROW_IE_EXCEPTION << "warpAffineToBlob supports only 3-channel 8-bit images";
+    }
+    T* blob_data = blob->buffer().as<T*>() + batchIndex * width * height * channels;
+    const size_t planeSize = width * height;
+    const int cols = image.cols;
+    const int rows = image.rows;
+    static const uchar zeros[3] = {0, 0, 0};
+
+    auto pixel = [&](int x, int y) -> const uchar* {
+        if (x < 0 || y < 0 || x >= cols || y >= rows) {
+            if (cv::BORDER_REPLICATE != borderMode) {
+                return zeros;
+            }
+            x = std::min(std::max(x, 0), cols - 1);
+            y = std::min(std::max(y, 0), rows - 1);
+        }
+        return image.ptr<uchar>(y) + 3 * x;
+    };
+
+    for (size_t h = 0; h < height; h++) {
+        const double rowX = transform(0, 1) * h + transform(0, 2);
+        const double rowY = transform(1, 1) * h + transform(1, 2);
+        for (size_t w = 0; w < width; w++) {
+            const double x = rowX + transform(0, 0) * w;
+            const double y = rowY + transform(1, 0) * w;
+            const int x0 = cvFloor(x);
+            const int y0 = cvFloor(y);
+            const float fx = static_cast<float>(x - x0);
+            const float fy = static_cast<float>(y - y0);
+            const uchar *p00, *p01, *p10, *p11;
+            if (x0 >= 0 && y0 >= 0 && x0 + 1 < cols && y0 + 1 < rows) {
+                p00 = image.ptr<uchar>(y0) + 3 * x0;
+                p01 = p00 + 3;
+                p10 = image.ptr<uchar>(y0 + 1) + 3 * x0;
+                p11 = p10 + 3;
+            } else {
+                p00 = pixel(x0, y0);
+                p01 = pixel(x0 + 1, y0);
+                p10 = pixel(x0, y0 + 1);
+                p11 = pixel(x0 + 1, y0 + 1);
+            }
+            T* dst = blob_data + h * width + w;
+            for (size_t c = 0; c < channels; c++) {
+                float top = p00[c] + fx * (p01[c] - p00[c]);
+                float bottom = p10[c] + fx * (p11[c] - p10[c]);
+                dst[c * planeSize] = cv::saturate_cast<T>(top + fy * (bottom - top));
+            }
+        }
+    }
+}
+
 /**
  * @brief Wraps data stored inside of a passed cv::Mat object by new Blob pointer.
  * @note: No memory allocation is happened. The blob just points to already existing
@@ -0,0 +1,325 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with periodic sampling of per-layer performance counters of running infer requests
+ * @file perf_sampler.hpp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+/**
+ * @class PerfCountersSampler
+ * @brief Collects per-layer performance counters from completed infer requests once per sampling period
+ * and aggregates the layer times into histograms. The requests are passed to onCompleted() in the order
+ * they complete and the first one after the period is sampled, so the samples rotate over the requests
+ * of a pool. The period grows if the time spent on sampling exceeds the overhead budget.
+ * Networks have to be loaded with KEY_PERF_COUNT enabled.
+ */
+class PerfCountersSampler {
+public:
+    /**
+     * @param period minimal interval between two samples of a network
+     * @param overheadBudget maximal share of the wall time spent on sampling, for example 0.01 for 1%
+     */
+    PerfCountersSampler(std::chrono::milliseconds period, double overheadBudget) :
+        period(period), overheadBudget(overheadBudget > 0. ? overheadBudget : 0.01),
+        start(Clock::now()), samplingTime(Clock::duration::zero()), samples(0), lastMetricsWrite(start) {}
+
+    PerfCountersSampler(const PerfCountersSampler&) = delete;
+    PerfCountersSampler& operator=(const PerfCountersSampler&) = delete;
+
+    /**
+     * @brief Sets the file the metrics are written to in Prometheus text format after a sample,
+     * at most once per period. The file is replaced atomically, so it can be read by a node exporter.
+     */
+    void setMetricsFile(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        metricsPath = path;
+    }
+
+    /**
+     * @brief Samples the performance counters of a request which has completed inference
+     * if the sampling period of its network has passed. Cheap otherwise.
+     */
+    void onCompleted(InferenceEngine::InferRequest& request, const std::string& network) {
+        Clock::time_point now = Clock::now();
+        if (now.time_since_epoch().count() < nextSample.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::string path;
+        Snapshot snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            NetworkStats& stats = networks[network];
+            if (now < stats.nextSample) {
+                updateNextSample();
+                return;
+            }
+            for (const auto& counter : request.GetPerformanceCounts()) {
+                if (InferenceEngine::InferenceEngineProfileInfo::EXECUTED != counter.second.status) {
+                    continue;
+                }
+                LayerStats& layer = stats.layers[counter.first];
+                if (layer.type.empty()) {
+                    layer.type = counter.second.layer_type;
+                    layer.execType = counter.second.exec_type;
+                    layer.buckets.assign(bucketBounds().size() + 1, 0);
+                }
+                layer.add(std::max<long long>(counter.second.realTime_uSec, 0));
+            }
+            ++stats.samples;
+            ++samples;
+            if (!metricsPath.empty() && now - lastMetricsWrite >= period) {
+                path = metricsPath;
+                snapshot = takeSnapshot();
+                lastMetricsWrite = now;
+            }
+
+            Clock::time_point end = Clock::now();
+            samplingTime += end - now;
+            // Stretch the period so that the average sampling overhead stays within the budget
+            auto elapsed = end - start;
+            auto allowedInterval = std::chrono::duration_cast<Clock::duration>(
+                (end - now) / overheadBudget);
+            stats.nextSample = end + std::max<Clock::duration>(period, allowedInterval);
+            if (samplingTime > std::chrono::duration_cast<Clock::duration>(elapsed * overheadBudget)) {
+                stats.nextSample += std::chrono::duration_cast<Clock::duration>(samplingTime / overheadBudget - elapsed);
+            }
+            updateNextSample();
+        }
+
+        // the file is written without the sampler lock, so other completion callbacks are not blocked by the disk
+        if (!path.empty()) {
+            Clock::time_point written = Clock::now();
+            writeMetricsFile(path, snapshot);
+            std::lock_guard<std::mutex> lock(mutex);
+            samplingTime += Clock::now() - written;
+        }
+    }
+
+    /**
+     * @brief Formats the slowest layers of every network by the mean time with their median and tail times
+     */
+    std::string report(size_t topLayers = 10) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(2);
+        double wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+        report << "Per-layer performance sampling: " << samples << " samples, overhead "
+               << (wallTime > 0. ? 100. * std::chrono::duration<double>(samplingTime).count() / wallTime : 0.)
+               << "%" << std::endl;
+        for (const auto& network : networks) {
+            std::vector<std::pair<double, const std::string*>> order;
+            for (const auto& layer : network.second.layers) {
+                order.emplace_back(layer.second.mean(), &layer.first);
+            }
+            std::sort(order.begin(), order.end(), [](const std::pair<double, const std::string*>& a,
+                                                     const std::pair<double, const std::string*>& b) {
+                return a.first > b.first;
+            });
+            report << network.first << " (" << network.second.samples << " samples):" << std::endl;
+            const int maxLayerName = 30;
+            for (size_t i = 0; i < order.size() && i < topLayers; i++) {
+                const LayerStats& layer = network.second.layers.at(*order[i].second);
+                std::string name = *order[i].second;
+                if (name.length() >= maxLayerName) {
+                    name = name.substr(0, maxLayerName - 4) + "...";
+                }
+                report << "    " << std::setw(maxLayerName) << std::left << name
+                       << std::setw(20) << std::left << layer.type
+                       << "mean " << std::setw(10) << std::left << layer.mean()
+                       << "p50 " << std::setw(10) << std::left << layer.quantile(0.5)
+                       << "p90 " << std::setw(10) << std::left << layer.quantile(0.9)
+                       << "p99 " << std::setw(10) << std::left << layer.quantile(0.99)
+                       << "us, execType: " << layer.execType << std::endl;
+            }
+        }
+        return report.str();
+    }
+
+    /**
+     * @brief Writes the layer time histograms in Prometheus text format
+     */
+    void writeMetrics(std::ostream& stream) const {
+        Snapshot snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            snapshot = takeSnapshot();
+        }
+        formatMetrics(stream, snapshot);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Upper bounds of the histogram buckets in microseconds
+    static const std::vector<long long>& bucketBounds() {
+        static const std::vector<long long> bounds{10, 20, 50, 100, 200, 500, 1000, 2000, 5000,
+                                                   10000, 20000, 50000, 100000, 200000, 500000};
+        return bounds;
+    }
+
+    struct LayerStats {
+        std::string type;
+        std::string execType;
+        /// @brief counts per bucket of bucketBounds(), the last one counts the times above all bounds
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        long long sum = 0;
+        long long max = 0;
+
+        void add(long long time) {
+            const auto& bounds = bucketBounds();
+            ++buckets[std::lower_bound(bounds.begin(), bounds.end(), time) - bounds.begin()];
+            ++count;
+            sum += time;
+            max = std::max(max, time);
+        }
+
+        double mean() const {
+            return 0 == count ? 0. : static_cast<double>(sum) / count;
+        }
+
+        /// @brief Estimates a quantile by linear interpolation within its bucket
+        double quantile(double q) const {
+            if (0 == count) {
+                return 0.;
+            }
+            const auto& bounds = bucketBounds();
+            double rank = q * count;
+            uint64_t accumulated = 0;
+            for (size_t i = 0; i < buckets.size(); i++) {
+                if (accumulated + buckets[i] >= rank && buckets[i] > 0) {
+                    double lower = 0 == i ? 0. : static_cast<double>(bounds[i - 1]);
+                    double upper = i < bounds.size() ? static_cast<double>(std::min(bounds[i], max))
+                                                     : static_cast<double>(max);
+                    return lower + (upper - lower) * (rank - accumulated) / buckets[i];
+                }
+                accumulated += buckets[i];
+            }
+            return static_cast<double>(max);
+        }
+    };
+
+    struct NetworkStats {
+        std::map<std::string, LayerStats> layers;
+        uint64_t samples = 0;
+        Clock::time_point nextSample;
+    };
+
+    /// @brief Copy of the histograms the metrics are formatted from outside of the sampler lock
+    struct Snapshot {
+        std::map<std::string, NetworkStats> networks;
+        double overhead = 0.;
+    };
+
+    // must be called under the lock
+    Snapshot takeSnapshot() const {
+        Snapshot snapshot;
+        snapshot.networks = networks;
+        double wallTime = std::chrono::duration<double>(Clock::now() - start).count();
+        snapshot.overhead = wallTime > 0. ? std::chrono::duration<double>(samplingTime).count() / wallTime : 0.;
+        return snapshot;
+    }
+
+    void updateNextSample() {
+        Clock::time_point earliest = Clock::time_point::max();
+        for (const auto& network : networks) {
+            earliest = std::min(earliest, network.second.nextSample);
+        }
+        nextSample.store(earliest.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    static std::string escapeLabel(const std::string& value) {
+        std::string escaped;
+        for (char c : value) {
+            if ('\\' == c || '"' == c) {
+                escaped += '\\';
+                escaped += c;
+            } else if ('\n' == c) {
+                escaped += "\\n";
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    static void formatMetrics(std::ostream& stream, const Snapshot& snapshot) {
+        const auto& bounds = bucketBounds();
+        stream << "# HELP omz_layer_time_microseconds Sampled per-layer inference time" << std::endl;
+        stream << "# TYPE omz_layer_time_microseconds histogram" << std::endl;
+        for (const auto& network : snapshot.networks) {
+            for (const auto& layer : network.second.layers) {
+                std::string labels = "network=\"" + escapeLabel(network.first) + "\",layer=\""
+                    + escapeLabel(layer.first) + "\",type=\"" + escapeLabel(layer.second.type) + "\"";
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < bounds.size(); i++) {
+                    cumulative += layer.second.buckets[i];
+                    stream << "omz_layer_time_microseconds_bucket{" << labels << ",le=\"" << bounds[i] << "\"} "
+                           << cumulative << std::endl;
+                }
+                stream << "omz_layer_time_microseconds_bucket{" << labels << ",le=\"+Inf\"} "
+                       << layer.second.count << std::endl;
+                stream << "omz_layer_time_microseconds_sum{" << labels << "} " << layer.second.sum << std::endl;
+                stream << "omz_layer_time_microseconds_count{" << labels << "} " << layer.second.count << std::endl;
+            }
+        }
+        stream << "# HELP omz_perf_sampling_overhead_ratio Share of the wall time spent on sampling" << std::endl;
+        stream << "# TYPE omz_perf_sampling_overhead_ratio gauge" << std::endl;
+        stream << "omz_perf_sampling_overhead_ratio " << snapshot.overhead << std::endl;
+    }
+
+    void writeMetricsFile(const std::string& path, const Snapshot& snapshot) {
+        // a write still in progress is not waited for, the next period writes newer histograms anyway
+        std::unique_lock<std::mutex> lock(fileMutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return;
+        }
+        const std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream file(tmpPath);
+            if (!file) {
+                return;
+            }
+            formatMetrics(file, snapshot);
+        }
+#ifdef _WIN32
+        std::remove(path.c_str());
+#endif
+        std::rename(tmpPath.c_str(), path.c_str());
+    }
+
+    const Clock::duration period;
+    const double overheadBudget;
+    const Clock::time_point start;
+
+    mutable std::mutex mutex;
+    /// @brief serializes the metrics file writes, which are made without the sampler lock
+    std::mutex fileMutex;
+    /// @brief the earliest sampling time of all networks, checked without locking
+    std::atomic<Clock::rep> nextSample{0};
+    std::map<std::string, NetworkStats> networks;
+    Clock::duration samplingTime;
+    uint64_t samples;
+    std::string metricsPath;
+    Clock::time_point lastMetricsWrite;
+};
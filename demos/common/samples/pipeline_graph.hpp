@@ -0,0 +1,689 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with a runtime executing a demo pipeline described by a graph of stages
+ * @file pipeline_graph.hpp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include <samples/slog.hpp>
+#include <samples/thread_budget.hpp>
+
+namespace pipeline {
+
+/// @brief Region of interest of a frame with the results of the stages which processed it
+struct Object {
+    cv::Rect rect;
+    int label = -1;
+    float confidence = 0.f;
+    int trackId = -1;
+    std::map<std::string, std::string> attributes;
+};
+
+/**
+ * @brief Unit of work passed between stages. A packet is copied for every additional output edge of a stage,
+ * the copies share the pixels of the frame, so a stage drawing on the frame has to clone it.
+ */
+struct Packet {
+    typedef std::shared_ptr<Packet> Ptr;
+
+    std::size_t sourceId = 0;
+    int64_t frameId = 0;
+    cv::Mat frame;
+    std::vector<Object> objects;
+};
+
+/// @brief What an edge does with a packet when its queue is full
+enum class QueuePolicy {
+    BLOCK,        ///< the producing stage is not scheduled until the queue has space
+    DROP_OLDEST,  ///< the oldest queued packet is dropped
+    DROP_NEWEST   ///< the incoming packet is dropped
+};
+
+inline QueuePolicy parseQueuePolicy(const std::string& policy) {
+    if ("block" == policy) {
+        return QueuePolicy::BLOCK;
+    } else if ("drop_oldest" == policy) {
+        return QueuePolicy::DROP_OLDEST;
+    } else if ("drop_newest" == policy) {
+        return QueuePolicy::DROP_NEWEST;
+    }
+    throw std::logic_error("Unknown queue policy \"" + policy + "\", expected block, drop_oldest or drop_newest");
+}
+
+inline std::string readString(const cv::FileNode& node, const std::string& key, const std::string& defaultValue = "") {
+    const cv::FileNode value = node[key];
+    return value.empty() ? defaultValue : static_cast<std::string>(value);
+}
+
+inline int readInt(const cv::FileNode& node, const std::string& key, int defaultValue) {
+    const cv::FileNode value = node[key];
+    return value.empty() ? defaultValue : static_cast<int>(value);
+}
+
+inline double readDouble(const cv::FileNode& node, const std::string& key, double defaultValue) {
+    const cv::FileNode value = node[key];
+    return value.empty() ? defaultValue : static_cast<double>(value);
+}
+
+inline std::vector<std::string> readStrings(const cv::FileNode& node) {
+    std::vector<std::string> values;
+    if (node.isSeq()) {
+        for (cv::FileNodeIterator it = node.begin(); it != node.end(); ++it) {
+            values.push_back(static_cast<std::string>(*it));
+        }
+    } else if (!node.empty()) {
+        values.push_back(static_cast<std::string>(node));
+    }
+    return values;
+}
+
+inline std::vector<int> readInts(const cv::FileNode& node) {
+    std::vector<int> values;
+    if (node.isSeq()) {
+        for (cv::FileNodeIterator it = node.begin(); it != node.end(); ++it) {
+            values.push_back(static_cast<int>(*it));
+        }
+    } else if (!node.empty()) {
+        values.push_back(static_cast<int>(node));
+    }
+    return values;
+}
+
+/// @brief Callbacks of the graph available to the stages
+struct StageHooks {
+    /// @brief Reschedules the graph after the stage became ready, e.g. an infer request was released
+    std::function<void()> wake;
+    /// @brief Stops the graph because of an error in an asynchronous part of the stage
+    std::function<void(std::exception_ptr)> fail;
+    /// @brief Stops the graph, e.g. on a key press in a display
+    std::function<void()> stop;
+};
+
+/**
+ * @class Stage
+ * @brief Base class of the graph stages. A source stage produces packets, the other stages process packets of
+ * their input edges and pass them to their output edges.
+ */
+class Stage {
+public:
+    typedef std::function<void(Packet::Ptr)> Emit;
+
+    virtual ~Stage() = default;
+
+    virtual bool isSource() const {
+        return false;
+    }
+
+    /// @brief Produces the next packet of a source, nullptr means the source is exhausted
+    virtual Packet::Ptr produce() {
+        return nullptr;
+    }
+
+    /// @brief Returns false while the stage can not take a packet, e.g. all its infer requests are busy
+    virtual bool ready() {
+        return true;
+    }
+
+    /**
+     * @brief Processes the packet and calls emit exactly once, possibly later from another thread.
+     * Emitting nullptr drops the packet.
+     */
+    virtual void process(Packet::Ptr packet, Emit emit) {
+        emit(packet);
+    }
+
+    /// @brief Maximal number of packets processed at once, stages with state process them one by one
+    virtual unsigned concurrency() const {
+        return 1;
+    }
+
+    virtual ThreadBudget::Partition partition() const {
+        return ThreadBudget::POSTPROCESSING;
+    }
+
+    void setHooks(const StageHooks& stageHooks) {
+        hooks = stageHooks;
+    }
+
+protected:
+    StageHooks hooks;
+};
+
+/**
+ * @class StageFactory
+ * @brief Creates stages by the type names used in graph descriptions
+ */
+class StageFactory {
+public:
+    typedef std::function<std::unique_ptr<Stage>(const cv::FileNode&)> Creator;
+
+    void add(const std::string& type, const Creator& creator) {
+        creators[type] = creator;
+    }
+
+    std::unique_ptr<Stage> create(const std::string& type, const cv::FileNode& config) const {
+        auto it = creators.find(type);
+        if (creators.end() == it) {
+            throw std::logic_error("Unknown stage type \"" + type + "\"");
+        }
+        return it->second(config);
+    }
+
+private:
+    std::map<std::string, Creator> creators;
+};
+
+/**
+ * @class Graph
+ * @brief Runs the stages of a graph description on a shared thread pool. The description is a JSON or YAML file read
+ * with cv::FileStorage:
+ *
+ *     threads: 4
+ *     stages:
+ *       - { name: camera, type: video, input: "0" }
+ *       - { name: detector, type: detector, inputs: [ camera ], model: detector.xml, requests: 2 }
+ *       - name: display
+ *         type: display
+ *         inputs: [ { from: detector, capacity: 2, policy: drop_oldest, ordered: 1 } ]
+ *
+ * Every edge has its own queue of the given capacity (8 by default) with a policy for a full queue
+ * (block by default). An ordered edge passes packets of a source in the order of the source frames,
+ * a packet missing from the order is waited for until the capacity of out of order packets is reached.
+ * Stages are scheduled by the pool threads when they have an input packet, are ready, are processing less packets
+ * than their concurrency and none of their blocking output queues is full.
+ */
+class Graph {
+public:
+    Graph(const std::string& description, const StageFactory& factory, ThreadBudget* threadBudget = nullptr) :
+        threadBudget(threadBudget), threadsNum(1), stopping(false), finished(false), nextNode(0) {
+        cv::FileStorage fs(description, cv::FileStorage::READ);
+        if (!fs.isOpened()) {
+            throw std::logic_error("Can not read the graph description " + description);
+        }
+        threadsNum = static_cast<unsigned>(std::max(1, readInt(fs.root(), "threads", 2)));
+        const cv::FileNode stagesNode = fs["stages"];
+        if (!stagesNode.isSeq() || 0 == stagesNode.size()) {
+            throw std::logic_error("The graph description " + description + " has no stages");
+        }
+
+        std::map<std::string, std::size_t> indices;
+        for (cv::FileNodeIterator it = stagesNode.begin(); it != stagesNode.end(); ++it) {
+            const cv::FileNode stageNode = *it;
+            std::unique_ptr<Node> node(new Node);
+            node->name = readString(stageNode, "name");
+            const std::string type = readString(stageNode, "type");
+            if (node->name.empty() || type.empty()) {
+                throw std::logic_error("Every stage of the graph requires a name and a type");
+            }
+            if (!indices.emplace(node->name, nodes.size()).second) {
+                throw std::logic_error("Stage name \"" + node->name + "\" is repeated");
+            }
+            node->stage = factory.create(type, stageNode);
+            if (node->stage->isSource()) {
+                node->sourceId = sourcesNum++;
+            }
+            readInputs(*node, stageNode["inputs"]);
+            nodes.push_back(std::move(node));
+        }
+
+        for (std::size_t to = 0; to < nodes.size(); ++to) {
+            Node& node = *nodes[to];
+            if (node.stage->isSource() != node.inputs.empty()) {
+                throw std::logic_error("Stage \"" + node.name + (node.inputs.empty() ? "\" requires inputs" : "\" is a source and can not have inputs"));
+            }
+            for (auto& edge : node.inputs) {
+                auto from = indices.find(edge->fromName);
+                if (indices.end() == from) {
+                    throw std::logic_error("Stage \"" + node.name + "\" has unknown input \"" + edge->fromName + '"');
+                }
+                edge->from = from->second;
+                edge->to = to;
+                nodes[from->second]->outputs.push_back(edge.get());
+            }
+        }
+        checkAcyclic();
+
+        StageHooks hooks;
+        hooks.wake = [this] {
+            { std::lock_guard<std::mutex> lock(mutex); }
+            condVar.notify_all();
+        };
+        hooks.fail = [this](std::exception_ptr exception) {
+            setException(exception);
+        };
+        hooks.stop = [this] {
+            stop();
+        };
+        for (auto& node : nodes) {
+            node->stage->setHooks(hooks);
+        }
+    }
+
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    ~Graph() {
+        stop();
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    unsigned threadsNumber() const {
+        return threadsNum;
+    }
+
+    /// @brief Runs the graph until all sources are exhausted and processed or the graph is stopped
+    void run() {
+        start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < threadsNum; ++i) {
+            threads.emplace_back(&Graph::threadFunc, this);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+        runTime = std::chrono::steady_clock::now() - start;
+        if (nullptr != exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    /// @brief Stops the sources, drops queued packets and lets the packets being processed finish
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+            stopping = true;
+            for (auto& node : nodes) {
+                for (auto& edge : node->inputs) {
+                    edge->dropped += edge->queue.size() + edge->outOfOrder.size();
+                    edge->queue.clear();
+                    edge->outOfOrder.clear();
+                }
+            }
+        }
+        condVar.notify_all();
+    }
+
+    /// @brief Prints processed and dropped packets, processing latency and queue waiting time of every stage
+    void report(std::ostream& stream) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        const double seconds = std::chrono::duration_cast<Ms>(runTime).count() / 1000.;
+        stream << std::left << std::setw(24) << "stage" << std::right << std::setw(10) << "packets" << std::setw(10) << "fps"
+               << std::setw(10) << "dropped" << std::setw(14) << "latency, ms" << std::setw(12) << "queue, ms"
+               << std::setw(12) << "max queue" << '\n';
+        for (const auto& node : nodes) {
+            std::size_t dropped = node->discarded;
+            std::size_t maxQueue = 0;
+            for (const auto& edge : node->inputs) {
+                dropped += edge->dropped;
+                maxQueue = std::max(maxQueue, edge->maxSize);
+            }
+            const std::size_t packets = node->stage->isSource() ? node->produced : node->processed;
+            stream << std::left << std::setw(24) << node->name << std::right << std::fixed << std::setprecision(1)
+                   << std::setw(10) << packets << std::setw(10) << (seconds > 0 ? packets / seconds : 0.)
+                   << std::setw(10) << dropped
+                   << std::setw(14) << mean(node->busyTime, node->processed)
+                   << std::setw(12) << mean(node->queueTime, node->processed)
+                   << std::setw(12) << maxQueue << '\n';
+        }
+    }
+
+private:
+    typedef std::chrono::duration<double, std::ratio<1, 1000>> Ms;
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    struct Queued {
+        Packet::Ptr packet;
+        TimePoint enqueued;
+    };
+
+    struct Edge {
+        std::string fromName;
+        std::size_t from = 0;
+        std::size_t to = 0;
+        std::size_t capacity = 8;
+        QueuePolicy policy = QueuePolicy::BLOCK;
+        bool ordered = false;
+        std::deque<Queued> queue;
+        std::map<std::pair<std::size_t, int64_t>, Queued> outOfOrder;
+        std::map<std::size_t, int64_t> nextFrameIds;  // next frame expected from each source by an ordered edge
+        std::size_t dropped = 0;
+        std::size_t maxSize = 0;
+    };
+
+    struct Node {
+        std::string name;
+        std::unique_ptr<Stage> stage;
+        std::vector<std::unique_ptr<Edge>> inputs;
+        std::vector<Edge*> outputs;
+        std::size_t nextInput = 0;
+        unsigned active = 0;
+        bool exhausted = false;
+        std::size_t sourceId = 0;
+        std::size_t produced = 0;
+        std::size_t processed = 0;
+        std::size_t discarded = 0;
+        std::chrono::steady_clock::duration busyTime = std::chrono::steady_clock::duration::zero();
+        std::chrono::steady_clock::duration queueTime = std::chrono::steady_clock::duration::zero();
+    };
+
+    static double mean(std::chrono::steady_clock::duration time, std::size_t count) {
+        return 0 == count ? 0. : std::chrono::duration_cast<Ms>(time).count() / count;
+    }
+
+    void readInputs(Node& node, const cv::FileNode& inputsNode) {
+        if (inputsNode.empty()) {
+            return;
+        }
+        std::vector<cv::FileNode> inputNodes;
+        if (inputsNode.isSeq()) {
+            for (cv::FileNodeIterator it = inputsNode.begin(); it != inputsNode.end(); ++it) {
+                inputNodes.push_back(*it);
+            }
+        } else {
+            inputNodes.push_back(inputsNode);
+        }
+        for (const cv::FileNode& inputNode : inputNodes) {
+            std::unique_ptr<Edge> edge(new Edge);
+            if (inputNode.isMap()) {
+                edge->fromName = readString(inputNode, "from");
+                const int capacity = readInt(inputNode, "capacity", static_cast<int>(edge->capacity));
+                if (capacity <= 0) {
+                    throw std::logic_error("Queue capacity of the input of stage \"" + node.name + "\" must be positive");
+                }
+                edge->capacity = static_cast<std::size_t>(capacity);
+                edge->policy = parseQueuePolicy(readString(inputNode, "policy", "block"));
+                edge->ordered = 0 != readInt(inputNode, "ordered", 0);
+            } else {
+                edge->fromName = static_cast<std::string>(inputNode);
+            }
+            node.inputs.push_back(std::move(edge));
+        }
+    }
+
+    void checkAcyclic() const {
+        // 0 - not visited, 1 - on the current path, 2 - done
+        std::vector<int> state(nodes.size(), 0);
+        std::function<void(std::size_t)> visit = [&](std::size_t index) {
+            if (1 == state[index]) {
+                throw std::logic_error("The graph has a cycle through stage \"" + nodes[index]->name + '"');
+            }
+            if (2 == state[index]) {
+                return;
+            }
+            state[index] = 1;
+            for (const Edge* edge : nodes[index]->outputs) {
+                visit(edge->to);
+            }
+            state[index] = 2;
+        };
+        for (std::size_t index = 0; index < nodes.size(); ++index) {
+            visit(index);
+        }
+    }
+
+    void setException(std::exception_ptr error) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (nullptr == exception) {
+                exception = error;
+            }
+        }
+        stop();
+    }
+
+    bool outputsBlocked(const Node& node) const {
+        for (const Edge* edge : node.outputs) {
+            if (QueuePolicy::BLOCK == edge->policy && edge->queue.size() >= edge->capacity) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // takes the next packet for the node, returns nullptr if there is none
+    Edge* nextInput(Node& node) {
+        for (std::size_t i = 0; i < node.inputs.size(); ++i) {
+            Edge* edge = node.inputs[(node.nextInput + i) % node.inputs.size()].get();
+            if (!edge->queue.empty()) {
+                node.nextInput = (node.nextInput + i + 1) % node.inputs.size();
+                return edge;
+            }
+        }
+        return nullptr;
+    }
+
+    // finds a node to run and reserves its work, must be called under the lock
+    bool findWork(Node*& found, Queued& work) {
+        for (std::size_t i = 0; i < nodes.size(); ++i) {
+            Node& node = *nodes[(nextNode + i) % nodes.size()];
+            if (node.active >= node.stage->concurrency() || outputsBlocked(node)) {
+                continue;
+            }
+            if (node.stage->isSource()) {
+                if (stopping || node.exhausted) {
+                    continue;
+                }
+                work = Queued();
+            } else {
+                Edge* edge = nextInput(node);
+                if (nullptr == edge || !node.stage->ready()) {
+                    continue;
+                }
+                work = std::move(edge->queue.front());
+                edge->queue.pop_front();
+            }
+            node.active++;
+            found = &node;
+            nextNode = (nextNode + i + 1) % nodes.size();
+            return true;
+        }
+        return false;
+    }
+
+    // all packets are processed when no stage is active and no packet is queued
+    bool drained() {
+        bool outOfOrder = false;
+        for (const auto& node : nodes) {
+            if (0 != node->active || (node->stage->isSource() && !node->exhausted && !stopping)) {
+                return false;
+            }
+            for (const auto& edge : node->inputs) {
+                if (!edge->queue.empty()) {
+                    return false;
+                }
+                outOfOrder = outOfOrder || !edge->outOfOrder.empty();
+            }
+        }
+        if (outOfOrder) {
+            // the missing packets were dropped, so the rest is passed as is
+            for (auto& node : nodes) {
+                for (auto& edge : node->inputs) {
+                    for (auto& queued : edge->outOfOrder) {
+                        edge->queue.push_back(std::move(queued.second));
+                    }
+                    edge->outOfOrder.clear();
+                }
+            }
+            return false;
+        }
+        return true;
+    }
+
+    void threadFunc() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            Node* node = nullptr;
+            Queued work;
+            condVar.wait(lock, [&] {
+                if (finished || findWork(node, work)) {
+                    return true;
+                }
+                finished = drained();
+                // draining could release the out of order packets
+                return finished || findWork(node, work);
+            });
+            if (nullptr == node) {
+                condVar.notify_all();
+                return;
+            }
+            lock.unlock();
+            // a stage may emit before it throws or emit later from a callback, so the node is released once
+            std::shared_ptr<bool> released = std::make_shared<bool>(false);
+            try {
+                if (nullptr != threadBudget) {
+                    ThreadBudget::ScopedCharge charge(*threadBudget, node->stage->partition());
+                    runNode(*node, std::move(work), released);
+                } else {
+                    runNode(*node, std::move(work), released);
+                }
+            } catch (...) {
+                setException(std::current_exception());
+                lock.lock();
+                release(*node, *released);
+                lock.unlock();
+            }
+            lock.lock();
+        }
+    }
+
+    // decrements the active runs of the node unless the run is already released, must be called under the lock
+    static void release(Node& node, bool& released) {
+        if (!released) {
+            released = true;
+            node.active--;
+        }
+    }
+
+    void runNode(Node& node, Queued work, const std::shared_ptr<bool>& released) {
+        const TimePoint started = std::chrono::steady_clock::now();
+        if (node.stage->isSource()) {
+            Packet::Ptr packet = node.stage->produce();
+            std::lock_guard<std::mutex> lock(mutex);
+            release(node, *released);
+            if (nullptr == packet) {
+                node.exhausted = true;
+            } else {
+                packet->sourceId = node.sourceId;
+                packet->frameId = static_cast<int64_t>(node.produced++);
+                push(node, packet);
+            }
+            condVar.notify_all();
+            return;
+        }
+
+        const std::chrono::steady_clock::duration queueTime = started - work.enqueued;
+        node.stage->process(work.packet, [this, &node, started, queueTime, released](Packet::Ptr packet) {
+            std::lock_guard<std::mutex> lock(mutex);
+            release(node, *released);
+            node.processed++;
+            node.busyTime += std::chrono::steady_clock::now() - started;
+            node.queueTime += queueTime;
+            if (nullptr == packet) {
+                node.discarded++;
+            } else if (!stopping) {
+                push(node, packet);
+            }
+            condVar.notify_all();
+        });
+    }
+
+    // passes the packet to the output edges of the node, must be called under the lock
+    void push(Node& node, const Packet::Ptr& packet) {
+        for (std::size_t i = 0; i < node.outputs.size(); ++i) {
+            Edge& edge = *node.outputs[i];
+            Queued queued{i + 1 == node.outputs.size() ? packet : std::make_shared<Packet>(*packet),
+                          std::chrono::steady_clock::now()};
+            if (edge.ordered) {
+                pushOrdered(edge, std::move(queued));
+            } else {
+                enqueue(edge, std::move(queued));
+            }
+        }
+    }
+
+    void pushOrdered(Edge& edge, Queued queued) {
+        const std::size_t sourceId = queued.packet->sourceId;
+        int64_t& nextFrameId = edge.nextFrameIds[sourceId];
+        if (queued.packet->frameId < nextFrameId) {
+            edge.dropped++;  // came after a later frame was passed
+            return;
+        }
+        edge.outOfOrder.emplace(std::make_pair(sourceId, queued.packet->frameId), std::move(queued));
+        while (true) {
+            auto first = edge.outOfOrder.lower_bound(std::make_pair(sourceId, int64_t(0)));
+            if (edge.outOfOrder.end() == first || first->first.first != sourceId) {
+                break;
+            }
+            // a missing frame is not waited for when the out of order frames fill the capacity
+            const bool waiting = first->first.second != nextFrameId;
+            if (waiting && edge.outOfOrder.size() <= edge.capacity) {
+                break;
+            }
+            nextFrameId = first->first.second + 1;
+            enqueue(edge, std::move(first->second));
+            edge.outOfOrder.erase(first);
+        }
+    }
+
+    void enqueue(Edge& edge, Queued queued) {
+        if (edge.queue.size() >= edge.capacity) {
+            if (QueuePolicy::DROP_NEWEST == edge.policy) {
+                edge.dropped++;
+                return;
+            } else if (QueuePolicy::DROP_OLDEST == edge.policy) {
+                edge.queue.pop_front();
+                edge.dropped++;
+            }
+            // a blocking queue takes the packets already processed by the producer beyond its capacity
+        }
+        edge.queue.push_back(std::move(queued));
+        edge.maxSize = std::max(edge.maxSize, edge.queue.size());
+    }
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::size_t sourcesNum = 0;
+    ThreadBudget* threadBudget;
+    unsigned threadsNum;
+
+    mutable std::mutex mutex;
+    std::condition_variable condVar;
+    std::vector<std::thread> threads;
+    bool stopping;
+    bool finished;
+    std::size_t nextNode;
+    std::exception_ptr exception;
+    TimePoint start;
+    std::chrono::steady_clock::duration runTime = std::chrono::steady_clock::duration::zero();
+};
+
+}  // namespace pipeline
@@ -0,0 +1,525 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with the built-in stages of pipeline graphs: video sources, networks, a tracker and sinks
+ * @file pipeline_stages.hpp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <inference_engine.hpp>
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/videoio/videoio.hpp>
+
+#include <samples/ocv_common.hpp>
+#include <samples/pipeline_graph.hpp>
+#include <samples/slog.hpp>
+
+namespace pipeline {
+
+/**
+ * @class VideoSource
+ * @brief Reads frames of a video file or a camera given by its index.
+ * Parameters: input, loop (0 or 1), max_frames (0 is unlimited).
+ */
+class VideoSource : public Stage {
+public:
+    VideoSource(const cv::FileNode& config, const std::string& defaultInput) :
+        input(readString(config, "input", defaultInput)), loop(0 != readInt(config, "loop", 0)),
+        maxFrames(std::max(0, readInt(config, "max_frames", 0))), frames(0) {
+        if (input.empty()) {
+            throw std::logic_error("Video source requires an input");
+        }
+        open();
+    }
+
+    bool isSource() const override {
+        return true;
+    }
+
+    Packet::Ptr produce() override {
+        if (0 != maxFrames && frames >= maxFrames) {
+            return nullptr;
+        }
+        Packet::Ptr packet = std::make_shared<Packet>();
+        if (!capture.read(packet->frame) || packet->frame.empty()) {
+            if (!loop || 0 == frames) {
+                return nullptr;
+            }
+            open();
+            if (!capture.read(packet->frame) || packet->frame.empty()) {
+                return nullptr;
+            }
+        }
+        frames++;
+        return packet;
+    }
+
+    ThreadBudget::Partition partition() const override {
+        return ThreadBudget::CAPTURE;
+    }
+
+private:
+    void open() {
+        const bool isCamera = std::all_of(input.begin(), input.end(), [](char c) {
+            return std::isdigit(static_cast<unsigned char>(c));
+        });
+        if (!(isCamera ? capture.open(std::stoi(input)) : capture.open(input))) {
+            throw std::logic_error("Can not open the video source " + input);
+        }
+    }
+
+    const std::string input;
+    const bool loop;
+    const int maxFrames;
+    int frames;
+    cv::VideoCapture capture;
+};
+
+/**
+ * @class NetworkStage
+ * @brief Base of the stages inferring a network on a pool of infer requests.
+ * Parameters: model, device (CPU by default), requests (1 by default). Relative model paths are resolved
+ * against the directory of the graph description.
+ */
+class NetworkStage : public Stage {
+public:
+    NetworkStage(const cv::FileNode& config, InferenceEngine::Core& ie, const std::string& modelsDir) {
+        std::string model = readString(config, "model");
+        if (model.empty()) {
+            throw std::logic_error("Network stage \"" + readString(config, "name") + "\" requires a model");
+        }
+        if (!modelsDir.empty() && '/' != model.front() && std::string::npos == model.find(':')) {
+            model = modelsDir + '/' + model;
+        }
+        const std::string device = readString(config, "device", "CPU");
+        const int requestsNum = readInt(config, "requests", 1);
+        if (requestsNum <= 0) {
+            throw std::logic_error("Number of requests of \"" + readString(config, "name") + "\" must be positive");
+        }
+
+        slog::info << "Loading network " << model << " to the " << device << " plugin" << slog::endl;
+        InferenceEngine::CNNNetReader netReader;
+        netReader.ReadNetwork(model);
+        netReader.ReadWeights(fileNameNoExt(model) + ".bin");
+        InferenceEngine::InputsDataMap inputInfo(netReader.getNetwork().getInputsInfo());
+        if (1 != inputInfo.size()) {
+            throw std::logic_error("Network " + model + " must have one input");
+        }
+        inputName = inputInfo.begin()->first;
+        inputInfo.begin()->second->setPrecision(InferenceEngine::Precision::U8);
+        InferenceEngine::OutputsDataMap outputInfo(netReader.getNetwork().getOutputsInfo());
+        for (auto& output : outputInfo) {
+            output.second->setPrecision(InferenceEngine::Precision::FP32);
+            outputNames.push_back(output.first);
+        }
+        network = ie.LoadNetwork(netReader.getNetwork(), device);
+
+        requests.resize(static_cast<std::size_t>(requestsNum));
+        for (auto& request : requests) {
+            request = network.CreateInferRequest();
+            freeRequests.push_back(&request);
+        }
+    }
+
+    bool ready() override {
+        std::lock_guard<std::mutex> lock(requestsMutex);
+        return !freeRequests.empty();
+    }
+
+    unsigned concurrency() const override {
+        return static_cast<unsigned>(requests.size());
+    }
+
+    ThreadBudget::Partition partition() const override {
+        return ThreadBudget::PREPROCESSING;
+    }
+
+protected:
+    InferenceEngine::InferRequest* acquireRequest() {
+        std::lock_guard<std::mutex> lock(requestsMutex);
+        if (freeRequests.empty()) {
+            return nullptr;
+        }
+        InferenceEngine::InferRequest* request = freeRequests.back();
+        freeRequests.pop_back();
+        return request;
+    }
+
+    void releaseRequest(InferenceEngine::InferRequest* request) {
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex);
+            freeRequests.push_back(request);
+        }
+        hooks.wake();
+    }
+
+    void setImage(InferenceEngine::InferRequest& request, const cv::Mat& image) {
+        InferenceEngine::Blob::Ptr input = request.GetBlob(inputName);
+        matU8ToBlob<uint8_t>(image, input);
+    }
+
+    std::string inputName;
+    std::vector<std::string> outputNames;
+
+private:
+    InferenceEngine::ExecutableNetwork network;
+    std::vector<InferenceEngine::InferRequest> requests;
+    std::vector<InferenceEngine::InferRequest*> freeRequests;
+    std::mutex requestsMutex;
+};
+
+/**
+ * @class DetectorStage
+ * @brief Infers an SSD-like detector with the [1x1xNx7] output on the frame and adds the detected objects.
+ * Parameters: threshold (0.5 by default), labels - the list of the kept labels, all labels are kept if it is empty.
+ */
+class DetectorStage : public NetworkStage {
+public:
+    DetectorStage(const cv::FileNode& config, InferenceEngine::Core& ie, const std::string& modelsDir) :
+        NetworkStage(config, ie, modelsDir), threshold(static_cast<float>(readDouble(config, "threshold", 0.5))) {
+        labels = readInts(config["labels"]);
+    }
+
+    void process(Packet::Ptr packet, Emit emit) override {
+        InferenceEngine::InferRequest* request = acquireRequest();
+        if (nullptr == request) {
+            throw std::logic_error("Detector is scheduled without a free infer request");
+        }
+        try {
+            setImage(*request, packet->frame);
+            request->SetCompletionCallback(
+                std::bind([this](Packet::Ptr packet, InferenceEngine::InferRequest* request, Emit emit) {
+                        request->SetCompletionCallback([]{});  // destroy the stored bind object
+                        try {
+                            parse(*request, *packet);
+                        } catch (...) {
+                            hooks.fail(std::current_exception());
+                        }
+                        releaseRequest(request);
+                        emit(packet);
+                    }, packet, request, emit));
+            request->StartAsync();
+        } catch (...) {
+            // the callback never runs, so the request goes back to the pool here
+            request->SetCompletionCallback([]{});
+            releaseRequest(request);
+            throw;
+        }
+    }
+
+private:
+    void parse(InferenceEngine::InferRequest& request, Packet& packet) const {
+        InferenceEngine::Blob::Ptr output = request.GetBlob(outputNames.front());
+        const InferenceEngine::SizeVector& dims = output->getTensorDesc().getDims();
+        if (4 != dims.size() || 7 != dims[3]) {
+            throw std::logic_error("Detector output must have [1x1xNx7] shape");
+        }
+        const float* data = output->buffer().as<float*>();
+        for (std::size_t i = 0; i < dims[2]; ++i, data += 7) {
+            if (data[0] < 0) {  // end of the detections
+                break;
+            }
+            Object object;
+            object.label = static_cast<int>(data[1]);
+            object.confidence = data[2];
+            if (object.confidence < threshold
+                || (!labels.empty() && labels.end() == std::find(labels.begin(), labels.end(), object.label))) {
+                continue;
+            }
+            cv::Point topLeft(static_cast<int>(data[3] * packet.frame.cols), static_cast<int>(data[4] * packet.frame.rows));
+            cv::Point bottomRight(static_cast<int>(data[5] * packet.frame.cols), static_cast<int>(data[6] * packet.frame.rows));
+            object.rect = cv::Rect(topLeft, bottomRight) & cv::Rect(0, 0, packet.frame.cols, packet.frame.rows);
+            if (object.rect.area() > 0) {
+                packet.objects.push_back(object);
+            }
+        }
+    }
+
+    const float threshold;
+    std::vector<int> labels;
+};
+
+/**
+ * @class ClassifierStage
+ * @brief Infers a classifier on every object of the frame with one of the given labels and stores the index of
+ * the maximal value of each output as an object attribute named by the output. The objects of a frame are
+ * inferred by all free infer requests in parallel.
+ * Parameters: roi_labels - the labels of the classified objects, all objects are classified if it is empty;
+ * labels - names of the classes, either a list for all outputs or a map from an output name to a list.
+ */
+class ClassifierStage : public NetworkStage {
+public:
+    ClassifierStage(const cv::FileNode& config, InferenceEngine::Core& ie, const std::string& modelsDir) :
+        NetworkStage(config, ie, modelsDir) {
+        roiLabels = readInts(config["roi_labels"]);
+        const cv::FileNode labelsNode = config["labels"];
+        if (labelsNode.isMap()) {
+            for (const std::string& output : outputNames) {
+                classNames[output] = readStrings(labelsNode[output]);
+            }
+        } else {
+            const std::vector<std::string> names = readStrings(labelsNode);
+            for (const std::string& output : outputNames) {
+                classNames[output] = names;
+            }
+        }
+    }
+
+    void process(Packet::Ptr packet, Emit emit) override {
+        std::shared_ptr<Job> job = std::make_shared<Job>();
+        job->packet = packet;
+        job->emit = emit;
+        const cv::Rect frameRect(0, 0, packet->frame.cols, packet->frame.rows);
+        for (std::size_t i = 0; i < packet->objects.size(); ++i) {
+            const Object& object = packet->objects[i];
+            if ((roiLabels.empty() || roiLabels.end() != std::find(roiLabels.begin(), roiLabels.end(), object.label))
+                && (object.rect & frameRect).area() > 0) {
+                job->objects.push_back(i);
+            }
+        }
+        if (job->objects.empty()) {
+            emit(packet);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            jobs.push_back(job);
+        }
+        dispatch();
+    }
+
+private:
+    struct Job {
+        Packet::Ptr packet;
+        Emit emit;
+        std::vector<std::size_t> objects;
+        std::size_t started = 0;
+        std::atomic<std::size_t> finished{0};
+    };
+
+    // starts the not started objects of the jobs on the free infer requests
+    void dispatch(InferenceEngine::InferRequest* request = nullptr) {
+        while (true) {
+            std::shared_ptr<Job> job;
+            std::size_t objectId = 0;
+            {
+                std::lock_guard<std::mutex> lock(jobsMutex);
+                if (jobs.empty()) {
+                    break;
+                }
+                if (nullptr == request) {
+                    request = acquireRequest();
+                    if (nullptr == request) {
+                        break;
+                    }
+                }
+                job = jobs.front();
+                objectId = job->objects[job->started++];
+                if (job->objects.size() == job->started) {
+                    jobs.pop_front();
+                }
+            }
+            const cv::Mat& frame = job->packet->frame;
+            try {
+                setImage(*request, frame(job->packet->objects[objectId].rect & cv::Rect(0, 0, frame.cols, frame.rows)));
+            } catch (...) {
+                releaseRequest(request);
+                throw;
+            }
+            request->SetCompletionCallback(
+                std::bind([this](std::shared_ptr<Job> job, std::size_t objectId, InferenceEngine::InferRequest* request) {
+                        request->SetCompletionCallback([]{});  // destroy the stored bind object
+                        try {
+                            parse(*request, job->packet->objects[objectId]);
+                        } catch (...) {
+                            hooks.fail(std::current_exception());
+                        }
+                        const bool done = job->objects.size() == ++job->finished;
+                        // the request goes on with the next object instead of returning to the pool
+                        if (!continueWith(request)) {
+                            releaseRequest(request);
+                        }
+                        // the graph may finish once the last packet is emitted, so nothing follows the emission
+                        if (done) {
+                            job->emit(job->packet);
+                        }
+                    }, job, objectId, request));
+            request->StartAsync();
+            request = nullptr;
+        }
+        if (nullptr != request) {
+            releaseRequest(request);
+        }
+    }
+
+    bool continueWith(InferenceEngine::InferRequest* request) {
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            if (jobs.empty()) {
+                return false;
+            }
+        }
+        dispatch(request);
+        return true;
+    }
+
+    void parse(InferenceEngine::InferRequest& request, Object& object) const {
+        for (const std::string& output : outputNames) {
+            InferenceEngine::Blob::Ptr blob = request.GetBlob(output);
+            const float* data = blob->buffer().as<float*>();
+            const std::size_t size = blob->size();
+            const std::size_t classId = static_cast<std::size_t>(std::max_element(data, data + size) - data);
+            const std::vector<std::string>& names = classNames.at(output);
+            object.attributes[output] = classId < names.size() ? names[classId] : std::to_string(classId);
+        }
+    }
+
+    std::vector<int> roiLabels;
+    std::map<std::string, std::vector<std::string>> classNames;
+    std::deque<std::shared_ptr<Job>> jobs;
+    std::mutex jobsMutex;
+};
+
+/**
+ * @class IouTrackerStage
+ * @brief Assigns track ids to the objects of every source by greedy matching of the boxes of the previous frame
+ * with the same label. Parameters: iou_threshold (0.5 by default), max_age - number of frames a lost track
+ * is kept (10 by default). The input edge is expected to be ordered.
+ */
+class IouTrackerStage : public Stage {
+public:
+    explicit IouTrackerStage(const cv::FileNode& config) :
+        iouThreshold(static_cast<float>(readDouble(config, "iou_threshold", 0.5))),
+        maxAge(readInt(config, "max_age", 10)), nextTrackId(0) {}
+
+    void process(Packet::Ptr packet, Emit emit) override {
+        std::vector<Track>& tracks = sourceTracks[packet->sourceId];
+        std::vector<bool> matched(tracks.size(), false);
+        for (Object& object : packet->objects) {
+            float bestIou = iouThreshold;
+            std::size_t best = tracks.size();
+            for (std::size_t i = 0; i < tracks.size(); ++i) {
+                if (matched[i] || tracks[i].label != object.label) {
+                    continue;
+                }
+                const float intersection = static_cast<float>((tracks[i].rect & object.rect).area());
+                const float iou = intersection / (tracks[i].rect.area() + object.rect.area() - intersection);
+                if (iou > bestIou) {
+                    bestIou = iou;
+                    best = i;
+                }
+            }
+            if (tracks.size() == best) {  // a new track is appended at the best index
+                tracks.push_back({nextTrackId++, object.label, object.rect, 0});
+                matched.push_back(true);
+            } else {
+                matched[best] = true;
+                tracks[best].rect = object.rect;
+                tracks[best].age = 0;
+            }
+            object.trackId = tracks[best].id;
+        }
+        for (std::size_t i = 0; i < tracks.size(); ++i) {
+            if (!matched[i]) {
+                tracks[i].age++;
+            }
+        }
+        tracks.erase(std::remove_if(tracks.begin(), tracks.end(), [this](const Track& track) {
+            return track.age > maxAge;
+        }), tracks.end());
+        emit(packet);
+    }
+
+private:
+    struct Track {
+        int id;
+        int label;
+        cv::Rect rect;
+        int age;
+    };
+
+    const float iouThreshold;
+    const int maxAge;
+    int nextTrackId;
+    std::map<std::size_t, std::vector<Track>> sourceTracks;
+};
+
+/**
+ * @class DisplayStage
+ * @brief Draws the objects with their track ids and attributes and shows the frames of every source in its window.
+ * Esc or Q stops the graph. Parameters: window (the stage name by default).
+ */
+class DisplayStage : public Stage {
+public:
+    explicit DisplayStage(const cv::FileNode& config) :
+        window(readString(config, "window", readString(config, "name"))) {}
+
+    void process(Packet::Ptr packet, Emit emit) override {
+        cv::Mat frame = packet->frame.clone();
+        for (const Object& object : packet->objects) {
+            cv::rectangle(frame, object.rect, cv::Scalar(0, 255, 0), 2);
+            std::string text = object.trackId >= 0 ? '#' + std::to_string(object.trackId) : std::to_string(object.label);
+            for (const auto& attribute : object.attributes) {
+                text += ' ' + attribute.second;
+            }
+            cv::putText(frame, text, object.rect.tl() + cv::Point(0, -5), cv::FONT_HERSHEY_COMPLEX_SMALL, 1,
+                        cv::Scalar(0, 0, 255));
+        }
+        cv::imshow(window + (0 == packet->sourceId ? "" : ' ' + std::to_string(packet->sourceId)), frame);
+        const int key = cv::waitKey(1);
+        if (27 == key || 'q' == key || 'Q' == key) {
+            hooks.stop();
+        }
+        emit(packet);
+    }
+
+private:
+    const std::string window;
+};
+
+/**
+ * @brief Adds the built-in stages to the factory: video, detector, classifier, iou_tracker, display and null,
+ * which only counts the packets
+ * @param defaultInput input of the video sources without their own input
+ * @param modelsDir directory the relative model paths are resolved against
+ */
+inline void addBuiltinStages(StageFactory& factory, InferenceEngine::Core& ie, const std::string& defaultInput,
+                             const std::string& modelsDir) {
+    factory.add("video", [defaultInput](const cv::FileNode& config) {
+        return std::unique_ptr<Stage>(new VideoSource(config, defaultInput));
+    });
+    factory.add("detector", [&ie, modelsDir](const cv::FileNode& config) {
+        return std::unique_ptr<Stage>(new DetectorStage(config, ie, modelsDir));
+    });
+    factory.add("classifier", [&ie, modelsDir](const cv::FileNode& config) {
+        return std::unique_ptr<Stage>(new ClassifierStage(config, ie, modelsDir));
+    });
+    factory.add("iou_tracker", [](const cv::FileNode& config) {
+        return std::unique_ptr<Stage>(new IouTrackerStage(config));
+    });
+    factory.add("display", [](const cv::FileNode& config) {
+        return std::unique_ptr<Stage>(new DisplayStage(config));
+    });
+    factory.add("null", [](const cv::FileNode&) {
+        return std::unique_ptr<Stage>(new Stage);
+    });
+}
+
+}  // namespace pipeline
@@ -0,0 +1,288 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with batching of variable-size images into a small set of network input shapes
+ * @file shape_buckets.hpp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <inference_engine.hpp>
+#include <opencv2/opencv.hpp>
+
+/**
+ * @brief Defines how an image is placed into the input of a bucket
+ */
+enum class PaddingPolicy {
+    /// The image keeps its resolution and is padded with zeros at the right and the bottom
+    PAD,
+    /// The image is stretched to the bucket size
+    RESIZE,
+    /// The image is scaled keeping its aspect ratio and padded with zeros at the right and the bottom
+    LETTERBOX
+};
+
+inline PaddingPolicy paddingPolicyFromString(const std::string& policy) {
+    if (policy == "pad") return PaddingPolicy::PAD;
+    if (policy == "resize") return PaddingPolicy::RESIZE;
+    if (policy == "letterbox") return PaddingPolicy::LETTERBOX;
+    throw std::logic_error("Unknown padding policy \"" + policy + "\", expected pad, resize or letterbox");
+}
+
+/**
+ * @brief Chooses at most maxBuckets input shapes covering the given image sizes.
+ * The sizes are aligned up to the alignment and collected into a histogram, the histogram entries
+ * ordered by area are split into contiguous groups minimizing the total number of padded pixels.
+ * Each bucket is the smallest shape containing all images of its group.
+ */
+inline std::vector<cv::Size> chooseBuckets(const std::vector<cv::Size>& sizes, size_t maxBuckets, int alignment = 1) {
+    if (sizes.empty() || 0 == maxBuckets) {
+        return {};
+    }
+    alignment = std::max(alignment, 1);
+    std::map<std::pair<int, int>, size_t> histogram;
+    for (const auto& size : sizes) {
+        int width = (size.width + alignment - 1) / alignment * alignment;
+        int height = (size.height + alignment - 1) / alignment * alignment;
+        ++histogram[{width, height}];
+    }
+    std::vector<std::pair<cv::Size, size_t>> entries;
+    for (const auto& item : histogram) {
+        entries.emplace_back(cv::Size(item.first.first, item.first.second), item.second);
+    }
+    std::sort(entries.begin(), entries.end(), [](const std::pair<cv::Size, size_t>& a,
+                                                 const std::pair<cv::Size, size_t>& b) {
+        return a.first.area() < b.first.area()
+               || (a.first.area() == b.first.area() && a.first.width < b.first.width);
+    });
+
+    const size_t n = entries.size();
+    const size_t k = std::min(maxBuckets, n);
+    // padding[i][j] is the number of padded pixels if the entries [i, j] share a bucket
+    std::vector<std::vector<double>> padding(n, std::vector<double>(n, 0.));
+    for (size_t i = 0; i < n; i++) {
+        int width = 0, height = 0;
+        double count = 0., area = 0.;
+        for (size_t j = i; j < n; j++) {
+            width = std::max(width, entries[j].first.width);
+            height = std::max(height, entries[j].first.height);
+            count += entries[j].second;
+            area += static_cast<double>(entries[j].second) * entries[j].first.area();
+            padding[i][j] = count * width * height - area;
+        }
+    }
+    // cost[b][j] is the minimal padding of the first j entries split into b buckets
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<double>> cost(k + 1, std::vector<double>(n + 1, inf));
+    std::vector<std::vector<size_t>> split(k + 1, std::vector<size_t>(n + 1, 0));
+    cost[0][0] = 0.;
+    for (size_t b = 1; b <= k; b++) {
+        for (size_t j = b; j <= n; j++) {
+            for (size_t i = b - 1; i < j; i++) {
+                double value = cost[b - 1][i] + padding[i][j - 1];
+                if (value < cost[b][j]) {
+                    cost[b][j] = value;
+                    split[b][j] = i;
+                }
+            }
+        }
+    }
+
+    std::vector<cv::Size> buckets;
+    for (size_t b = k, j = n; b > 0; j = split[b][j], b--) {
+        cv::Size bucket;
+        for (size_t i = split[b][j]; i < j; i++) {
+            bucket.width = std::max(bucket.width, entries[i].first.width);
+            bucket.height = std::max(bucket.height, entries[i].first.height);
+        }
+        buckets.push_back(bucket);
+    }
+    std::reverse(buckets.begin(), buckets.end());
+    return buckets;
+}
+
+/**
+ * @class ShapeBucketedBatcher
+ * @brief Keeps a network compiled for every bucket shape and groups pushed images by bucket.
+ * A bucket is inferred as soon as it collects a full batch, flush() infers the incomplete ones
+ * with the unused batch slots filled with zeros.
+ */
+class ShapeBucketedBatcher {
+public:
+    struct Placement {
+        /// @brief id of the image passed to push()
+        size_t id;
+        /// @brief batch slot of the image in the infer request
+        size_t slot;
+        /// @brief size of the network input of the bucket
+        cv::Size bucket;
+        /// @brief region of the network input holding the image
+        cv::Rect roi;
+    };
+
+    /// @brief Fills the inputs of a batch slot with the image placed into the bucket
+    using FillCallback = std::function<void(InferenceEngine::InferRequest& request, size_t slot, const cv::Mat& input)>;
+    /// @brief Processes the outputs of a batch slot
+    using ResultCallback = std::function<void(InferenceEngine::InferRequest& request, const Placement& placement)>;
+
+    /**
+     * @brief Reshapes the network to every bucket and loads it to the device. The spatial dimensions of
+     * all 4D inputs are scaled by the ratio of the bucket to the current size of the first input.
+     */
+    ShapeBucketedBatcher(InferenceEngine::Core& ie, InferenceEngine::CNNNetwork& network, const std::string& device,
+                         const std::vector<cv::Size>& buckets, size_t batchSize, PaddingPolicy policy,
+                         FillCallback fill, ResultCallback onResult,
+                         const std::map<std::string, std::string>& config = {}) :
+        batchSize(batchSize), policy(policy), fill(fill), onResult(onResult),
+        realPixels(0), dispatchedPixels(0) {
+        if (buckets.empty()) {
+            throw std::logic_error("At least one shape bucket is required");
+        }
+        if (0 == batchSize) {
+            throw std::logic_error("Batch size of shape buckets can not be zero");
+        }
+        InferenceEngine::ICNNNetwork::InputShapes originalShapes = network.getInputShapes();
+        const InferenceEngine::SizeVector& primary = originalShapes.at(network.getInputsInfo().begin()->first);
+        if (primary.size() != 4) {
+            throw std::logic_error("Shape buckets support only networks with NCHW first input");
+        }
+        for (const auto& size : buckets) {
+            InferenceEngine::ICNNNetwork::InputShapes shapes = originalShapes;
+            for (auto& shape : shapes) {
+                shape.second[0] = batchSize;
+                if (shape.second.size() == 4) {
+                    shape.second[2] = shape.second[2] * size.height / primary[2];
+                    shape.second[3] = shape.second[3] * size.width / primary[3];
+                }
+            }
+            // The network is compiled right after the reshape, as copies of CNNNetwork share the same topology
+            network.reshape(shapes);
+            Bucket bucket;
+            bucket.size = size;
+            bucket.network = ie.LoadNetwork(network, device, config);
+            bucket.request = bucket.network.CreateInferRequest();
+            bucket.batches = 0;
+            this->buckets.push_back(std::move(bucket));
+        }
+        network.reshape(originalShapes);
+    }
+
+    /**
+     * @brief Adds an image to the smallest bucket containing it, the images not fitting any bucket
+     * are scaled down into the largest one
+     */
+    void push(size_t id, const cv::Mat& image) {
+        Bucket& bucket = buckets[bucketFor(image.size())];
+        cv::Rect roi = placement(image.size(), bucket.size);
+        cv::Mat input = cv::Mat::zeros(bucket.size, image.type());
+        if (roi.size() == image.size()) {
+            image.copyTo(input(roi));
+        } else {
+            cv::resize(image, input(roi), roi.size());
+        }
+        fill(bucket.request, bucket.pending.size(), input);
+        bucket.pending.push_back({id, bucket.pending.size(), bucket.size, roi});
+        realPixels += static_cast<size_t>(roi.area());
+        if (bucket.pending.size() == batchSize) {
+            dispatch(bucket);
+        }
+    }
+
+    /**
+     * @brief Infers all buckets holding pending images
+     */
+    void flush() {
+        for (auto& bucket : buckets) {
+            if (!bucket.pending.empty()) {
+                cv::Mat empty = cv::Mat::zeros(bucket.size, CV_8UC3);
+                for (size_t slot = bucket.pending.size(); slot < batchSize; slot++) {
+                    fill(bucket.request, slot, empty);
+                }
+                dispatch(bucket);
+            }
+        }
+    }
+
+    /**
+     * @brief Formats the buckets with the numbers of inferred batches and the share of the inferred pixels
+     * belonging to the images
+     */
+    std::string report() const {
+        std::ostringstream report;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            report << (0 == i ? "" : ", ") << buckets[i].size.width << "x" << buckets[i].size.height
+                   << ": " << buckets[i].batches << " batches";
+        }
+        report << "; useful pixels: "
+               << (0 == dispatchedPixels ? 0 : static_cast<int>(100. * realPixels / dispatchedPixels + 0.5)) << "%";
+        return report.str();
+    }
+
+private:
+    struct Bucket {
+        cv::Size size;
+        InferenceEngine::ExecutableNetwork network;
+        InferenceEngine::InferRequest request;
+        std::vector<Placement> pending;
+        size_t batches;
+    };
+
+    size_t bucketFor(const cv::Size& size) const {
+        size_t best = buckets.size();
+        size_t largest = 0;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            const cv::Size& bucket = buckets[i].size;
+            if (bucket.width >= size.width && bucket.height >= size.height
+                && (best == buckets.size() || bucket.area() < buckets[best].size.area())) {
+                best = i;
+            }
+            if (bucket.area() > buckets[largest].size.area()) {
+                largest = i;
+            }
+        }
+        return best == buckets.size() ? largest : best;
+    }
+
+    cv::Rect placement(const cv::Size& image, const cv::Size& bucket) const {
+        if (PaddingPolicy::RESIZE == policy) {
+            return cv::Rect(cv::Point(), bucket);
+        }
+        if (PaddingPolicy::PAD == policy && image.width <= bucket.width && image.height <= bucket.height) {
+            return cv::Rect(cv::Point(), image);
+        }
+        double scale = std::min(static_cast<double>(bucket.width) / image.width,
+                                static_cast<double>(bucket.height) / image.height);
+        return cv::Rect(0, 0, std::max(1, std::min(bucket.width, static_cast<int>(image.width * scale + 0.5))),
+                        std::max(1, std::min(bucket.height, static_cast<int>(image.height * scale + 0.5))));
+    }
+
+    void dispatch(Bucket& bucket) {
+        bucket.request.Infer();
+        ++bucket.batches;
+        dispatchedPixels += static_cast<size_t>(bucket.size.area()) * batchSize;
+        for (const auto& placement : bucket.pending) {
+            onResult(bucket.request, placement);
+        }
+        bucket.pending.clear();
+    }
+
+    const size_t batchSize;
+    const PaddingPolicy policy;
+    FillCallback fill;
+    ResultCallback onResult;
+    std::vector<Bucket> buckets;
+    size_t realPixels;
+    size_t dispatchedPixels;
+};
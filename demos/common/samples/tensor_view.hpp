@@ -0,0 +1,167 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with a typed strided view of blob memory for reading network outputs in place
+ * @file tensor_view.hpp
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <inference_engine.hpp>
+
+/**
+ * @brief Maps an element type of a tensor view to the blob precision it can view
+ */
+template <typename T> struct TensorViewPrecision;
+template <> struct TensorViewPrecision<float> {
+    static InferenceEngine::Precision::ePrecision value() { return InferenceEngine::Precision::FP32; }
+};
+template <> struct TensorViewPrecision<int32_t> {
+    static InferenceEngine::Precision::ePrecision value() { return InferenceEngine::Precision::I32; }
+};
+template <> struct TensorViewPrecision<int16_t> {
+    static InferenceEngine::Precision::ePrecision value() { return InferenceEngine::Precision::I16; }
+};
+template <> struct TensorViewPrecision<uint16_t> {
+    static InferenceEngine::Precision::ePrecision value() { return InferenceEngine::Precision::U16; }
+};
+template <> struct TensorViewPrecision<int8_t> {
+    static InferenceEngine::Precision::ePrecision value() { return InferenceEngine::Precision::I8; }
+};
+template <> struct TensorViewPrecision<uint8_t> {
+    static InferenceEngine::Precision::ePrecision value() { return InferenceEngine::Precision::U8; }
+};
+
+/**
+ * @class TensorView
+ * @brief Typed view of the memory of a blob with its logical shape, element strides and layout.
+ * Indices are given in the logical order of the dimensions, i.e. N, C, H, W for both NCHW and NHWC blobs,
+ * the strides take care of the memory order. The view does not own the memory, so it is valid while
+ * the blob is alive and its content is the result of the last inference until the next one starts.
+ * @tparam T element type, const for read-only views
+ */
+template <typename T>
+class TensorView {
+public:
+    TensorView() : data_(nullptr), layout_(InferenceEngine::Layout::ANY) {}
+
+    TensorView(T* data, const InferenceEngine::SizeVector& dims, const InferenceEngine::SizeVector& strides,
+               InferenceEngine::Layout layout) : data_(data), dims_(dims), strides_(strides), layout_(layout) {
+        if (dims_.size() != strides_.size()) {
+            throw std::logic_error("Tensor view dimensions and strides have different ranks");
+        }
+    }
+
+    /**
+     * @brief Views the memory of a blob, the blob precision has to match the element type
+     */
+    explicit TensorView(const InferenceEngine::Blob::Ptr& blob) : TensorView() {
+        if (nullptr == blob) {
+            throw std::logic_error("Cannot create a tensor view of an empty blob");
+        }
+        const InferenceEngine::TensorDesc& desc = blob->getTensorDesc();
+        if (!(desc.getPrecision() == TensorViewPrecision<typename std::remove_const<T>::type>::value())) {
+            throw std::logic_error(std::string("Cannot view a blob of precision ") + desc.getPrecision().name()
+                                   + " as a tensor of another element type");
+        }
+        const InferenceEngine::BlockingDesc& blocking = desc.getBlockingDesc();
+        const InferenceEngine::SizeVector& order = blocking.getOrder();
+        dims_ = desc.getDims();
+        if (order.size() != dims_.size()) {
+            throw std::logic_error("Tensor views of blocked layouts are not supported");
+        }
+        strides_.resize(dims_.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            strides_[order[i]] = blocking.getStrides()[i];
+        }
+        layout_ = desc.getLayout();
+        data_ = blob->buffer().as<T*>() + blocking.getOffsetPadding();
+    }
+
+    T* data() const { return data_; }
+    const InferenceEngine::SizeVector& dims() const { return dims_; }
+    const InferenceEngine::SizeVector& strides() const { return strides_; }
+    InferenceEngine::Layout layout() const { return layout_; }
+
+    size_t rank() const { return dims_.size(); }
+    size_t dim(size_t axis) const { return dims_.at(axis); }
+
+    /** @brief Number of elements */
+    size_t size() const {
+        size_t size = 1;
+        for (size_t dim : dims_) {
+            size *= dim;
+        }
+        return size;
+    }
+
+    bool empty() const { return nullptr == data_ || 0 == size(); }
+
+    /** @brief Whether the elements are stored in the logical order without gaps */
+    bool isDense() const {
+        size_t stride = 1;
+        for (size_t i = dims_.size(); i > 0; i--) {
+            if (dims_[i - 1] != 1 && strides_[i - 1] != stride) {
+                return false;
+            }
+            stride *= dims_[i - 1];
+        }
+        return true;
+    }
+
+    /**
+     * @brief Element at the given leading indices, the omitted trailing indices are zeros
+     */
+    template <typename... Indices>
+    T& operator()(Indices... indices) const {
+        const size_t index[] = {0, static_cast<size_t>(indices)...};
+        size_t offset = 0;
+        for (size_t i = 0; i < sizeof...(indices); i++) {
+            offset += index[i + 1] * strides_[i];
+        }
+        return data_[offset];
+    }
+
+    /**
+     * @brief View of one slice along the first dimension, for example of one image of a batch
+     */
+    TensorView operator[](size_t index) const {
+        return TensorView(data_ + index * strides_.at(0),
+                          InferenceEngine::SizeVector(dims_.begin() + 1, dims_.end()),
+                          InferenceEngine::SizeVector(strides_.begin() + 1, strides_.end()),
+                          InferenceEngine::Layout::ANY);
+    }
+
+    /**
+     * @brief Iterators over the elements in the logical order, only dense views can be iterated
+     */
+    T* begin() const {
+        if (!isDense()) {
+            throw std::logic_error("Only dense tensor views can be iterated");
+        }
+        return data_;
+    }
+    T* end() const { return begin() + size(); }
+
+private:
+    T* data_;
+    InferenceEngine::SizeVector dims_;
+    InferenceEngine::SizeVector strides_;
+    InferenceEngine::Layout layout_;
+};
+
+/**
+ * @brief Creates a tensor view of the memory of a blob, the blob precision has to match the element type
+ */
+template <typename T>
+TensorView<T> tensorView(const InferenceEngine::Blob::Ptr& blob) {
+    return TensorView<T>(blob);
+}
@@ -0,0 +1,405 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+ * @brief a header file with a process-wide CPU thread budget shared by the demo pipeline stages
+ * @file thread_budget.hpp
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <inference_engine.hpp>
+#include <ie_plugin_config.hpp>
+#include <opencv2/core/core.hpp>
+
+#include <samples/slog.hpp>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+/**
+ * @class ThreadBudget
+ * @brief Splits the CPU cores of the machine between the pipeline stages, so that OpenCV,
+ * TBB arenas, demo thread pools and the inference plugin do not each size themselves to the
+ * full core count. CPU time of threads attached to a partition and of scopes charged to it
+ * is accounted in the utilization report, the CPU time of the rest of the process
+ * (inference plugin threads, OpenCV pool) is reported as inference.
+ */
+class ThreadBudget {
+public:
+    enum Partition {
+        CAPTURE = 0,
+        PREPROCESSING,
+        INFERENCE,
+        POSTPROCESSING,
+        PARTITIONS_NUMBER
+    };
+
+    struct Utilization {
+        unsigned threads;
+        /// @brief CPU time spent by the partition divided by the wall time of the budgeted cores
+        double load;
+    };
+
+    /**
+     * @brief Parses a budget specification in the "capture:2,preprocessing:4,inference:16,postprocessing:2"
+     * format. Each partition not listed gets one thread, except for inference, which gets all remaining cores.
+     * @param spec budget specification, may be empty
+     * @param totalThreads number of cores to split, 0 means the number of hardware threads
+     */
+    explicit ThreadBudget(const std::string& spec = "", unsigned totalThreads = 0) :
+        total(0 == totalThreads ? std::max(std::thread::hardware_concurrency(), 1u) : totalThreads),
+        streams(1),
+        lastWallTime(std::chrono::steady_clock::now()),
+        lastProcessTime(processCpuTime()) {
+        threadsNum.fill(0);
+        charged.fill(0.);
+        std::array<bool, PARTITIONS_NUMBER> specified;
+        specified.fill(false);
+
+        std::stringstream ss(spec);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (item.empty()) {
+                continue;
+            }
+            auto pos = item.find(':');
+            if (pos == std::string::npos) {
+                throw std::logic_error("Incorrect thread budget entry \"" + item + "\", expected <partition>:<threads>");
+            }
+            Partition partition = fromName(item.substr(0, pos));
+            const std::string value = item.substr(pos + 1);
+            // the length limit keeps stoi from overflowing
+            if (value.empty() || std::strspn(value.c_str(), "0123456789") != value.length() || value.length() > 6) {
+                throw std::logic_error("Incorrect number of threads in thread budget entry \"" + item
+                                       + "\" of \"" + spec + "\"");
+            }
+            int threads = std::stoi(value);
+            if (threads <= 0) {
+                throw std::logic_error("Number of threads for " + item.substr(0, pos) + " partition must be positive");
+            }
+            threadsNum[partition] = static_cast<unsigned>(threads);
+            specified[partition] = true;
+        }
+
+        unsigned used = 0;
+        for (int p = 0; p < PARTITIONS_NUMBER; p++) {
+            if (!specified[p] && INFERENCE != p) {
+                threadsNum[p] = 1;
+            }
+            used += threadsNum[p];
+        }
+        if (!specified[INFERENCE]) {
+            threadsNum[INFERENCE] = total > used ? total - used : 1;
+            used += threadsNum[INFERENCE];
+        }
+        if (used > total) {
+            slog::warn << "Thread budget " << toString() << " exceeds " << total
+                       << " available cores, the cores are oversubscribed" << slog::endl;
+        }
+    }
+
+    ThreadBudget(const ThreadBudget&) = delete;
+    ThreadBudget& operator=(const ThreadBudget&) = delete;
+
+    unsigned threads(Partition partition) const {
+        return threadsNum[partition];
+    }
+
+    /**
+     * @brief Sets the number of inference streams the inference threads are split into,
+     * the value is clamped to the number of inference threads
+     */
+    void setInferenceStreams(unsigned streamsNum) {
+        streams = std::max(1u, std::min(streamsNum, threadsNum[INFERENCE]));
+    }
+
+    unsigned inferenceStreams() const {
+        return streams;
+    }
+
+    /**
+     * @brief Sizes the OpenCV thread pool. The pool is global and serves both preprocessing
+     * and postprocessing, so it gets the threads of both partitions.
+     */
+    void configureOpenCV() const {
+        cv::setNumThreads(static_cast<int>(threadsNum[PREPROCESSING] + threadsNum[POSTPROCESSING]));
+    }
+
+    /**
+     * @brief Configures the number of threads and throughput streams of the CPU plugin.
+     * Every network loaded to the plugin creates its own thread pool of the configured size,
+     * so the inference threads are split between the networks the demo loads to the CPU.
+     * @param networksNum number of networks loaded to the CPU plugin of the Core
+     */
+    void configurePlugin(InferenceEngine::Core& ie, unsigned networksNum = 1) const {
+        const unsigned networkThreads = std::max(1u, threadsNum[INFERENCE] / std::max(1u, networksNum));
+        const unsigned networkStreams = std::min(streams, networkThreads);
+        ie.SetConfig({{InferenceEngine::PluginConfigParams::KEY_CPU_THREADS_NUM, std::to_string(networkThreads)},
+                      {InferenceEngine::PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS, std::to_string(networkStreams)}}, "CPU");
+    }
+
+    /**
+     * @brief Accounts the CPU time of the calling thread to the given partition.
+     * Calling it again from an attached thread has no effect. The thread must detach before it exits,
+     * ids of exited threads are reused, so prefer ScopedAttachment.
+     * @return true if the thread was not attached before the call
+     */
+    bool attachCurrentThread(Partition partition) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto id = std::this_thread::get_id();
+        if (attached.find(id) != attached.end()) {
+            return false;
+        }
+        AttachedThread thread;
+        thread.partition = partition;
+#ifdef _WIN32
+        DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &thread.handle,
+                        THREAD_QUERY_LIMITED_INFORMATION, FALSE, 0);
+#else
+        pthread_getcpuclockid(pthread_self(), &thread.clock);
+#endif
+        thread.lastTime = thread.cpuTime();
+        attached.emplace(id, thread);
+        return true;
+    }
+
+    /**
+     * @brief Stops accounting the calling thread, its CPU time since the last report is charged
+     * to its partition. Detaching a thread which is not attached has no effect.
+     */
+    void detachCurrentThread() {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = attached.find(std::this_thread::get_id());
+        if (it == attached.end()) {
+            return;
+        }
+        AttachedThread& thread = it->second;
+        charged[thread.partition] += std::max(0., thread.cpuTime() - thread.lastTime);
+#ifdef _WIN32
+        CloseHandle(thread.handle);
+#endif
+        attached.erase(it);
+    }
+
+    /**
+     * @brief Attaches the calling thread to the partition for the lifetime of the object.
+     * The budget may be null, then the object does nothing.
+     */
+    class ScopedAttachment {
+    public:
+        ScopedAttachment(ThreadBudget* budget, Partition partition) :
+            budget(nullptr != budget && budget->attachCurrentThread(partition) ? budget : nullptr) {}
+
+        ScopedAttachment(const ScopedAttachment&) = delete;
+        ScopedAttachment& operator=(const ScopedAttachment&) = delete;
+
+        ~ScopedAttachment() {
+            if (nullptr != budget) {
+                budget->detachCurrentThread();
+            }
+        }
+
+    private:
+        ThreadBudget* const budget;  // null if the thread was attached by someone else
+    };
+
+    /**
+     * @brief Accounts the CPU time the calling thread spends in its scope to the given partition.
+     * It is meant for thread pools which run tasks of several partitions, such threads must not be attached.
+     */
+    class ScopedCharge {
+    public:
+        ScopedCharge(ThreadBudget& budget, Partition partition) :
+            budget(budget), partition(partition), start(currentThreadCpuTime()) {}
+
+        ~ScopedCharge() {
+            double time = currentThreadCpuTime() - start;
+            std::lock_guard<std::mutex> lock(budget.mutex);
+            budget.charged[partition] += std::max(0., time);
+        }
+
+    private:
+        ThreadBudget& budget;
+        const Partition partition;
+        const double start;
+    };
+
+    /**
+     * @brief Returns utilization of every partition since the previous call
+     */
+    std::vector<Utilization> utilization() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::array<double, PARTITIONS_NUMBER> cpuTime = charged;
+        double accountedTime = 0.;
+        for (double time : charged) {
+            accountedTime += time;
+        }
+        charged.fill(0.);
+        for (auto& item : attached) {
+            AttachedThread& thread = item.second;
+            double time = thread.cpuTime();
+            if (time < thread.lastTime) {  // the thread has exited, its clock is not available anymore
+                time = thread.lastTime;
+            }
+            cpuTime[thread.partition] += time - thread.lastTime;
+            accountedTime += time - thread.lastTime;
+            thread.lastTime = time;
+        }
+        double processTime = processCpuTime();
+        cpuTime[INFERENCE] += std::max(0., processTime - lastProcessTime - accountedTime);
+        lastProcessTime = processTime;
+
+        auto now = std::chrono::steady_clock::now();
+        double wallTime = std::chrono::duration<double>(now - lastWallTime).count();
+        lastWallTime = now;
+
+        std::vector<Utilization> result(PARTITIONS_NUMBER);
+        for (int p = 0; p < PARTITIONS_NUMBER; p++) {
+            result[p].threads = threadsNum[p];
+            result[p].load = wallTime > 0. ? cpuTime[p] / (wallTime * threadsNum[p]) : 0.;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Formats the output of utilization() as "capture: 35% of 2 threads, ..."
+     */
+    std::string utilizationReport() {
+        std::ostringstream report;
+        auto usage = utilization();
+        for (int p = 0; p < PARTITIONS_NUMBER; p++) {
+            report << (0 == p ? "" : ", ") << partitionName(static_cast<Partition>(p)) << ": "
+                   << static_cast<int>(usage[p].load * 100. + 0.5) << "% of " << usage[p].threads << " threads";
+        }
+        return report.str();
+    }
+
+    std::string toString() const {
+        std::ostringstream budget;
+        for (int p = 0; p < PARTITIONS_NUMBER; p++) {
+            budget << (0 == p ? "" : ",") << partitionName(static_cast<Partition>(p)) << ":" << threadsNum[p];
+        }
+        return budget.str();
+    }
+
+    static const char* partitionName(Partition partition) {
+        static const char* names[PARTITIONS_NUMBER] = {"capture", "preprocessing", "inference", "postprocessing"};
+        return names[partition];
+    }
+
+    ~ThreadBudget() {
+#ifdef _WIN32
+        for (auto& item : attached) {
+            CloseHandle(item.second.handle);
+        }
+#endif
+    }
+
+private:
+    struct AttachedThread {
+        Partition partition;
+#ifdef _WIN32
+        HANDLE handle;
+#else
+        clockid_t clock;
+#endif
+        double lastTime;
+
+        double cpuTime() const {
+#ifdef _WIN32
+            FILETIME creation, exit, kernel, user;
+            if (!GetThreadTimes(handle, &creation, &exit, &kernel, &user)) {
+                return 0.;
+            }
+            return fileTimeToSeconds(kernel) + fileTimeToSeconds(user);
+#else
+            timespec time;
+            if (0 != clock_gettime(clock, &time)) {
+                return 0.;
+            }
+            return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+        }
+    };
+
+    static Partition fromName(const std::string& name) {
+        for (int p = 0; p < PARTITIONS_NUMBER; p++) {
+            if (name == partitionName(static_cast<Partition>(p))) {
+                return static_cast<Partition>(p);
+            }
+        }
+        throw std::logic_error("Unknown thread budget partition \"" + name + "\"");
+    }
+
+#ifdef _WIN32
+    static double fileTimeToSeconds(const FILETIME& time) {
+        ULARGE_INTEGER value;
+        value.LowPart = time.dwLowDateTime;
+        value.HighPart = time.dwHighDateTime;
+        return value.QuadPart * 1e-7;
+    }
+#endif
+
+    static double currentThreadCpuTime() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+            return 0.;
+        }
+        return fileTimeToSeconds(kernel) + fileTimeToSeconds(user);
+#else
+        timespec time;
+        if (0 != clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time)) {
+            return 0.;
+        }
+        return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+    }
+
+    static double processCpuTime() {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+            return 0.;
+        }
+        return fileTimeToSeconds(kernel) + fileTimeToSeconds(user);
+#else
+        timespec time;
+        if (0 != clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time)) {
+            return 0.;
+        }
+        return time.tv_sec + time.tv_nsec * 1e-9;
+#endif
+    }
+
+    const unsigned total;
+    std::array<unsigned, PARTITIONS_NUMBER> threadsNum;
+    unsigned streams;
+
+    std::mutex mutex;
+    std::map<std::thread::id, AttachedThread> attached;
+    std::array<double, PARTITIONS_NUMBER> charged;
+    std::chrono::steady_clock::time_point lastWallTime;
+    double lastProcessTime;
+};
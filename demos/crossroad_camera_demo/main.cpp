@@ -25,6 +25,8 @@
 
 #include <samples/slog.hpp>
 #include <samples/ocv_common.hpp>
+#include <samples/memory_usage.hpp>
+#include <samples/tensor_view.hpp>
 #include "crossroad_camera_demo.hpp"
 #include <ext_list.hpp>
 
@@ -219,22 +221,22 @@ struct PersonDetection : BaseDetection{
         results.clear();
         if (resultsFetched) return;
         resultsFetched = true;
-        const float *detections = request.GetBlob(outputName)->buffer().as<float *>();
+        const TensorView<const float> detections = tensorView<const float>(request.GetBlob(outputName));
         // pretty much regular SSD post-processing
         for (int i = 0; i < maxProposalCount; i++) {
-            float image_id = detections[i * objectSize + 0];  // in case of batch
+            float image_id = detections(0, 0, i, 0);  // in case of batch
             if (image_id < 0) {  // indicates end of detections
                 break;
             }
 
             Result r;
-            r.label = static_cast<int>(detections[i * objectSize + 1]);
-            r.confidence = detections[i * objectSize + 2];
+            r.label = static_cast<int>(detections(0, 0, i, 1));
+            r.confidence = detections(0, 0, i, 2);
 
-            r.location.x = static_cast<int>(detections[i * objectSize + 3] * width);
-            r.location.y = static_cast<int>(detections[i * objectSize + 4] * height);
-            r.location.width = static_cast<int>(detections[i * objectSize + 5] * width - r.location.x);
-            r.location.height = static_cast<int>(detections[i * objectSize + 6] * height - r.location.y);
+            r.location.x = static_cast<int>(detections(0, 0, i, 3) * width);
+            r.location.y = static_cast<int>(detections(0, 0, i, 4) * height);
+            r.location.width = static_cast<int>(detections(0, 0, i, 5) * width - r.location.x);
+            r.location.height = static_cast<int>(detections(0, 0, i, 6) * height - r.location.y);
 
             if (FLAGS_r) {
                 std::cout << "[" << i << "," << r.label << "] element, prob = " << r.confidence <<
@@ -299,12 +301,14 @@ struct PersonAttribsDetection : BaseDetection {
                 "is male", "has_bag", "has_backpack" , "has hat", "has longsleeves", "has longpants", "has longhair", "has coat_jacket"
         };
 
-        Blob::Ptr attribsBlob = request.GetBlob(outputNameForAttributes);
-        Blob::Ptr topColorPointBlob = request.GetBlob(outputNameForTopColorPoint);
-        Blob::Ptr bottomColorPointBlob = request.GetBlob(outputNameForBottomColorPoint);
-        size_t numOfAttrChannels = attribsBlob->getTensorDesc().getDims().at(1);
-        size_t numOfTCPointChannels = topColorPointBlob->getTensorDesc().getDims().at(1);
-        size_t numOfBCPointChannels = bottomColorPointBlob->getTensorDesc().getDims().at(1);
+        const TensorView<const float> outputAttrValues = tensorView<const float>(request.GetBlob(outputNameForAttributes));
+        const TensorView<const float> outputTCPointValues =
+            tensorView<const float>(request.GetBlob(outputNameForTopColorPoint));
+        const TensorView<const float> outputBCPointValues =
+            tensorView<const float>(request.GetBlob(outputNameForBottomColorPoint));
+        size_t numOfAttrChannels = outputAttrValues.dim(1);
+        size_t numOfTCPointChannels = outputTCPointValues.dim(1);
+        size_t numOfBCPointChannels = outputBCPointValues.dim(1);
 
         if (numOfAttrChannels != attributesVec.size()) {
             throw std::logic_error("Output size (" + std::to_string(numOfAttrChannels) + ") of the "
@@ -320,21 +324,18 @@ struct PersonAttribsDetection : BaseDetection {
                                    "Person Attributes Recognition network is not equal to point coordinates (2)");
         }
 
-        auto outputAttrValues = attribsBlob->buffer().as<float*>();
-        auto outputTCPointValues = topColorPointBlob->buffer().as<float*>();
-        auto outputBCPointValues = bottomColorPointBlob->buffer().as<float*>();
-
         AttributesAndColorPoints returnValue;
 
-        returnValue.top_color_point.x = outputTCPointValues[0];
-        returnValue.top_color_point.y = outputTCPointValues[1];
+        returnValue.top_color_point.x = outputTCPointValues(0, 0);
+        returnValue.top_color_point.y = outputTCPointValues(0, 1);
 
-        returnValue.bottom_color_point.x = outputBCPointValues[0];
-        returnValue.bottom_color_point.y = outputBCPointValues[1];
+        returnValue.bottom_color_point.x = outputBCPointValues(0, 0);
+        returnValue.bottom_color_point.y = outputBCPointValues(0, 1);
 
+        returnValue.attributes_strings = attributesVec;
+        returnValue.attributes_indicators.resize(attributesVec.size());
         for (size_t i = 0; i < attributesVec.size(); i++) {
-            returnValue.attributes_strings.push_back(attributesVec[i]);
-            returnValue.attributes_indicators.push_back(outputAttrValues[i] > 0.5);
+            returnValue.attributes_indicators[i] = outputAttrValues(0, i) > 0.5;
         }
 
         return returnValue;
@@ -414,17 +415,17 @@ struct PersonReIdentification : BaseDetection {
     }
 
     std::vector<float> getReidVec() {
-        Blob::Ptr attribsBlob = request.GetBlob(outputName);
+        const TensorView<const float> outputValues = tensorView<const float>(request.GetBlob(outputName));
 
-        auto numOfChannels = attribsBlob->getTensorDesc().getDims().at(1);
+        auto numOfChannels = outputValues.dim(1);
         /* output descriptor of Person Reidentification Recognition network has size 256 */
         if (numOfChannels != 256) {
             throw std::logic_error("Output size (" + std::to_string(numOfChannels) + ") of the "
                                    "Person Reidentification network is not equal to 256");
         }
 
-        auto outputValues = attribsBlob->buffer().as<float*>();
-        return std::vector<float>(outputValues, outputValues + 256);
+        // The vector is kept in globalReIdVec, so it is copied out of the blob
+        return std::vector<float>(outputValues.begin(), outputValues.end());
     }
 
     template <typename T>
@@ -500,6 +501,7 @@ struct Load {
 
     void into(Core & ie, const std::string & deviceName) const {
         if (detector.enabled()) {
+            ModelMemoryReport memoryReport(detector.commandLineFlag);
             detector.net = ie.LoadNetwork(detector.read(), deviceName);
         }
     }
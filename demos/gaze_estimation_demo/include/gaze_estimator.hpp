@@ -28,6 +28,6 @@ private:
     IEWrapper ieWrapper;
     bool rollAlign;
     cv::Rect createEyeBoundingBox(const cv::Point2i& p1, const cv::Point2i& p2, float scale = 1.8) const;
-    void rotateImageAroundCenter(const cv::Mat& srcImage, cv::Mat& dstImage, float angle) const;
+    cv::Matx23d rotationAroundCenter(const cv::Size& size, float angle) const;
 };
 }  // namespace gaze_estimation
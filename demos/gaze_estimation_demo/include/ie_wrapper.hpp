@@ -19,6 +19,8 @@
 #include <samples/ocv_common.hpp>
 #include <samples/slog.hpp>
 #include <samples/common.hpp>
+#include <samples/memory_usage.hpp>
+#include <samples/tensor_view.hpp>
 
 namespace gaze_estimation {
 class IEWrapper {
@@ -28,13 +30,17 @@ public:
               const std::string& deviceName);
     // For setting input blobs containing images
     void setInputBlob(const std::string& blobName, const cv::Mat& image);
+    // For setting input blobs containing warped images, the transform maps pixel coordinates of the warped image
+    // to pixel coordinates of the image, both of the image size. The border pixels are replicated.
+    void setInputBlob(const std::string& blobName, const cv::Mat& image, const cv::Matx23d& transform);
     // For setting input blobs containing vectors of data
     void setInputBlob(const std::string& blobName, const std::vector<float>& data);
 
-    // Get output blob content as a vector given its name (if there are more than one output blob)
-    void getOutputBlob(const std::string& blobName, std::vector<float>& output);
-    // Get output blob content as a vector (if there is only one output blob)
-    void getOutputBlob(std::vector<float>& output);
+    // Get a view of the output blob content given its name (if there are more than one output blob).
+    // The view reads the blob in place, so it is valid until the next inference
+    TensorView<const float> getOutput(const std::string& blobName);
+    // Get a view of the output blob content (if there is only one output blob)
+    TensorView<const float> getOutput();
 
     void printPerlayerPerformance() const;
 
@@ -49,13 +55,13 @@ private:
     std::string modelPath;
     std::string deviceName;
     InferenceEngine::Core& ie;
-    InferenceEngine::CNNNetReader netReader;
-    InferenceEngine::CNNNetwork network;
     InferenceEngine::ExecutableNetwork executableNetwork;
     InferenceEngine::InferRequest request;
     std::map<std::string, std::vector<unsigned long>> inputBlobsDimsInfo;
     std::map<std::string, std::vector<unsigned long>> outputBlobsDimsInfo;
 
-    void setExecPart();
+    // The parsed network is not kept after loading, it is read again on reshape
+    InferenceEngine::CNNNetwork readNetwork() const;
+    void setExecPart(InferenceEngine::CNNNetwork& network);
 };
 }  // namespace gaze_estimation
@@ -68,12 +68,9 @@ std::vector<FaceInferenceResults> FaceDetector::detect(const cv::Mat& image) {
     ieWrapper.setInputBlob(inputBlobName, image);
     ieWrapper.infer();
 
-    std::vector<float> rawDetectionResults;
-    ieWrapper.getOutputBlob(rawDetectionResults);
-    auto outputBlobDims = ieWrapper.getOutputBlobDimsInfo().begin()->second;
+    auto rawDetectionResults = ieWrapper.getOutput();
 
-    auto nTotalDetections = outputBlobDims[2];
-    auto nInfoFields = outputBlobDims[3];
+    auto nTotalDetections = rawDetectionResults.dim(2);
 
     FaceInferenceResults tmp;
 
@@ -81,15 +78,15 @@ std::vector<FaceInferenceResults> FaceDetector::detect(const cv::Mat& image) {
     cv::Rect imageRect(0, 0, image.cols, image.rows);
 
     for (unsigned long detectionID = 0; detectionID < nTotalDetections; ++detectionID) {
-        float confidence = rawDetectionResults[detectionID * nInfoFields + 2];
+        float confidence = rawDetectionResults(0, 0, detectionID, 2);
         if (static_cast<double>(confidence) < detectionThreshold) {
             break;
         }
 
-        auto x = rawDetectionResults[detectionID * nInfoFields + 3] * imageSize.width;
-        auto width = rawDetectionResults[detectionID * nInfoFields + 5] * imageSize.width - x;
-        auto y = rawDetectionResults[detectionID * nInfoFields + 4] * imageSize.height;
-        auto height = rawDetectionResults[detectionID * nInfoFields + 6] * imageSize.height - y;
+        auto x = rawDetectionResults(0, 0, detectionID, 3) * imageSize.width;
+        auto width = rawDetectionResults(0, 0, detectionID, 5) * imageSize.width - x;
+        auto y = rawDetectionResults(0, 0, detectionID, 4) * imageSize.height;
+        auto height = rawDetectionResults(0, 0, detectionID, 6) * imageSize.height - y;
 
         cv::Rect faceRect(static_cast<int>(x), static_cast<int>(y),
                           static_cast<int>(width), static_cast<int>(height));
@@ -33,18 +33,14 @@ cv::Rect GazeEstimator::createEyeBoundingBox(const cv::Point2i& p1,
     return result;
 }
 
-void GazeEstimator::rotateImageAroundCenter(const cv::Mat& srcImage,
-                                              cv::Mat& dstImage,
-                                              float angle) const {
-    auto w = srcImage.cols;
-    auto h = srcImage.rows;
-
-    cv::Size size(w, h);
-
-    cv::Point2f center(static_cast<float>(w / 2), static_cast<float>(h / 2));
+cv::Matx23d GazeEstimator::rotationAroundCenter(const cv::Size& size, float angle) const {
+    cv::Point2f center(static_cast<float>(size.width / 2), static_cast<float>(size.height / 2));
 
+    // The inverse rotation maps pixels of the rotated image to pixels of the source one
     auto rotMatrix = cv::getRotationMatrix2D(center, static_cast<double>(angle), 1);
-    cv::warpAffine(srcImage, dstImage, rotMatrix, size, 1, cv::BORDER_REPLICATE);
+    cv::Matx23d inverse;
+    cv::invertAffineTransform(rotMatrix, inverse);
+    return inverse;
 }
 
 
@@ -74,28 +70,25 @@ void GazeEstimator::estimate(const cv::Mat& image,
     cv::Mat rightEyeImage(image, rightEyeBoundingBox);
 
     if (rollAlign) {
+        // The eyes are rotated and scaled to the input size in one pass
         headPoseAngles[2] = 0;
-        cv::Mat leftEyeImageRotated, rightEyeImageRotated;
-        rotateImageAroundCenter(leftEyeImage, leftEyeImageRotated, roll);
-        rotateImageAroundCenter(rightEyeImage, rightEyeImageRotated, roll);
-        leftEyeImage = leftEyeImageRotated;
-        rightEyeImage = rightEyeImageRotated;
+        ieWrapper.setInputBlob("left_eye_image", leftEyeImage, rotationAroundCenter(leftEyeImage.size(), roll));
+        ieWrapper.setInputBlob("right_eye_image", rightEyeImage, rotationAroundCenter(rightEyeImage.size(), roll));
+    } else {
+        ieWrapper.setInputBlob("left_eye_image", leftEyeImage);
+        ieWrapper.setInputBlob("right_eye_image", rightEyeImage);
     }
 
     ieWrapper.setInputBlob("head_pose_angles", headPoseAngles);
-    ieWrapper.setInputBlob("left_eye_image", leftEyeImage);
-    ieWrapper.setInputBlob("right_eye_image", rightEyeImage);
 
     ieWrapper.infer();
 
-    std::vector<float> rawResults;
-
-    ieWrapper.getOutputBlob(rawResults);
+    auto rawResults = ieWrapper.getOutput();
 
     cv::Point3f gazeVector;
-    gazeVector.x = rawResults[0];
-    gazeVector.y = rawResults[1];
-    gazeVector.z = rawResults[2];
+    gazeVector.x = rawResults(0, 0);
+    gazeVector.y = rawResults(0, 1);
+    gazeVector.z = rawResults(0, 2);
 
     gazeVector = gazeVector / cv::norm(gazeVector);
 
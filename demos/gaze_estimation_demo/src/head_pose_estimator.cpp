@@ -23,15 +23,9 @@ void HeadPoseEstimator::estimate(const cv::Mat& image,
 
     ieWrapper.setInputBlob(inputBlobName, faceCrop);
     ieWrapper.infer();
-    std::vector<float> y, p, r;
-
-    ieWrapper.getOutputBlob("angle_y_fc", y);
-    ieWrapper.getOutputBlob("angle_p_fc", p);
-    ieWrapper.getOutputBlob("angle_r_fc", r);
-
-    outputResults.headPoseAngles.x = y[0];
-    outputResults.headPoseAngles.y = p[0];
-    outputResults.headPoseAngles.z = r[0];
+    outputResults.headPoseAngles.x = ieWrapper.getOutput("angle_y_fc")(0, 0);
+    outputResults.headPoseAngles.y = ieWrapper.getOutput("angle_p_fc")(0, 0);
+    outputResults.headPoseAngles.z = ieWrapper.getOutput("angle_r_fc")(0, 0);
 }
 
 void HeadPoseEstimator::printPerformanceCounts() const {
@@ -16,14 +16,20 @@ IEWrapper::IEWrapper(InferenceEngine::Core& ie,
                      const std::string& modelPath,
                      const std::string& deviceName):
            modelPath(modelPath), deviceName(deviceName), ie(ie) {
+    ModelMemoryReport memoryReport(modelPath);
+    auto network = readNetwork();
+    setExecPart(network);
+}
+
+CNNNetwork IEWrapper::readNetwork() const {
+    CNNNetReader netReader;
     netReader.ReadNetwork(modelPath);
     std::string binFileName = fileNameNoExt(modelPath) + ".bin";
     netReader.ReadWeights(binFileName);
-    network = netReader.getNetwork();
-    setExecPart();
+    return netReader.getNetwork();
 }
 
-void IEWrapper::setExecPart() {
+void IEWrapper::setExecPart(CNNNetwork& network) {
     // set map of input blob name -- blob dimension pairs
     auto inputInfo = network.getInputsInfo();
     for (auto inputBlobsIt = inputInfo.begin(); inputBlobsIt != inputInfo.end(); ++inputBlobsIt) {
@@ -77,6 +83,21 @@ void IEWrapper::setInputBlob(const std::string& blobName,
     matU8ToBlob<PrecisionTrait<Precision::U8>::value_type>(resizedImage, inputBlob);
 }
 
+void IEWrapper::setInputBlob(const std::string& blobName,
+                             const cv::Mat& image,
+                             const cv::Matx23d& transform) {
+    auto blobDims = inputBlobsDimsInfo[blobName];
+
+    if (blobDims.size() != 4) {
+        throw std::runtime_error("Input data does not match size of the blob");
+    }
+
+    auto scaledSize = cv::Size(static_cast<int>(blobDims[3]), static_cast<int>(blobDims[2]));
+    auto inputBlob = request.GetBlob(blobName);
+    warpAffineToBlob<PrecisionTrait<Precision::U8>::value_type>(
+        image, composeAffine(resizeAffine(image.size(), scaledSize), transform), inputBlob, 0, cv::BORDER_REPLICATE);
+}
+
 void IEWrapper::setInputBlob(const std::string& blobName,
                              const std::vector<float>& data) {
     auto blobDims = inputBlobsDimsInfo[blobName];
@@ -94,36 +115,12 @@ void IEWrapper::setInputBlob(const std::string& blobName,
     }
 }
 
-void IEWrapper::getOutputBlob(const std::string& blobName,
-                              std::vector<float> &output) {
-    output.clear();
-    auto blobDims = outputBlobsDimsInfo[blobName];
-    auto dataSize = 1;
-    for (auto dim : blobDims) {
-        dataSize *= dim;
-    }
-    auto outputBlob = request.GetBlob(blobName);
-    auto buffer = outputBlob->buffer().as<InferenceEngine::PrecisionTrait<InferenceEngine::Precision::FP32>::value_type *>();
-
-    for (int i = 0; i < dataSize; ++i) {
-        output.push_back(buffer[i]);
-    }
+TensorView<const float> IEWrapper::getOutput(const std::string& blobName) {
+    return tensorView<const float>(request.GetBlob(blobName));
 }
 
-void IEWrapper::getOutputBlob(std::vector<float>& output) {
-    output.clear();
-    auto blobName = outputBlobsDimsInfo.begin()->first;
-    auto blobDims = outputBlobsDimsInfo[blobName];
-    auto dataSize = 1;
-    for (auto const& dim : blobDims) {
-        dataSize *= dim;
-    }
-    auto outputBlob = request.GetBlob(blobName);
-    auto buffer = outputBlob->buffer().as<InferenceEngine::PrecisionTrait<InferenceEngine::Precision::FP32>::value_type *>();
-
-    for (int i = 0; i < dataSize; ++i) {
-        output.push_back(buffer[i]);
-    }
+TensorView<const float> IEWrapper::getOutput() {
+    return getOutput(outputBlobsDimsInfo.begin()->first);
 }
 
 const std::map<std::string, std::vector<unsigned long>>& IEWrapper::getIputBlobDimsInfo() const {
@@ -142,6 +139,7 @@ void IEWrapper::reshape(const std::map<std::string, std::vector<unsigned long> >
         throw std::runtime_error("Mismatch in the number of blobs being reshaped");
     }
 
+    auto network = readNetwork();
     auto inputShapes = network.getInputShapes();
     for (auto it = newBlobsDimsInfo.begin(); it != newBlobsDimsInfo.end(); ++it) {
         auto blobName = it->first;
@@ -151,7 +149,7 @@ void IEWrapper::reshape(const std::map<std::string, std::vector<unsigned long> >
         inputShapes[blobName] = blobDims_;
     }
     network.reshape(inputShapes);
-    setExecPart();
+    setExecPart(network);
 }
 
 void IEWrapper::printPerlayerPerformance() const {
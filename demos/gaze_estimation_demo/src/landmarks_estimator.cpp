@@ -23,11 +23,10 @@ void LandmarksEstimator::estimate(const cv::Mat& image,
 
     ieWrapper.setInputBlob(inputBlobName, faceCrop);
     ieWrapper.infer();
-    std::vector<float> rawLandmarks;
+    auto landmarks = ieWrapper.getOutput();
+    const float* rawLandmarks = landmarks.begin();
 
-    ieWrapper.getOutputBlob(rawLandmarks);
-
-    for (unsigned long i = 0; i < rawLandmarks.size() / 2; ++i) {
+    for (unsigned long i = 0; i < landmarks.size() / 2; ++i) {
         int x = static_cast<int>(rawLandmarks[2 * i] * faceCrop.cols + faceBoundingBox.tl().x);
         int y = static_cast<int>(rawLandmarks[2 * i + 1] * faceCrop.rows + faceBoundingBox.tl().y);
         outputResults.faceLandmarks.push_back(cv::Point2i(x, y));
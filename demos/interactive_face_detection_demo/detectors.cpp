@@ -778,6 +778,8 @@ void Load::into(InferenceEngine::Core & ie, const std::string & deviceName, bool
             config[PluginConfigParams::KEY_DYN_BATCH_ENABLED] = PluginConfigParams::YES;
         }
 
+        // The network returned by read() is released right after loading, before the memory is reported
+        ModelMemoryReport memoryReport(detector.pathToModel);
         detector.net = ie.LoadNetwork(detector.read(), deviceName, config);
     }
 }
@@ -21,6 +21,7 @@
 #include <inference_engine.hpp>
 
 #include <samples/common.hpp>
+#include <samples/memory_usage.hpp>
 #include <samples/slog.hpp>
 
 #include <ie_iextension.h>
@@ -0,0 +1,303 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "blob_replay.hpp"
+
+namespace {
+
+const char fileMagic[4] = {'I', 'E', 'R', 'B'};
+const std::uint32_t fileVersion = 1;
+
+template <typename T>
+void writePod(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readPod(std::istream& is) {
+    T value;
+    if (!is.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("Unexpected end of blob replay file");
+    }
+    return value;
+}
+
+void writeString(std::ostream& os, const std::string& str) {
+    writePod(os, static_cast<std::uint32_t>(str.size()));
+    os.write(str.data(), str.size());
+}
+
+std::string readString(std::istream& is) {
+    std::string str(readPod<std::uint32_t>(is), '\0');
+    if (!is.read(&str[0], str.size())) {
+        throw std::runtime_error("Unexpected end of blob replay file");
+    }
+    return str;
+}
+
+void writeTensorDesc(std::ostream& os, const InferenceEngine::TensorDesc& desc) {
+    writePod(os, static_cast<std::uint32_t>(static_cast<InferenceEngine::Precision::ePrecision>(desc.getPrecision())));
+    writePod(os, static_cast<std::uint32_t>(desc.getLayout()));
+    writePod(os, static_cast<std::uint32_t>(desc.getDims().size()));
+    for (auto dim : desc.getDims()) {
+        writePod(os, static_cast<std::uint64_t>(dim));
+    }
+}
+
+InferenceEngine::TensorDesc readTensorDesc(std::istream& is) {
+    auto precision = static_cast<InferenceEngine::Precision::ePrecision>(readPod<std::uint32_t>(is));
+    auto layout = static_cast<InferenceEngine::Layout>(readPod<std::uint32_t>(is));
+    InferenceEngine::SizeVector dims(readPod<std::uint32_t>(is));
+    for (auto& dim : dims) {
+        dim = static_cast<std::size_t>(readPod<std::uint64_t>(is));
+    }
+    return InferenceEngine::TensorDesc(InferenceEngine::Precision(precision), dims, layout);
+}
+
+InferenceEngine::Blob::Ptr makeBlob(const InferenceEngine::TensorDesc& desc) {
+    InferenceEngine::Blob::Ptr blob;
+    switch (desc.getPrecision()) {
+    case InferenceEngine::Precision::FP32:
+        blob = InferenceEngine::make_shared_blob<float>(desc);
+        break;
+    case InferenceEngine::Precision::FP16:
+    case InferenceEngine::Precision::Q78:
+    case InferenceEngine::Precision::I16:
+        blob = InferenceEngine::make_shared_blob<int16_t>(desc);
+        break;
+    case InferenceEngine::Precision::U16:
+        blob = InferenceEngine::make_shared_blob<uint16_t>(desc);
+        break;
+    case InferenceEngine::Precision::I32:
+        blob = InferenceEngine::make_shared_blob<int32_t>(desc);
+        break;
+    case InferenceEngine::Precision::I8:
+        blob = InferenceEngine::make_shared_blob<int8_t>(desc);
+        break;
+    case InferenceEngine::Precision::U8:
+        blob = InferenceEngine::make_shared_blob<uint8_t>(desc);
+        break;
+    default:
+        throw std::logic_error("Unsupported blob precision in blob replay file");
+    }
+    blob->allocate();
+    return blob;
+}
+
+InferenceEngine::StatusCode setResponse(InferenceEngine::ResponseDesc* resp,
+                                        InferenceEngine::StatusCode code,
+                                        const char* msg) {
+    if (nullptr != resp) {
+        std::snprintf(resp->msg, sizeof(resp->msg), "%s", msg);
+    }
+    return code;
+}
+
+class ReplayInferRequest : public InferenceEngine::IInferRequest {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ReplayInferRequest(std::shared_ptr<BlobReplayer> replayer, std::chrono::microseconds latency):
+        replayer(std::move(replayer)), latency(latency) {
+        inputBlob = makeBlob(this->replayer->getInputDesc());
+    }
+
+    void Release() noexcept override {
+        delete this;
+    }
+
+    InferenceEngine::StatusCode SetBlob(const char* name, const InferenceEngine::Blob::Ptr& data,
+                                        InferenceEngine::ResponseDesc* resp) noexcept override {
+        if (replayer->getInputName() != name) {
+            return setResponse(resp, InferenceEngine::NOT_FOUND, "Only the input blob can be set on a replayed request");
+        }
+        inputBlob = data;
+        return InferenceEngine::OK;
+    }
+
+    InferenceEngine::StatusCode GetBlob(const char* name, InferenceEngine::Blob::Ptr& data,
+                                        InferenceEngine::ResponseDesc* resp) noexcept override {
+        if (replayer->getInputName() == name) {
+            data = inputBlob;
+            return InferenceEngine::OK;
+        }
+        if (nullptr == record) {
+            return setResponse(resp, InferenceEngine::INFER_NOT_STARTED, "Replayed request was not started");
+        }
+        const auto& names = replayer->getOutputNames();
+        for (size_t i = 0; i < names.size(); i++) {
+            if (names[i] == name) {
+                data = record->outputs[i];
+                return InferenceEngine::OK;
+            }
+        }
+        return setResponse(resp, InferenceEngine::NOT_FOUND, "Blob is not found in the replay file");
+    }
+
+    InferenceEngine::StatusCode Infer(InferenceEngine::ResponseDesc* resp) noexcept override {
+        auto status = StartAsync(resp);
+        if (InferenceEngine::OK != status) {
+            return status;
+        }
+        return Wait(InferenceEngine::IInferRequest::WaitMode::RESULT_READY, resp);
+    }
+
+    InferenceEngine::StatusCode GetPerformanceCounts(
+            std::map<std::string, InferenceEngine::InferenceEngineProfileInfo>& perfMap,
+            InferenceEngine::ResponseDesc*) const noexcept override {
+        perfMap.clear();
+        return InferenceEngine::OK;
+    }
+
+    InferenceEngine::StatusCode Wait(int64_t millis_timeout, InferenceEngine::ResponseDesc* resp) noexcept override {
+        if (nullptr == record) {
+            return setResponse(resp, InferenceEngine::INFER_NOT_STARTED, "Replayed request was not started");
+        }
+        if (millis_timeout == InferenceEngine::IInferRequest::WaitMode::RESULT_READY) {
+            std::this_thread::sleep_until(readyTime);
+        } else if (millis_timeout > 0) {
+            std::this_thread::sleep_until(std::min(readyTime, Clock::now() + std::chrono::milliseconds(millis_timeout)));
+        }
+        return Clock::now() >= readyTime ? InferenceEngine::OK : InferenceEngine::RESULT_NOT_READY;
+    }
+
+    InferenceEngine::StatusCode StartAsync(InferenceEngine::ResponseDesc* resp) noexcept override {
+        try {
+            record = &replayer->next();
+        } catch (const std::exception& e) {
+            return setResponse(resp, InferenceEngine::GENERAL_ERROR, e.what());
+        }
+        readyTime = Clock::now() + latency;
+        return InferenceEngine::OK;
+    }
+
+    InferenceEngine::StatusCode SetCompletionCallback(CompletionCallback) noexcept override {
+        return InferenceEngine::NOT_IMPLEMENTED;
+    }
+
+    InferenceEngine::StatusCode GetUserData(void** data, InferenceEngine::ResponseDesc*) noexcept override {
+        if (nullptr != data) {
+            *data = userData;
+        }
+        return InferenceEngine::OK;
+    }
+
+    InferenceEngine::StatusCode SetUserData(void* data, InferenceEngine::ResponseDesc*) noexcept override {
+        userData = data;
+        return InferenceEngine::OK;
+    }
+
+    InferenceEngine::StatusCode SetBatch(int, InferenceEngine::ResponseDesc* resp) noexcept override {
+        return setResponse(resp, InferenceEngine::NOT_IMPLEMENTED, "Batch of a replayed request is fixed by the recording");
+    }
+
+private:
+    std::shared_ptr<BlobReplayer> replayer;
+    std::chrono::microseconds latency;
+    InferenceEngine::Blob::Ptr inputBlob;
+    const BlobReplayer::Record* record = nullptr;
+    Clock::time_point readyTime;
+    void* userData = nullptr;
+};
+
+}  // namespace
+
+BlobRecorder::BlobRecorder(const std::string& path,
+                           const std::string& inputName,
+                           const InferenceEngine::TensorDesc& inputDesc,
+                           const std::vector<std::string>& outputNames):
+    file(path, std::ios::binary), outputNames(outputNames) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open blob record file: " + path);
+    }
+    file.write(fileMagic, sizeof(fileMagic));
+    writePod(file, fileVersion);
+    writeString(file, inputName);
+    writeTensorDesc(file, inputDesc);
+    writePod(file, static_cast<std::uint32_t>(outputNames.size()));
+    for (const auto& name : outputNames) {
+        writeString(file, name);
+    }
+}
+
+void BlobRecorder::write(std::uint64_t seqNo,
+                         const std::vector<std::size_t>& sourceIds,
+                         InferenceEngine::InferRequest& req) {
+    std::unique_lock<std::mutex> lock(mtx);
+    writePod(file, seqNo);
+    writePod(file, static_cast<std::uint32_t>(sourceIds.size()));
+    for (auto id : sourceIds) {
+        writePod(file, static_cast<std::uint64_t>(id));
+    }
+    for (const auto& name : outputNames) {
+        auto blob = req.GetBlob(name);
+        writeTensorDesc(file, blob->getTensorDesc());
+        writePod(file, static_cast<std::uint64_t>(blob->byteSize()));
+        file.write(blob->cbuffer().as<const char*>(), blob->byteSize());
+    }
+    if (!file) {
+        throw std::runtime_error("Failed to write blob record file");
+    }
+}
+
+BlobReplayer::BlobReplayer(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open blob replay file: " + path);
+    }
+    char magic[sizeof(fileMagic)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || 0 != std::memcmp(magic, fileMagic, sizeof(fileMagic)) ||
+        readPod<std::uint32_t>(file) != fileVersion) {
+        throw std::runtime_error("Unsupported blob replay file format: " + path);
+    }
+    inputName = readString(file);
+    inputDesc = readTensorDesc(file);
+    outputNames.resize(readPod<std::uint32_t>(file));
+    for (auto& name : outputNames) {
+        name = readString(file);
+    }
+
+    while (file.peek() != std::char_traits<char>::eof()) {
+        Record record;
+        record.seqNo = readPod<std::uint64_t>(file);
+        record.sourceIds.resize(readPod<std::uint32_t>(file));
+        for (auto& id : record.sourceIds) {
+            id = static_cast<std::size_t>(readPod<std::uint64_t>(file));
+        }
+        for (size_t i = 0; i < outputNames.size(); i++) {
+            auto blob = makeBlob(readTensorDesc(file));
+            auto byteSize = readPod<std::uint64_t>(file);
+            if (byteSize != blob->byteSize() ||
+                !file.read(blob->buffer().as<char*>(), blob->byteSize())) {
+                throw std::runtime_error("Corrupted blob replay file: " + path);
+            }
+            record.outputs.push_back(blob);
+        }
+        records.push_back(std::move(record));
+    }
+    if (records.empty()) {
+        throw std::runtime_error("Blob replay file contains no records: " + path);
+    }
+}
+
+const BlobReplayer::Record& BlobReplayer::next() {
+    return records[cursor++ % records.size()];
+}
+
+InferenceEngine::InferRequest::Ptr BlobReplayer::createInferRequest(std::chrono::microseconds latency) {
+    InferenceEngine::IInferRequest::Ptr request = InferenceEngine::details::shared_from_irelease(
+        new ReplayInferRequest(shared_from_this(), latency));
+    return std::make_shared<InferenceEngine::InferRequest>(request);
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <inference_engine.hpp>
+
+/**
+ * @brief Dumps output blobs of finished infer requests into a compact binary file.
+ *
+ * The file starts with a header (input blob name and descriptor, output blob names)
+ * followed by one record per request: request sequence number, source ids of the
+ * frames in the batch and raw output blobs in header order.
+ */
+class BlobRecorder {
+public:
+    BlobRecorder(const std::string& path,
+                 const std::string& inputName,
+                 const InferenceEngine::TensorDesc& inputDesc,
+                 const std::vector<std::string>& outputNames);
+
+    void write(std::uint64_t seqNo,
+               const std::vector<std::size_t>& sourceIds,
+               InferenceEngine::InferRequest& req);
+
+private:
+    std::ofstream file;
+    std::vector<std::string> outputNames;
+    std::mutex mtx;
+};
+
+/**
+ * @brief Serves output blobs recorded by BlobRecorder through the regular
+ * InferRequest interface, so that everything around inference can be run
+ * deterministically without a model or a device.
+ */
+class BlobReplayer : public std::enable_shared_from_this<BlobReplayer> {
+public:
+    struct Record {
+        std::uint64_t seqNo = 0;
+        std::vector<std::size_t> sourceIds;
+        std::vector<InferenceEngine::Blob::Ptr> outputs;
+    };
+
+    explicit BlobReplayer(const std::string& path);
+
+    const std::string& getInputName() const { return inputName; }
+    const InferenceEngine::TensorDesc& getInputDesc() const { return inputDesc; }
+    const std::vector<std::string>& getOutputNames() const { return outputNames; }
+    std::size_t size() const { return records.size(); }
+
+    /// Returns recorded requests in file order, wrapping around at the end
+    const Record& next();
+
+    /// Creates a request which returns the next record on every inference
+    /// after the specified latency has passed
+    InferenceEngine::InferRequest::Ptr createInferRequest(std::chrono::microseconds latency);
+
+private:
+    std::string inputName;
+    InferenceEngine::TensorDesc inputDesc;
+    std::vector<std::string> outputNames;
+    std::vector<Record> records;
+    std::atomic<std::size_t> cursor = {0};
+};
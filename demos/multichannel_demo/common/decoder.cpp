@@ -892,6 +892,53 @@ Decoder::Decoder(const Settings& s):
 Decoder::~Decoder() {
 }
 
+Decoder::Stream::Stream(unsigned maxInFlight):
+    maxInFlight(std::max(maxInFlight, 1u)) {}
+
+std::uint64_t Decoder::Stream::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    windowCondVar.wait(lock, [&]() {
+        return nextSeqNo - nextToDeliver < maxInFlight;
+    });
+    return nextSeqNo++;
+}
+
+bool Decoder::Stream::tryAcquire(std::uint64_t* seqNo) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (nextSeqNo - nextToDeliver >= maxInFlight) {
+        return false;
+    }
+    *seqNo = nextSeqNo++;
+    return true;
+}
+
+void Decoder::Stream::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    windowCondVar.wait(lock, [&]() {
+        return nextSeqNo == nextToDeliver;
+    });
+}
+
+void Decoder::Stream::complete(std::uint64_t seqNo, cv::Mat&& img, callback_t&& callback) {
+    std::unique_lock<std::mutex> lock(mutex);
+    decoded.emplace(seqNo, std::make_pair(std::move(img), std::move(callback)));
+    if (delivering) {
+        // The thread which is delivering frames now will also deliver this one when its turn comes
+        return;
+    }
+    delivering = true;
+    while (!decoded.empty() && decoded.begin()->first == nextToDeliver) {
+        auto frame = std::move(decoded.begin()->second);
+        decoded.erase(decoded.begin());
+        lock.unlock();
+        frame.second(std::move(frame.first));
+        lock.lock();
+        ++nextToDeliver;
+        windowCondVar.notify_all();
+    }
+    delivering = false;
+}
+
 Decoder::Stats Decoder::getStats() const {
 #ifdef USE_LIBVA
     if (nullptr != hw_context) {
@@ -5,8 +5,13 @@
 #pragma once
 
 #include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
 
@@ -42,6 +47,97 @@ public:
 
     Stats getStats() const;
 
+    /**
+     * @brief Decoding state of a single video stream. Frames of a stream are numbered
+     * in submission order, decoded in parallel by the async and hardware decoders and
+     * delivered to their callbacks strictly in that order. The number of frames
+     * submitted but not delivered yet is bounded by the stream window.
+     */
+    class Stream final {
+    public:
+        explicit Stream(unsigned maxInFlight);
+        Stream(const Stream&) = delete;
+
+        unsigned getMaxInFlight() const {
+            return maxInFlight;
+        }
+
+        // Blocks until all submitted frames are delivered
+        void wait();
+
+    private:
+        friend class Decoder;
+        using callback_t = std::function<void(cv::Mat&&)>;
+
+        const unsigned maxInFlight;
+        std::mutex mutex;
+        std::condition_variable windowCondVar;
+        std::uint64_t nextSeqNo = 0;
+        std::uint64_t nextToDeliver = 0;
+        bool delivering = false;
+        std::map<std::uint64_t, std::pair<cv::Mat, callback_t>> decoded;
+
+        // Blocks until the window has room and returns the sequence number of the next frame
+        std::uint64_t acquire();
+        // Returns false if the window is full, otherwise stores the sequence number of the next frame
+        bool tryAcquire(std::uint64_t* seqNo);
+        // Stores the decoded frame and delivers all frames which are ready in order
+        void complete(std::uint64_t seqNo, cv::Mat&& img, callback_t&& callback);
+    };
+
+    std::shared_ptr<Stream> createStream(unsigned maxInFlight) {
+        return std::make_shared<Stream>(maxInFlight);
+    }
+
+    /**
+     * @brief Place of a frame in the stream window, the frame must be submitted
+     * with decode() in the order the slots of the stream are acquired.
+     */
+    struct Slot {
+        std::shared_ptr<Stream> stream;
+        std::uint64_t seqNo = 0;
+    };
+
+    /**
+     * @brief Reserves a place for the next frame of the stream, blocks while the stream window is full.
+     * The window is released by delivering frames, so the caller must not hold locks
+     * which submission of frames of other streams takes, e.g. the decode enqueue lock.
+     */
+    Slot acquire(const std::shared_ptr<Stream>& stream) {
+        assert(nullptr != stream);
+        return {stream, stream->acquire()};
+    }
+
+    /**
+     * @brief Reserves a place for the next frame of the stream without waiting.
+     * @return false if the stream window is full, the slot is not changed then
+     */
+    bool tryAcquire(const std::shared_ptr<Stream>& stream, Slot* slot) {
+        assert(nullptr != stream);
+        assert(nullptr != slot);
+        std::uint64_t seqNo = 0;
+        if (!stream->tryAcquire(&seqNo)) {
+            return false;
+        }
+        *slot = {stream, seqNo};
+        return true;
+    }
+
+    /**
+     * @brief Decodes a frame in the acquired slot of its stream, the callback is called
+     * after the callbacks of all frames of the stream in the previous slots.
+     */
+    template<typename F>
+    void decode(Slot&& slot, const void* data, size_t size,
+                unsigned width, unsigned height, F&& callback) {
+        assert(nullptr != slot.stream);
+        OrderedCallback ordered;
+        ordered.stream = std::move(slot.stream);
+        ordered.seqNo = slot.seqNo;
+        ordered.callback = make_copyable(std::forward<F>(callback));
+        decode(data, size, width, height, std::move(ordered));
+    }
+
     template<typename F>
     void decode(const void* data, size_t size, unsigned width, unsigned height,
                 F&& callback) {
@@ -89,8 +185,17 @@ public:
 
 private:
     const Settings settings;
-#ifdef USE_LIBVA
-    struct HwContext;
+
+    struct OrderedCallback {
+        std::shared_ptr<Stream> stream;
+        std::uint64_t seqNo;
+        Stream::callback_t callback;
+
+        void operator()(cv::Mat&& img) {
+            stream->complete(seqNo, std::move(img), std::move(callback));
+        }
+    };
+
     template<typename T>
     struct MoveHack {
         union {
@@ -118,6 +223,9 @@ private:
         return MoveHack<typename std::remove_reference<T>::type>{std::move(val)};
     }
 
+#ifdef USE_LIBVA
+    struct HwContext;
+
     using callback_t = std::function<void(cv::Mat&&)>;
 
     std::unique_ptr<HwContext> hw_context;
@@ -50,6 +50,9 @@ void IEGraph::initNetwork(const std::string& deviceName) {
     if (deviceName.find("CPU") != std::string::npos) {
         ie.AddExtension(std::make_shared<InferenceEngine::Extensions::Cpu::CpuExtensions>(), "CPU");
         ie.SetConfig({{InferenceEngine::PluginConfigParams::KEY_CPU_BIND_THREAD, "NO"}}, "CPU");
+        if (nullptr != threadBudget) {
+            threadBudget->configurePlugin(ie);
+        }
     }
     if (!cpuExtensionPath.empty()) {
         auto extension_ptr = InferenceEngine::make_so_pointer<InferenceEngine::IExtension>(cpuExtensionPath);
@@ -59,7 +62,7 @@ void IEGraph::initNetwork(const std::string& deviceName) {
         ie.SetConfig({{InferenceEngine::PluginConfigParams::KEY_CONFIG_FILE, cldnnConfigPath}}, "GPU");
     }
     /** Setting parameter for collecting per layer metrics **/
-    if (printPerfReport) {
+    if (printPerfReport || nullptr != perfSampler) {
         ie.SetConfig({ { InferenceEngine::PluginConfigParams::KEY_PERF_COUNT, InferenceEngine::PluginConfigParams::YES } });
     }
 
@@ -75,6 +78,7 @@ void IEGraph::initNetwork(const std::string& deviceName) {
         netReader.getNetwork().reshape(inShapes);
     }
 
+    networkName = netReader.getNetwork().getName();
     InferenceEngine::ExecutableNetwork network;
     network = ie.LoadNetwork(netReader.getNetwork(), deviceName);
 
@@ -92,6 +96,7 @@ void IEGraph::initNetwork(const std::string& deviceName) {
 
     for (size_t i = 0; i < maxRequests; ++i) {
         auto req = network.CreateInferRequestPtr();
+        allocateInputsOnHugePages(*req, network.GetInputsInfo());
         availableRequests.push(req);
     }
 
@@ -99,6 +104,46 @@ void IEGraph::initNetwork(const std::string& deviceName) {
     availableRequests.front()->Wait(InferenceEngine::IInferRequest::WaitMode::RESULT_READY);
 }
 
+void IEGraph::initReplay(const std::string& replayPath, std::chrono::microseconds latency) {
+    replayer = std::make_shared<BlobReplayer>(replayPath);
+    slog::info << "Replaying " << replayer->size() << " recorded requests from " << replayPath << slog::endl;
+
+    inputDataBlobName = replayer->getInputName();
+    outputDataBlobNames = replayer->getOutputNames();
+
+    // The frames of a batch are loaded into the replayed input blob and the recorded
+    // results are matched to them, so the recording has to fit the current batch
+    const auto& dims = replayer->getInputDesc().getDims();
+    if (4 != dims.size()) {
+        throw std::logic_error("Replayed input blob " + inputDataBlobName + " has " + std::to_string(dims.size())
+                               + " dimensions, NCHW input is expected");
+    }
+    if (dims[0] != batchSize) {
+        throw std::logic_error("Replayed requests are recorded with batch size " + std::to_string(dims[0])
+                               + ", but batch size " + std::to_string(batchSize) + " is set");
+    }
+    if (3 != dims[1] || 0 == dims[2] || 0 == dims[3]) {
+        throw std::logic_error("Replayed input blob " + inputDataBlobName + " does not hold 3 channel images");
+    }
+    if (!modelPath.empty()) {
+        InferenceEngine::CNNNetReader netReader;
+        netReader.ReadNetwork(modelPath);
+        InferenceEngine::InputsDataMap inputInfo(netReader.getNetwork().getInputsInfo());
+        if (inputInfo.size() != 1) {
+            throw std::logic_error("Face Detection network should have only one input");
+        }
+        const auto& netDims = inputInfo.begin()->second->getTensorDesc().getDims();
+        if (4 != netDims.size() || netDims[2] != dims[2] || netDims[3] != dims[3]) {
+            throw std::logic_error("Replayed input blob " + std::to_string(dims[3]) + "x" + std::to_string(dims[2])
+                                   + " does not match the input of the network " + modelPath);
+        }
+    }
+
+    for (size_t i = 0; i < maxRequests; ++i) {
+        availableRequests.push(replayer->createInferRequest(latency));
+    }
+}
+
 void IEGraph::start(GetterFunc getterFunc, PostprocessingFunc postprocessingFunc) {
     assert(nullptr != getterFunc);
     assert(nullptr != postprocessingFunc);
@@ -106,8 +151,10 @@ void IEGraph::start(GetterFunc getterFunc, PostprocessingFunc postprocessingFunc
     getter = std::move(getterFunc);
     postprocessing = std::move(postprocessingFunc);
     getterThread = std::thread([&]() {
+        ThreadBudget::ScopedAttachment attachment(threadBudget, ThreadBudget::PREPROCESSING);
         std::vector<std::shared_ptr<VideoFrame>> vframes;
         std::vector<cv::Mat> imgsToProc(batchSize);
+        std::uint64_t seqNo = 0;
         while (!terminate) {
             vframes.clear();
             size_t b = 0;
@@ -176,13 +223,13 @@ void IEGraph::start(GetterFunc getterFunc, PostprocessingFunc postprocessingFunc
                 auto startTime = std::chrono::high_resolution_clock::now();
                 req->StartAsync();
                 std::unique_lock<std::mutex> lock(mtxBusyRequests);
-                busyBatchRequests.push({std::move(vframes), std::move(req), startTime});
+                busyBatchRequests.push({std::move(vframes), std::move(req), startTime, seqNo++});
             } else {
                 preprocess();
                 req->StartAsync();
                 std::unique_lock<std::mutex> lock(mtxBusyRequests);
                 busyBatchRequests.push({std::move(vframes), std::move(req),
-                                    std::chrono::high_resolution_clock::time_point()});
+                                    std::chrono::high_resolution_clock::time_point(), seqNo++});
             }
             condVarBusyRequests.notify_one();
         }
@@ -195,11 +242,22 @@ IEGraph::IEGraph(const InitParams& p):
     confidenceThreshold(0.5f), batchSize(p.batchSize),
     modelPath(p.modelPath), weightsPath(p.weightsPath),
     cpuExtensionPath(p.cpuExtPath), cldnnConfigPath(p.cldnnConfigPath),
-    printPerfReport(p.reportPerf), deviceName(p.deviceName),
-    maxRequests(p.maxRequests) {
+    printPerfReport(p.reportPerf && p.replayPath.empty()), deviceName(p.deviceName),
+    maxRequests(p.maxRequests), threadBudget(p.threadBudget),
+    perfSampler(p.replayPath.empty() ? p.perfSampler : nullptr) {
     assert(p.maxRequests > 0);
 
-    initNetwork(p.deviceName);
+    if (p.replayPath.empty()) {
+        initNetwork(p.deviceName);
+    } else {
+        initReplay(p.replayPath, p.replayLatency);
+    }
+
+    if (!p.recordPath.empty()) {
+        auto inputBlob = availableRequests.front()->GetBlob(inputDataBlobName);
+        recorder.reset(new BlobRecorder(p.recordPath, inputDataBlobName,
+                                        inputBlob->getTensorDesc(), outputDataBlobNames));
+    }
 }
 
 InferenceEngine::SizeVector IEGraph::getInputDims() const {
@@ -212,6 +270,7 @@ std::vector<std::shared_ptr<VideoFrame> > IEGraph::getBatchData(cv::Size frameSi
     std::vector<std::shared_ptr<VideoFrame>> vframes;
     InferenceEngine::InferRequest::Ptr req;
     std::chrono::high_resolution_clock::time_point startTime;
+    std::uint64_t seqNo = 0;
     {
         std::unique_lock<std::mutex> lock(mtxBusyRequests);
         condVarBusyRequests.wait(lock, [&]() {
@@ -220,10 +279,21 @@ std::vector<std::shared_ptr<VideoFrame> > IEGraph::getBatchData(cv::Size frameSi
         vframes = std::move(busyBatchRequests.front().vfPtrVec);
         req = std::move(busyBatchRequests.front().req);
         startTime = std::move(busyBatchRequests.front().startTime);
+        seqNo = busyBatchRequests.front().seqNo;
         busyBatchRequests.pop();
     }
 
     if (nullptr != req && InferenceEngine::OK == req->Wait(InferenceEngine::IInferRequest::WaitMode::RESULT_READY)) {
+        if (recorder) {
+            std::vector<std::size_t> sourceIds;
+            for (const auto& vframe : vframes) {
+                sourceIds.push_back(vframe->sourceIdx);
+            }
+            recorder->write(seqNo, sourceIds, *req);
+        }
+        if (nullptr != perfSampler) {
+            perfSampler->onCompleted(*req, networkName);
+        }
         auto detections = postprocessing(req, outputDataBlobNames, frameSize);
         for (decltype(detections.size()) i = 0; i < detections.size(); i ++) {
             vframes[i]->detections = std::move(detections[i]);
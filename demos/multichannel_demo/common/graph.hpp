@@ -24,9 +24,13 @@
 #include <ie_plugin_config.hpp>
 
 #include <samples/common.hpp>
+#include <samples/huge_pages.hpp>
+#include <samples/perf_sampler.hpp>
 #include <samples/slog.hpp>
+#include <samples/thread_budget.hpp>
 #include "perf_timer.hpp"
 #include "input.hpp"
+#include "blob_replay.hpp"
 #include <ext_list.hpp>
 
 void loadImageToIEGraph(cv::Mat img, void* ie_buffer);
@@ -52,6 +56,7 @@ private:
 
     bool printPerfReport;
     std::string deviceName;
+    std::string networkName;
 
     InferenceEngine::Core ie;
     std::queue<InferenceEngine::InferRequest::Ptr> availableRequests;
@@ -60,11 +65,18 @@ private:
         std::vector<std::shared_ptr<VideoFrame>> vfPtrVec;
         InferenceEngine::InferRequest::Ptr req;
         std::chrono::high_resolution_clock::time_point startTime;
+        std::uint64_t seqNo;
     };
     std::queue<BatchRequestDesc> busyBatchRequests;
 
     std::size_t maxRequests = 0;
 
+    ThreadBudget* threadBudget = nullptr;
+    PerfCountersSampler* perfSampler = nullptr;
+
+    std::unique_ptr<BlobRecorder> recorder;
+    std::shared_ptr<BlobReplayer> replayer;
+
     std::atomic_bool terminate = {false};
     std::mutex mtxAvalableRequests;
     std::mutex mtxBusyRequests;
@@ -78,6 +90,7 @@ private:
     std::thread getterThread;
 
     void initNetwork(const std::string& deviceName);
+    void initReplay(const std::string& replayPath, std::chrono::microseconds latency);
 
 public:
     struct InitParams {
@@ -90,6 +103,11 @@ public:
         std::string cpuExtPath;
         std::string cldnnConfigPath;
         std::string deviceName;
+        std::string recordPath;
+        std::string replayPath;
+        std::chrono::microseconds replayLatency{0};
+        ThreadBudget* threadBudget = nullptr;
+        PerfCountersSampler* perfSampler = nullptr;
     };
 
     explicit IEGraph(const InitParams& p);
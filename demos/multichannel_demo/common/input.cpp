@@ -9,6 +9,8 @@
 #include <memory>
 #include <numeric>
 #include <queue>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
@@ -19,6 +21,7 @@
 
 #ifdef USE_NATIVE_CAMERA_API
 #include "multicam/camera.hpp"
+#include "multicam/fake_device.hpp"
 #include "multicam/utils.hpp"
 #endif
 
@@ -42,6 +45,11 @@ public:
 
     virtual float getAvgReadTime() const = 0;
 
+    virtual bool getCaptureStats(VideoSources::CaptureStats& stats) const {
+        (void)stats;
+        return false;
+    }
+
     virtual ~VideoSource();
 };
 
@@ -143,7 +151,7 @@ class VideoSourceStreamFile : public VideoSource {
     VideoStream stream;
 
     std::atomic_bool terminate = {false};
-    std::atomic_bool is_decoding = {false};
+    std::shared_ptr<Decoder::Stream> decodeStream;
 
     std::mutex mutex;
     std::thread workThread;
@@ -167,6 +175,7 @@ public:
                           bool realFps_):
         parent(p),
         stream(name),
+        decodeStream(p.decoder.createStream(static_cast<unsigned>(queueSize_))),
         queueSize(queueSize_),
         perfTimer(collectStats_ ? PerfTimer::DefaultIterationsCount : 0) { }
 
@@ -175,38 +184,41 @@ public:
     void start() {
         terminate = false;
         workThread = std::thread([&]() {
+            ThreadBudget::ScopedAttachment attachment(parent.threadBudget, ThreadBudget::CAPTURE);
             while (!terminate) {
                 {
-                    cv::Mat frame;
-                    {
-                        is_decoding = true;
-                        std::unique_lock<std::mutex> lock(parent.decode_mutex);
-
-                        parent.decoder.decode(stream.frame.ptr, stream.frame.length, stream.frame.width, stream.frame.height,
-                            [this](cv::Mat&& img) mutable {
-                            bool success = !img.empty();
+                    // Frames are decoded in parallel and delivered in order, up to the
+                    // stream window of them can be in flight. Waiting for the window
+                    // must not block enqueueing frames of the other sources.
+                    auto slot = parent.decoder.acquire(decodeStream);
+                    std::unique_lock<std::mutex> lock(parent.decode_mutex);
+
+                    parent.decoder.decode(std::move(slot), stream.frame.ptr, stream.frame.length,
+                                          stream.frame.width, stream.frame.height,
+                        [this](cv::Mat&& img) mutable {
+                        bool success = !img.empty();
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
                             frameQueue.push({success, std::move(img)});
-                            if (perfTimer.enabled()) {
-                                auto prev = lastFrameTime;
-                                auto current = clock::now();
-                                using dur = decltype (prev.time_since_epoch());
-                                if (dur::zero() != prev.time_since_epoch()) {
-                                    perfTimer.addValue(current - prev);
-                                }
-                                lastFrameTime = current;
+                        }
+                        if (perfTimer.enabled()) {
+                            auto prev = lastFrameTime;
+                            auto current = clock::now();
+                            using dur = decltype (prev.time_since_epoch());
+                            if (dur::zero() != prev.time_since_epoch()) {
+                                perfTimer.addValue(current - prev);
                             }
-                            is_decoding = false;
-                            condVar.notify_one();
-                        });
-                        stream.advance_frame();
-                    }
-
-                    std::unique_lock<std::mutex> lock(mutex);
-                    condVar.wait(lock, [&]() {
-                        return !is_decoding && (frameQueue.size() < queueSize || terminate);
+                            lastFrameTime = current;
+                        }
+                        hasFrame.notify_one();
                     });
+                    stream.advance_frame();
                 }
-                hasFrame.notify_one();
+
+                std::unique_lock<std::mutex> lock(mutex);
+                condVar.wait(lock, [&]() {
+                    return frameQueue.size() < queueSize || terminate;
+                });
             }
         });
     }
@@ -217,6 +229,7 @@ public:
         if (workThread.joinable()) {
             workThread.join();
         }
+        decodeStream->wait();
     }
 
     bool read(VideoFrame& frame)  {
@@ -265,6 +278,8 @@ class VideoSourceOCV : public VideoSource {
     const size_t queueSize = 1;
     const size_t pollingTimeMSec = 1000;
 
+    ThreadBudget* threadBudget = nullptr;
+
     template<bool CollectStats>
     bool readFrame(cv::Mat& frame);
 
@@ -276,7 +291,8 @@ class VideoSourceOCV : public VideoSource {
 
 public:
     VideoSourceOCV(bool async, bool collectStats_, const std::string& name,
-                size_t queueSize_, size_t pollingTimeMSec_, bool realFps_);
+                size_t queueSize_, size_t pollingTimeMSec_, bool realFps_,
+                ThreadBudget* threadBudget_ = nullptr);
 
     ~VideoSourceOCV();
 
@@ -312,11 +328,13 @@ class VideoSourceNative : public VideoSource {
     cv::Mat dummyFrame;
     std::size_t frameIdx = 0;
     queue_t frameQueue;
+    std::shared_ptr<Decoder::Stream> decodeStream;
     mcam::camera camera;
     PerfTimer perfTimer;
 
     using clock = std::chrono::high_resolution_clock;
     clock::time_point lastFrameTime;
+    std::atomic<std::uint64_t> droppedFrames{0};
 
     void frameHandler(mcam::camera::frame_status status,
                       const mcam::camera::settings& settings,
@@ -338,6 +356,8 @@ public:
     float getAvgReadTime() const {
         return perfTimer.getValue();
     }
+
+    bool getCaptureStats(VideoSources::CaptureStats& stats) const override;
 };
 
 
@@ -347,6 +367,7 @@ VideoSourceNative::VideoSourceNative(VideoSources& p, mcam::controller& ctrl,
     parent(p),
     queueSize(static_cast<int>(queueSize)),
     realFps(realFps),
+    decodeStream(p.decoder.createStream(static_cast<unsigned>(queueSize))),
     camera(ctrl, source, [this](
            mcam::camera::frame_status status,
            const mcam::camera::settings& settings,
@@ -373,37 +394,57 @@ void VideoSourceNative::frameHandler(mcam::camera::frame_status status,
                   const mcam::camera::settings& settings,
                   mcam::camera::frame frame) {
     if (status == mcam::camera::frame_status::ok) {
-        if (frameQueue.size() < queueSize) {
-            (void)settings;
-            assert(mcam::make_4cc('M', 'J', 'P', 'G') ==
-                   settings.format4cc);
-            assert(frame.valid());
-            auto data = frame.data();
-            auto size = frame.size();
-
-            std::unique_lock<std::mutex> lock(parent.decode_mutex);
-
-            parent.decoder.decode(
-                        data, size, settings.width, settings.height,
-            [this, fr = std::move(frame)](cv::Mat&& img) mutable {
-                fr = {};
-                bool success = !img.empty();
-                frameQueue.push({success, std::move(img)});
-                if (perfTimer.enabled()) {
-                    auto prev = lastFrameTime;
-                    auto current = clock::now();
-                    using dur = decltype (prev.time_since_epoch());
-                    if (dur::zero() != prev.time_since_epoch()) {
-                        perfTimer.addValue(current - prev);
-                    }
-
-                    lastFrameTime = current;
-                }
-            });
+        // The handler runs on the capture thread shared by the cameras, it must not wait
+        // for the decoder, so a frame which finds the queue or the decode window full is dropped
+        Decoder::Slot slot;
+        if (!(frameQueue.size() < queueSize) || !parent.decoder.tryAcquire(decodeStream, &slot)) {
+            droppedFrames++;
+            return;
         }
+        (void)settings;
+        assert(mcam::make_4cc('M', 'J', 'P', 'G') ==
+               settings.format4cc);
+        assert(frame.valid());
+        auto data = frame.data();
+        auto size = frame.size();
+
+        std::unique_lock<std::mutex> lock(parent.decode_mutex);
+
+        parent.decoder.decode(std::move(slot),
+                    data, size, settings.width, settings.height,
+        [this, fr = std::move(frame)](cv::Mat&& img) mutable {
+            fr = {};
+            bool success = !img.empty();
+            frameQueue.push({success, std::move(img)});
+            if (perfTimer.enabled()) {
+                auto prev = lastFrameTime;
+                auto current = clock::now();
+                using dur = decltype (prev.time_since_epoch());
+                if (dur::zero() != prev.time_since_epoch()) {
+                    perfTimer.addValue(current - prev);
+                }
+
+                lastFrameTime = current;
+            }
+        });
     }
 }
 
+bool VideoSourceNative::getCaptureStats(VideoSources::CaptureStats& stats) const {
+    auto snapshot = camera.get_stats();
+    auto toMs = [](std::chrono::microseconds time) {
+        return static_cast<float>(time.count()) / 1000.0f;
+    };
+    stats.frames = snapshot.frames;
+    stats.droppedBuffers = snapshot.dropped_buffers;
+    stats.droppedFrames = droppedFrames;
+    stats.meanIntervalMs = static_cast<float>(snapshot.mean_interval_us) / 1000.0f;
+    stats.p50IntervalMs = toMs(snapshot.percentile(0.5));
+    stats.p99IntervalMs = toMs(snapshot.percentile(0.99));
+    stats.maxIntervalMs = toMs(snapshot.max_interval);
+    return true;
+}
+
 bool VideoSourceNative::read(VideoFrame& frame) {
     queue_elem_t elem;
     if (realFps) {
@@ -482,12 +523,14 @@ bool VideoSourceOCV::readFrameImpl(cv::Mat& frame) {
 
 VideoSourceOCV::VideoSourceOCV(bool async, bool collectStats_,
                          const std::string& name, size_t queueSize_,
-                         size_t pollingTimeMSec_, bool realFps_):
+                         size_t pollingTimeMSec_, bool realFps_,
+                         ThreadBudget* threadBudget_):
     perfTimer(collectStats_ ? PerfTimer::DefaultIterationsCount : 0),
     isAsync(async), videoName(name),
     realFps(realFps_),
     queueSize(queueSize_),
-    pollingTimeMSec(pollingTimeMSec_) {}
+    pollingTimeMSec(pollingTimeMSec_),
+    threadBudget(threadBudget_) {}
 
 VideoSourceOCV::~VideoSourceOCV() {
     stop();
@@ -495,6 +538,7 @@ VideoSourceOCV::~VideoSourceOCV() {
 
 template<bool CollectStats>
 void VideoSourceOCV::thread_fn(VideoSourceOCV *vs) {
+    ThreadBudget::ScopedAttachment attachment(vs->threadBudget, ThreadBudget::CAPTURE);
     while (!vs->terminate) {
         cv::Mat frame;
         bool result = false;
@@ -593,16 +637,58 @@ Decoder::Settings makeDecoderSettings(bool collectStats, std::size_t queueSize,
     ret.collect_stats = collectStats;
     return ret;
 }
+
+#ifdef USE_NATIVE_CAMERA_API
+mcam::controller::settings makeCaptureSettings(const std::string& cpus, const std::string& scheduling) {
+    mcam::controller::settings ret;
+    std::stringstream cpusStream(cpus);
+    std::string cpu;
+    while (std::getline(cpusStream, cpu, ',')) {
+        if (cpu.empty() || !isNumeric(cpu)) {
+            throw std::logic_error("Incorrect capture cpus \"" + cpus + "\", expected a comma-separated list of cores");
+        }
+        ret.cpus.push_back(std::stoi(cpu));
+    }
+    if (!scheduling.empty()) {
+        auto pos = scheduling.find(':');
+        const std::string policy = scheduling.substr(0, pos);
+        if ("fifo" == policy) {
+            ret.policy = mcam::controller::sched_policy::fifo;
+        } else if ("rr" == policy) {
+            ret.policy = mcam::controller::sched_policy::rr;
+        } else {
+            throw std::logic_error("Incorrect capture scheduling \"" + scheduling + "\", expected fifo:<priority> or rr:<priority>");
+        }
+        const std::string priority = std::string::npos == pos ? std::string() : scheduling.substr(pos + 1);
+        if (priority.empty() || !isNumeric(priority)) {
+            throw std::logic_error("Capture scheduling \"" + scheduling + "\" requires a numeric priority");
+        }
+        ret.priority = std::stoi(priority);
+    }
+    return ret;
+}
+#endif
 }  // namespace
 
 VideoSources::VideoSources(const InitParams& p):
     decoder(makeDecoderSettings(p.collectStats, p.queueSize, p.expectedWidth,
                                 p.expectedHeight)),
+#ifdef USE_NATIVE_CAMERA_API
+    controller(makeCaptureSettings(p.captureCpus, p.captureScheduling)),
+#endif
     isAsync(p.isAsync),
     collectStats(p.collectStats),
     realFps(p.realFps),
     queueSize(p.queueSize),
-    pollingTimeMSec(p.pollingTimeMSec) {}
+    pollingTimeMSec(p.pollingTimeMSec),
+    threadBudget(p.threadBudget) {
+#ifndef USE_NATIVE_CAMERA_API
+    if (!p.captureCpus.empty() || !p.captureScheduling.empty()) {
+        throw std::logic_error("Capture cpus and scheduling require the native camera API, "
+                               "build the demo with MULTICHANNEL_DEMO_USE_NATIVE_CAM");
+    }
+#endif
+}
 
 VideoSources::~VideoSources() {
     // nothing
@@ -610,7 +696,8 @@ VideoSources::~VideoSources() {
 
 void VideoSources::openVideo(const std::string& source, bool native) {
 #ifdef USE_NATIVE_CAMERA_API
-    if (native) {
+    // a fake camera replays an .mjpeg file through the native capture
+    if (native || mcam::fake_device::is_fake(source)) {
         std::string dev;
         if (isNumeric(source)) {
             dev = "/dev/video" + source;
@@ -638,10 +725,10 @@ void VideoSources::openVideo(const std::string& source, bool native) {
                                             queueSize, pollingTimeMSec, realFps));
         else
             newSrc.reset(new VideoSourceOCV(isAsync, collectStats, source,
-                                            queueSize, pollingTimeMSec, realFps));
+                                            queueSize, pollingTimeMSec, realFps, threadBudget));
 #else
         std::unique_ptr<VideoSource> newSrc(new VideoSourceOCV(isAsync, collectStats, source,
-                                            queueSize, pollingTimeMSec, realFps));
+                                            queueSize, pollingTimeMSec, realFps, threadBudget));
 #endif
         if (newSrc->init()) {
             inputs.emplace_back(std::move(newSrc));
@@ -674,6 +761,13 @@ VideoSources::Stats VideoSources::getStats() const {
             ret.readTimes.push_back(input->getAvgReadTime());
         }
         ret.decodingLatency = decoder.getStats().decoding_latency;
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            CaptureStats capture;
+            if (inputs[i]->getCaptureStats(capture)) {
+                capture.sourceIdx = i;
+                ret.captureStats.push_back(capture);
+            }
+        }
     }
     return ret;
 }
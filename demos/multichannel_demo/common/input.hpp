@@ -10,11 +10,14 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <cstdint>
 #include <queue>
 #include <string>
 
 #include <opencv2/opencv.hpp>
 
+#include <samples/thread_budget.hpp>
+
 #ifdef USE_NATIVE_CAMERA_API
 #include "multicam/controller.hpp"
 #endif
@@ -66,6 +69,8 @@ private:
     const size_t queueSize = 1;
     const size_t pollingTimeMSec = 1000;
 
+    ThreadBudget* threadBudget = nullptr;
+
     void stop();
 
     friend VideoSourceNative;
@@ -81,6 +86,11 @@ public:
         bool realFps = false;
         unsigned expectedWidth = 0;
         unsigned expectedHeight = 0;
+        ThreadBudget* threadBudget = nullptr;
+        /// Comma-separated cores for the native camera capture threads
+        std::string captureCpus;
+        /// Scheduling of the native camera capture threads, "fifo:<priority>" or "rr:<priority>"
+        std::string captureScheduling;
     };
 
     explicit VideoSources(const InitParams& p);
@@ -92,9 +102,23 @@ public:
 
     bool getFrame(size_t index, VideoFrame& frame);
 
+    struct CaptureStats {
+        std::size_t sourceIdx = 0;
+        std::uint64_t frames = 0;
+        std::uint64_t droppedBuffers = 0;
+        /// Frames dropped by the demo because the frame queue or the decode window was full
+        std::uint64_t droppedFrames = 0;
+        float meanIntervalMs = 0.0f;
+        float p50IntervalMs = 0.0f;
+        float p99IntervalMs = 0.0f;
+        float maxIntervalMs = 0.0f;
+    };
+
     struct Stats {
         std::vector<float> readTimes;
         float decodingLatency = 0.0f;
+        /// Frame arrival jitter of the native cameras
+        std::vector<CaptureStats> captureStats;
     };
 
     Stats getStats() const;
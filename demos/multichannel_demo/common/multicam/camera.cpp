@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <memory>
@@ -111,12 +112,26 @@ camera::camera(controller& owner_, string_ref name_, callback_t callback_,
                const settings& params_):
     owner(owner_),
     params(params_),
-    dev(open_device(name_)),
     callback(std::move(callback_)) {
     assert(nullptr != callback);
-    set_device_params(dev, params, frame_buffer_size);
-    alloc_buffers();
-    start_capture();
+    if (fake_device::is_fake(name_)) {
+        const auto mjpeg = make_4cc('M', 'J', 'P', 'G');
+        if (0 != params.format4cc && mjpeg != params.format4cc) {
+            throw_error("fake camera device provides MJPG frames only");
+        }
+        fake.reset(new fake_device(name_, params.num_buffers,
+                                   params.frametime_numerator,
+                                   params.frametime_denominator));
+        params.width     = fake->width();
+        params.height    = fake->height();
+        params.format4cc = mjpeg;
+        fake->start();
+    } else {
+        dev = open_device(name_);
+        set_device_params(dev, params, frame_buffer_size);
+        alloc_buffers();
+        start_capture();
+    }
     owner.register_camera(*this);
 }
 
@@ -174,8 +189,20 @@ void camera::start_capture() {
 }
 
 void camera::read_frame() {
-    assert(dev.valid());
     assert(nullptr != callback);
+    if (fake) {
+        fake->capture();
+        unsigned index = 0;
+        void* ptr = nullptr;
+        std::size_t len = 0;
+        std::uint32_t sequence = 0;
+        while (fake->dequeue(index, ptr, len, sequence)) {
+            stats.add_frame(capture_stats::clock::now(), sequence);
+            callback(frame_status::ok, params, frame(*this, index, ptr, len));
+        }
+        return;
+    }
+    assert(dev.valid());
     while (true) {
         v4l2_buffer buf = {};
         buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -194,6 +221,7 @@ void camera::read_frame() {
                 throw_errno_error("Unable to get frame buffer ptr:", errno);
             }
         }
+        stats.add_frame(capture_stats::clock::now(), buf.sequence);
         auto ptr = reinterpret_cast<void*>(buf.m.userptr);
         assert(nullptr != ptr);
         auto len = buf.bytesused;
@@ -203,6 +231,10 @@ void camera::read_frame() {
 }
 
 void camera::reclaim_frame(frame& f) {
+    if (fake) {
+        fake->enqueue(f.index);
+        return;
+    }
     v4l2_buffer buf = {};
     buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     buf.memory = V4L2_MEMORY_USERPTR;
@@ -215,6 +247,14 @@ void camera::reclaim_frame(frame& f) {
     }
 }
 
+int camera::get_fd_to_poll() const {
+    return fake ? fake->get_fd_to_poll() : dev.get();
+}
+
+capture_stats::snapshot camera::get_stats() const {
+    return stats.get();
+}
+
 camera::frame::frame(camera& c, unsigned i, void* p, std::size_t l):
     cam(&c), index(i), ptr(p), len(l) {
     assert(nullptr != ptr);
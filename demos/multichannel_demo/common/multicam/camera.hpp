@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "capture_stats.hpp"
+#include "fake_device.hpp"
 #include "utils.hpp"
 
 #include <boost/intrusive/list.hpp>
@@ -61,10 +63,15 @@ public:
     using callback_t
         = std::function<void(frame_status, const settings&, frame)>;
 
+    /// Opens a V4L2 device or, if the name starts with fake_device::prefix,
+    /// a fake device replaying an .mjpeg file
     camera(controller& owner_, string_ref name_, callback_t callback_,
            const settings& params_);
     ~camera();
 
+    /// Arrival intervals of the frames and the number of frames dropped by the driver
+    capture_stats::snapshot get_stats() const;
+
 private:
     friend class camera::frame;
     struct device {
@@ -78,14 +85,19 @@ private:
     void start_capture();
     void read_frame();
     void reclaim_frame(frame& f);
+    int get_fd_to_poll() const;
 
     controller& owner;
     settings params;
     file_descriptor dev;
+    std::unique_ptr<fake_device> fake;
     std::size_t frame_buffer_size = 0;
     std::vector<std::unique_ptr<char[]>> buffers;
     callback_t callback;
+    capture_stats stats;
 
+    /// Index of the controller capture thread polling the camera
+    std::size_t thread_index = 0;
     boost::intrusive::list_member_hook<> list_node;
 };
 
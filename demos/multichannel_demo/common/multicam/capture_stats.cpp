@@ -0,0 +1,81 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "capture_stats.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace mcam {
+namespace {
+using lock_guard = std::lock_guard<std::mutex>;
+}
+
+std::uint64_t capture_stats::snapshot::intervals() const {
+    std::uint64_t count = 0;
+    for (auto bucket : histogram) {
+        count += bucket;
+    }
+    return count;
+}
+
+std::chrono::microseconds capture_stats::snapshot::percentile(double share) const {
+    const auto count = intervals();
+    if (0 == count) {
+        return std::chrono::microseconds(0);
+    }
+    const auto rank = static_cast<std::uint64_t>(std::ceil(std::min(std::max(share, 0.0), 1.0) * count));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+        seen += histogram[i];
+        if (seen >= std::max<std::uint64_t>(rank, 1)) {
+            // the overflow bucket has no upper bound
+            return i + 1 == histogram.size() ? max_interval
+                                             : std::min(max_interval, bucket_width * static_cast<int>(i + 1));
+        }
+    }
+    return max_interval;
+}
+
+capture_stats::capture_stats(std::chrono::microseconds bucket_width, std::size_t buckets) {
+    assert(bucket_width.count() > 0);
+    assert(buckets > 1);
+    data.bucket_width = bucket_width;
+    data.histogram.assign(buckets, 0);
+}
+
+void capture_stats::add_frame(clock::time_point arrival, std::uint32_t sequence) {
+    lock_guard lock(mutex);
+    if (0 != data.frames) {
+        // the sequence is incremented by the driver for every captured frame,
+        // including the ones dropped for lack of a queued buffer
+        const std::uint32_t gap = sequence - last_sequence;
+        if (gap > 1 && gap < (1u << 31)) {
+            data.dropped_buffers += gap - 1;
+        }
+
+        const auto interval = std::chrono::duration_cast<std::chrono::microseconds>(arrival - last_arrival);
+        const auto bucket = std::min(static_cast<std::size_t>(std::max<std::int64_t>(interval.count(), 0)
+                                                              / data.bucket_width.count()),
+                                     data.histogram.size() - 1);
+        ++data.histogram[bucket];
+        if (1 == data.frames || interval < data.min_interval) {
+            data.min_interval = interval;
+        }
+        data.max_interval = std::max(data.max_interval, interval);
+        interval_sum_us += static_cast<double>(interval.count());
+        data.mean_interval_us = interval_sum_us / static_cast<double>(data.frames);
+    }
+    ++data.frames;
+    last_arrival = arrival;
+    last_sequence = sequence;
+}
+
+capture_stats::snapshot capture_stats::get() const {
+    lock_guard lock(mutex);
+    return data;
+}
+
+}  // namespace mcam
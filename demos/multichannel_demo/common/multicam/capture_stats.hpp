@@ -0,0 +1,56 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mcam {
+
+/// Timing of the frames dequeued by a capture thread: the histogram of the
+/// intervals between frame arrivals and the number of frames the driver
+/// dropped because no buffer was queued, found by gaps in the buffer sequence
+class capture_stats final {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct snapshot final {
+        std::uint64_t frames = 0;
+        std::uint64_t dropped_buffers = 0;
+
+        /// Arrival intervals, bucket i counts the intervals in
+        /// [i * bucket_width, (i + 1) * bucket_width), the last bucket
+        /// counts all longer intervals
+        std::chrono::microseconds bucket_width{0};
+        std::vector<std::uint64_t> histogram;
+
+        std::chrono::microseconds min_interval{0};
+        std::chrono::microseconds max_interval{0};
+        double mean_interval_us = 0.0;
+
+        std::uint64_t intervals() const;
+
+        /// Upper bound of the bucket containing the given share (0..1) of the intervals
+        std::chrono::microseconds percentile(double share) const;
+    };
+
+    explicit capture_stats(std::chrono::microseconds bucket_width = std::chrono::microseconds(500),
+                           std::size_t buckets = 400);
+
+    void add_frame(clock::time_point arrival, std::uint32_t sequence);
+
+    snapshot get() const;
+
+private:
+    mutable std::mutex mutex;
+    snapshot data;
+    double interval_sum_us = 0.0;
+    clock::time_point last_arrival;
+    std::uint32_t last_sequence = 0;
+};
+
+}  // namespace mcam
@@ -4,79 +4,160 @@
 
 #include "controller.hpp"
 
+#include <cassert>
+#include <cerrno>
+#include <string>
 #include <vector>
 
 #include "utils.hpp"
 
 #include <fcntl.h>
 #include <poll.h>
+#include <pthread.h>
+#include <sched.h>
 
 namespace mcam {
 namespace {
 using lock_guard = std::lock_guard<std::mutex>;
+
+void set_affinity(std::thread& thread, int cpu) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        throw_error("capture thread cpu index is out of range");
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    auto err = pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+    if (0 != err) {
+        throw_errno_error(("failed to pin capture thread to cpu " + std::to_string(cpu) + ":").c_str(), err);
+    }
 }
 
-controller::controller() {
-    queue_thread = std::thread([this]() {
-        std::vector<pollfd> fds;
-        std::vector<camera*> temp_ptrs;
-        const auto poll_flags = POLLIN | POLLRDNORM | POLLERR;
-        while (!terminate) { {
-                lock_guard lock(list_mutex);
-                auto size = cameras.size() + 1;
-                if (fds.size() != size) {
-                    fds.clear();
-                    temp_ptrs.clear();
-                    fds.push_back(pollfd{notifier.get_fd_to_poll(), POLLIN, 0});
-                    for (auto& cam : cameras) {
-                        assert(cam.dev.valid());
-                        fds.push_back(pollfd{cam.dev.get(), poll_flags, 0});
-                        temp_ptrs.push_back(&cam);
-                    }
-                }
-            }
+void set_scheduling(std::thread& thread, controller::sched_policy policy, int priority) {
+    const int sched = controller::sched_policy::fifo == policy ? SCHED_FIFO : SCHED_RR;
+    if (priority < sched_get_priority_min(sched) || priority > sched_get_priority_max(sched)) {
+        throw_error(("capture thread priority must be in the range [" +
+                     std::to_string(sched_get_priority_min(sched)) + ", " +
+                     std::to_string(sched_get_priority_max(sched)) + "]").c_str());
+    }
+    sched_param param = {};
+    param.sched_priority = priority;
+    auto err = pthread_setschedparam(thread.native_handle(), sched, &param);
+    if (0 != err) {
+        // EPERM without CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO
+        throw_errno_error("failed to set real-time scheduling of capture thread:", err);
+    }
+}
+}  // namespace
 
-            if (-1 == poll(fds.data(), fds.size(), -1)) {
-                throw_errno_error("failed wait on poll:", errno);
-            }
+controller::controller():
+    controller(settings{}) {
+}
 
-            for (size_t i = 0; i < fds.size(); ++i) {
-                if (0 != (fds[i].revents & poll_flags)) {
-                    if (0 == i) {
-                        notifier.flush();
-                    } else {
-                        auto cam = temp_ptrs[i - 1];
-                        assert(nullptr != cam);
-                        cam->read_frame();
-                    }
-                }
-            }
+controller::controller(const settings& params) {
+    const auto count = params.cpus.empty() ? std::size_t(1) : params.cpus.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        threads.emplace_back(new capture_thread);
+        auto& thread = threads.back()->thread;
+        // a failure stops the started threads by the destruction of the list
+        if (!params.cpus.empty()) {
+            set_affinity(thread, params.cpus[i]);
         }
-    });
+        if (sched_policy::other != params.policy) {
+            set_scheduling(thread, params.policy, params.priority);
+        }
+    }
 }
 
 controller::~controller() {
-    terminate = true;
-    notifier.signal();
-    if (queue_thread.joinable()) {
-        queue_thread.join();
-    }
+    threads.clear();
 }
 
 void controller::register_camera(camera& cam) {
+    // the camera goes to the thread polling the least cameras
+    std::size_t index = 0;
+    std::size_t min_size = 0;
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        lock_guard lock(threads[i]->list_mutex);
+        if (0 == i || threads[i]->cameras.size() < min_size) {
+            index = i;
+            min_size = threads[i]->cameras.size();
+        }
+    }
+    auto& thread = *threads[index];
     {
-        lock_guard lock(list_mutex);
-        cameras.push_back(cam);
+        lock_guard lock(thread.list_mutex);
+        cam.thread_index = index;
+        thread.cameras.push_back(cam);
+        thread.list_changed = true;
     }
-    notifier.signal();
+    thread.notifier.signal();
 }
 
 void controller::unregister_camera(camera& cam) {
+    auto& thread = *threads[cam.thread_index];
     {
-        lock_guard lock(list_mutex);
-        cameras.erase(decltype(cameras)::s_iterator_to(cam));
+        lock_guard lock(thread.list_mutex);
+        thread.cameras.erase(decltype(thread.cameras)::s_iterator_to(cam));
+        thread.list_changed = true;
     }
+    thread.notifier.signal();
+}
+
+controller::capture_thread::capture_thread() {
+    thread = std::thread([this]() {
+        run();
+    });
+}
+
+controller::capture_thread::~capture_thread() {
+    terminate = true;
     notifier.signal();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void controller::capture_thread::run() {
+    std::vector<pollfd> fds;
+    std::vector<camera*> temp_ptrs;
+    const auto poll_flags = POLLIN | POLLRDNORM | POLLERR;
+    while (!terminate) { {
+            lock_guard lock(list_mutex);
+            if (list_changed) {
+                list_changed = false;
+                fds.clear();
+                temp_ptrs.clear();
+                fds.push_back(pollfd{notifier.get_fd_to_poll(), POLLIN, 0});
+                for (auto& cam : cameras) {
+                    assert(-1 != cam.get_fd_to_poll());
+                    fds.push_back(pollfd{cam.get_fd_to_poll(), poll_flags, 0});
+                    temp_ptrs.push_back(&cam);
+                }
+            }
+        }
+
+        if (-1 == poll(fds.data(), fds.size(), -1)) {
+            if (EINTR == errno) {
+                continue;
+            }
+            throw_errno_error("failed wait on poll:", errno);
+        }
+
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (0 != (fds[i].revents & poll_flags)) {
+                if (0 == i) {
+                    notifier.flush();
+                    // the list may have changed, the cameras are polled again with the new list
+                    break;
+                } else {
+                    auto cam = temp_ptrs[i - 1];
+                    assert(nullptr != cam);
+                    cam->read_frame();
+                }
+            }
+        }
+    }
 }
 
 controller::poll_notifier::poll_notifier() {
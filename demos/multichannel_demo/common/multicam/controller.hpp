@@ -5,8 +5,10 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "camera.hpp"
 #include "utils.hpp"
@@ -17,25 +19,32 @@ class controller final {
 public:
     friend class ::mcam::camera;
 
+    enum class sched_policy {
+        other,  ///< default time-sharing scheduling
+        fifo,   ///< SCHED_FIFO real-time scheduling
+        rr      ///< SCHED_RR real-time scheduling
+    };
+
+    struct settings final {
+        /// Cores for the capture threads, one thread is pinned to every core
+        /// and the cameras are distributed between the threads. If empty,
+        /// one unpinned thread polls all cameras
+        std::vector<int> cpus;
+
+        sched_policy policy = sched_policy::other;
+
+        /// Real-time priority for the fifo and rr policies
+        int priority = 0;
+    };
+
     controller();
+    explicit controller(const settings& params);
     ~controller();
 
 private:
     void register_camera(camera& cam);
     void unregister_camera(camera& cam);
 
-    std::thread queue_thread;
-    std::atomic_bool terminate = {false};
-
-    std::mutex list_mutex;
-    boost::intrusive::list<
-        camera,
-        boost::intrusive::member_hook<
-            camera,
-            boost::intrusive::list_member_hook<>, &camera::list_node
-        >
-    > cameras;
-
     struct poll_notifier final {
         file_descriptor read_fd;
         file_descriptor write_fd;
@@ -48,7 +57,29 @@ private:
         int get_fd_to_poll() const { return read_fd.get(); }
     };
 
-    poll_notifier notifier;
+    struct capture_thread final {
+        capture_thread();
+        ~capture_thread();
+
+        void run();
+
+        std::thread thread;
+        std::atomic_bool terminate = {false};
+
+        std::mutex list_mutex;
+        bool list_changed = true;
+        boost::intrusive::list<
+            camera,
+            boost::intrusive::member_hook<
+                camera,
+                boost::intrusive::list_member_hook<>, &camera::list_node
+            >
+        > cameras;
+
+        poll_notifier notifier;
+    };
+
+    std::vector<std::unique_ptr<capture_thread>> threads;
 };
 
 }  // namespace mcam
@@ -0,0 +1,201 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "fake_device.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace mcam {
+namespace {
+using lock_guard = std::lock_guard<std::mutex>;
+
+constexpr unsigned char marker_start = 0xff;
+constexpr unsigned char marker_soi   = 0xd8;
+constexpr unsigned char marker_eoi   = 0xd9;
+constexpr unsigned char marker_sos   = 0xda;
+
+unsigned byte_at(const std::string& data, std::size_t pos) {
+    return static_cast<unsigned char>(data[pos]);
+}
+
+unsigned read_u16(const std::string& data, std::size_t pos) {
+    return (byte_at(data, pos) << 8) | byte_at(data, pos + 1);
+}
+
+bool is_sof(unsigned marker) {
+    // SOF0-SOF15 except DHT (c4), JPG (c8) and DAC (cc)
+    return marker >= 0xc0 && marker <= 0xcf && 0xc4 != marker && 0xc8 != marker && 0xcc != marker;
+}
+
+/// Walks the segments of the JPEG image starting at begin, returns the
+/// position after its EOI marker and the frame size of its SOF segment
+std::size_t parse_jpeg(const std::string& data, std::size_t begin,
+                       unsigned& width, unsigned& height) {
+    std::size_t pos = begin + 2;
+    while (pos + 1 < data.size()) {
+        if (marker_start != byte_at(data, pos)) {
+            throw_error("corrupted JPEG stream: segment marker expected");
+        }
+        const unsigned marker = byte_at(data, pos + 1);
+        if (marker_eoi == marker) {
+            return pos + 2;
+        }
+        if (marker_start == marker || (marker >= 0xd0 && marker <= 0xd7) || 0x01 == marker) {
+            // fill byte or a segment without a length
+            pos += marker_start == marker ? 1 : 2;
+            continue;
+        }
+        if (pos + 3 >= data.size()) {
+            break;
+        }
+        const std::size_t length = read_u16(data, pos + 2);
+        if (is_sof(marker) && pos + 8 < data.size()) {
+            height = read_u16(data, pos + 5);
+            width  = read_u16(data, pos + 7);
+        }
+        pos += 2 + length;
+        if (marker_sos == marker) {
+            // entropy-coded data ends at a marker other than a stuffed zero or a restart marker
+            while (pos + 1 < data.size() &&
+                   !(marker_start == byte_at(data, pos) && 0x00 != byte_at(data, pos + 1) &&
+                     !(byte_at(data, pos + 1) >= 0xd0 && byte_at(data, pos + 1) <= 0xd7))) {
+                ++pos;
+            }
+        }
+    }
+    throw_error("corrupted JPEG stream: unexpected end of file");
+}
+
+std::vector<std::string> read_mjpeg(const std::string& path, unsigned& width, unsigned& height) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw_error(std::string("cannot open fake camera file: \"") + path + "\"");
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<std::string> frames;
+    std::size_t pos = 0;
+    while (pos + 1 < data.size()) {
+        if (marker_start != byte_at(data, pos) || marker_soi != byte_at(data, pos + 1)) {
+            ++pos;  // padding between the images
+            continue;
+        }
+        unsigned frame_width = 0;
+        unsigned frame_height = 0;
+        const auto end = parse_jpeg(data, pos, frame_width, frame_height);
+        if (0 == frame_width || 0 == frame_height) {
+            throw_error("fake camera file contains a JPEG image without a frame header");
+        }
+        if (!frames.empty() && (frame_width != width || frame_height != height)) {
+            throw_error("frames of a fake camera file must have the same size");
+        }
+        width = frame_width;
+        height = frame_height;
+        frames.emplace_back(data, pos, end - pos);
+        pos = end;
+    }
+    if (frames.empty()) {
+        throw_error(std::string("no JPEG frames in fake camera file: \"") + path + "\"");
+    }
+    return frames;
+}
+}  // namespace
+
+constexpr const char* fake_device::prefix;
+
+bool fake_device::is_fake(string_ref name) {
+    const auto len = std::strlen(prefix);
+    return name.size() > len && 0 == std::strncmp(name.data(), prefix, len);
+}
+
+fake_device::fake_device(string_ref name, unsigned num_buffers,
+                         unsigned frametime_numerator, unsigned frametime_denominator):
+    frames(read_mjpeg(name.data() + std::strlen(prefix), frame_width, frame_height)),
+    timer(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)) {
+    assert(num_buffers > 0);
+    if (!timer.valid()) {
+        throw_errno_error("cannot create fake camera timer:", errno);
+    }
+    if (0 == frametime_numerator || 0 == frametime_denominator) {
+        // 30 fps by default
+        frametime_numerator = 1;
+        frametime_denominator = 30;
+    }
+    frametime_ns = std::uint64_t(1000000000) * frametime_numerator / frametime_denominator;
+
+    std::size_t max_size = 0;
+    for (const auto& frame : frames) {
+        max_size = std::max(max_size, frame.size());
+    }
+    for (unsigned i = 0; i < num_buffers; ++i) {
+        buffers.emplace_back(new char[max_size]);
+        buffer_sizes.push_back(0);
+        free_buffers.push_back(i);
+    }
+}
+
+void fake_device::start() {
+    itimerspec spec = {};
+    spec.it_interval.tv_sec  = static_cast<time_t>(frametime_ns / 1000000000);
+    spec.it_interval.tv_nsec = static_cast<long>(frametime_ns % 1000000000);
+    spec.it_value = spec.it_interval;
+    if (-1 == timerfd_settime(timer.get(), 0, &spec, nullptr)) {
+        throw_errno_error("cannot start fake camera timer:", errno);
+    }
+}
+
+void fake_device::capture() {
+    std::uint64_t expirations = 0;
+    if (-1 == read(timer.get(), &expirations, sizeof(expirations))) {
+        if (EAGAIN == errno) {
+            return;
+        }
+        throw_errno_error("cannot read fake camera timer:", errno);
+    }
+
+    lock_guard lock(buffers_mutex);
+    for (std::uint64_t i = 0; i < expirations; ++i) {
+        const auto& frame = frames[next_frame];
+        next_frame = (next_frame + 1) % frames.size();
+        if (free_buffers.empty()) {
+            ++sequence;  // the frame is lost as by a driver without queued buffers
+            continue;
+        }
+        const auto index = free_buffers.front();
+        free_buffers.pop_front();
+        std::memcpy(buffers[index].get(), frame.data(), frame.size());
+        buffer_sizes[index] = frame.size();
+        filled_buffers.push_back(filled_buffer{index, sequence++});
+    }
+}
+
+bool fake_device::dequeue(unsigned& index, void*& ptr, std::size_t& len, std::uint32_t& seq) {
+    lock_guard lock(buffers_mutex);
+    if (filled_buffers.empty()) {
+        return false;
+    }
+    index = filled_buffers.front().index;
+    seq = filled_buffers.front().sequence;
+    filled_buffers.pop_front();
+    ptr = buffers[index].get();
+    len = buffer_sizes[index];
+    return true;
+}
+
+void fake_device::enqueue(unsigned index) {
+    lock_guard lock(buffers_mutex);
+    assert(index < buffers.size());
+    free_buffers.push_back(index);
+}
+
+}  // namespace mcam
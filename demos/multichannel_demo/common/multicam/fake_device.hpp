@@ -0,0 +1,72 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace mcam {
+
+/// File-backed camera for testing the capture without hardware. Replays the
+/// JPEG frames of an .mjpeg file in a loop with the given frame time and
+/// behaves like a V4L2 driver: a pollable timer fires once per frame, every
+/// frame is copied into a queued buffer and gets the next sequence number,
+/// and the frame is dropped when all buffers are held by the application
+class fake_device final {
+public:
+    /// Prefix of the camera names opened as a fake device, e.g. "fake:video.mjpeg"
+    static constexpr const char* prefix = "fake:";
+
+    static bool is_fake(string_ref name);
+
+    fake_device(string_ref name, unsigned num_buffers,
+                unsigned frametime_numerator, unsigned frametime_denominator);
+
+    int get_fd_to_poll() const { return timer.get(); }
+
+    unsigned width() const { return frame_width; }
+    unsigned height() const { return frame_height; }
+
+    void start();
+
+    /// Accounts the expired frame times of the timer
+    void capture();
+
+    /// Takes the next filled buffer, returns false if there is none
+    bool dequeue(unsigned& index, void*& ptr, std::size_t& len, std::uint32_t& sequence);
+
+    /// Returns the buffer to the device
+    void enqueue(unsigned index);
+
+private:
+    struct filled_buffer final {
+        unsigned index;
+        std::uint32_t sequence;
+    };
+
+    // set by the reading of the frames, so declared before them
+    unsigned frame_width = 0;
+    unsigned frame_height = 0;
+    std::vector<std::string> frames;
+    std::size_t next_frame = 0;
+    std::uint64_t frametime_ns = 0;
+
+    file_descriptor timer;
+
+    std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<char[]>> buffers;
+    std::vector<std::size_t> buffer_sizes;
+    std::deque<unsigned> free_buffers;
+    std::deque<filled_buffer> filled_buffers;
+    std::uint32_t sequence = 0;
+};
+
+}  // namespace mcam
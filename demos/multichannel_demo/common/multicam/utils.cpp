@@ -58,6 +58,11 @@ file_descriptor::file_descriptor(int fd_):
     desc(fd_) {
 }
 
+file_descriptor::file_descriptor(file_descriptor&& other):
+    desc(other.desc) {
+    other.desc = -1;
+}
+
 file_descriptor::~file_descriptor() {
     if (-1 != desc) {
         close(desc);
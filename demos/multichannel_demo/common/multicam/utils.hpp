@@ -36,7 +36,7 @@ bool operator!=(std::nullptr_t, const string_ref& str);
 struct file_descriptor {
     explicit file_descriptor(int fd_ = -1);
     file_descriptor(const file_descriptor&) = delete;
-    file_descriptor(file_descriptor&&) = default;
+    file_descriptor(file_descriptor&& other);
     ~file_descriptor();
 
     file_descriptor& operator=(file_descriptor&& other);
@@ -63,6 +63,49 @@ static const char real_input_fps[] = "Optional. Disable input frames caching, fo
 /// @brief Message for enabling input video
 static const char input_video[] = "Optional. Specify full path to input video files";
 
+/// @brief Message for recording output blobs
+static const char record_blobs_message[] = "Optional. Record output blobs of every infer request to the specified file";
+
+/// @brief Message for replaying output blobs
+static const char replay_blobs_message[] = "Optional. Replay output blobs from the specified file instead of running inference. " \
+"Parameter -m is not required in this mode";
+
+/// @brief Message for replay latency
+static const char replay_latency_message[] = "Optional. Latency in msec injected into every replayed infer request";
+
+/// @brief Message for thread budget
+static const char thread_budget_message[] = "Optional. Split CPU cores between the pipeline stages, " \
+"for example \"capture:2,preprocessing:2,inference:16,postprocessing:4\". " \
+"Partitions which are not listed get one thread, inference gets the rest of the cores. " \
+"CPU utilization of every partition is reported every sampling period";
+
+/// @brief Message for huge pages
+static const char huge_pages_message[] = "Optional. Allocate frames and input tensors on huge pages local to the NUMA node " \
+"of the allocating thread. \"thp\" uses transparent huge pages, \"explicit\" uses the pages reserved in " \
+"/proc/sys/vm/nr_hugepages and falls back to transparent ones. Supported on Linux only";
+
+/// @brief Message for per-layer performance sampling period
+static const char pc_period_message[] = "Optional. Sample per-layer performance counters of a completed infer request " \
+"every specified number of milliseconds and report the layer time distributions every sampling period. 0 disables sampling";
+
+/// @brief Message for per-layer performance sampling overhead
+static const char pc_budget_message[] = "Optional. Maximal share of time in percent spent on per-layer performance sampling, " \
+"the sampling period is increased to stay within it";
+
+/// @brief Message for per-layer performance metrics file
+static const char pc_metrics_message[] = "Optional. Write the sampled layer time histograms in Prometheus text format " \
+"to the specified file every sampling period";
+
+/// @brief Message for capture thread cores
+static const char capture_cpus_message[] = "Optional. Comma-separated cores for the capture threads of the native cameras, " \
+"one thread is pinned to every core and the cameras are distributed between them. " \
+"Requires the demo built with the native camera API";
+
+/// @brief Message for capture thread scheduling
+static const char capture_sched_message[] = "Optional. Real-time scheduling of the capture threads of the native cameras, " \
+"\"fifo:<priority>\" or \"rr:<priority>\". Requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO " \
+"and the demo built with the native camera API";
+
 /// \brief Define a flag for showing help message <br>
 DEFINE_bool(h, false, help_message);
 
@@ -127,3 +170,43 @@ DEFINE_bool(real_input_fps, false, real_input_fps);
 /// \brief Define parameter for input video files <br>
 /// It is a optional parameter
 DEFINE_string(i, "", input_video);
+
+/// \brief Define parameter for the output blobs record file <br>
+/// It is a optional parameter
+DEFINE_string(record, "", record_blobs_message);
+
+/// \brief Define parameter for the output blobs replay file <br>
+/// It is a optional parameter
+DEFINE_string(replay, "", replay_blobs_message);
+
+/// \brief Flag to specify latency of replayed infer requests<br>
+/// It is an optional parameter
+DEFINE_uint32(replay_latency, 0, replay_latency_message);
+
+/// \brief Define parameter for the thread budget <br>
+/// It is a optional parameter
+DEFINE_string(thread_budget, "", thread_budget_message);
+
+/// \brief Define parameter for huge pages <br>
+/// It is a optional parameter
+DEFINE_string(huge_pages, "", huge_pages_message);
+
+/// \brief Define parameter for per-layer performance sampling period <br>
+/// It is a optional parameter
+DEFINE_uint32(pc_period, 0, pc_period_message);
+
+/// \brief Define parameter for per-layer performance sampling overhead <br>
+/// It is a optional parameter
+DEFINE_double(pc_budget, 1.0, pc_budget_message);
+
+/// \brief Define parameter for per-layer performance metrics file <br>
+/// It is a optional parameter
+DEFINE_string(pc_metrics, "", pc_metrics_message);
+
+/// \brief Define parameter for capture thread cores <br>
+/// It is a optional parameter
+DEFINE_string(capture_cpus, "", capture_cpus_message);
+
+/// \brief Define parameter for capture thread scheduling <br>
+/// It is a optional parameter
+DEFINE_string(capture_sched, "", capture_sched_message);
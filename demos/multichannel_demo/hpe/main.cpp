@@ -41,6 +41,9 @@
 #include <samples/slog.hpp>
 
 #include <samples/args_helper.hpp>
+#include <samples/huge_pages.hpp>
+#include <samples/perf_sampler.hpp>
+#include <samples/thread_budget.hpp>
 
 #include "input.hpp"
 #include "multichannel_params.hpp"
@@ -82,6 +85,16 @@ void showUsage() {
     std::cout << "    -duplicate_num               " << duplication_channel_number << std::endl;
     std::cout << "    -real_input_fps              " << real_input_fps << std::endl;
     std::cout << "    -i                           " << input_video << std::endl;
+    std::cout << "    -record \"<path>\"             " << record_blobs_message << std::endl;
+    std::cout << "    -replay \"<path>\"             " << replay_blobs_message << std::endl;
+    std::cout << "    -replay_latency              " << replay_latency_message << std::endl;
+    std::cout << "    -thread_budget \"<budget>\"     " << thread_budget_message << std::endl;
+    std::cout << "    -huge_pages \"<mode>\"          " << huge_pages_message << std::endl;
+    std::cout << "    -pc_period                   " << pc_period_message << std::endl;
+    std::cout << "    -pc_budget                   " << pc_budget_message << std::endl;
+    std::cout << "    -pc_metrics \"<path>\"         " << pc_metrics_message << std::endl;
+    std::cout << "    -capture_cpus \"<cores>\"      " << capture_cpus_message << std::endl;
+    std::cout << "    -capture_sched \"<policy>\"    " << capture_sched_message << std::endl;
 }
 
 bool ParseAndCheckCommandLine(int argc, char *argv[]) {
@@ -94,7 +107,7 @@ bool ParseAndCheckCommandLine(int argc, char *argv[]) {
     }
     slog::info << "Parsing input parameters" << slog::endl;
 
-    if (FLAGS_m.empty()) {
+    if (FLAGS_m.empty() && FLAGS_replay.empty()) {
         throw std::logic_error("Parameter -m is not set");
     }
     if (FLAGS_nc == 0 && FLAGS_i.empty()) {
@@ -202,27 +215,46 @@ void displayNSources(const std::vector<std::shared_ptr<VideoFrame>>& data,
 
 int main(int argc, char* argv[]) {
     try {
-#if USE_TBB
-        TbbArenaWrapper arena;
-#endif
         slog::info << "InferenceEngine: " << InferenceEngine::GetInferenceEngineVersion() << slog::endl;
 
         // ------------------------------ Parsing and validation of input args ---------------------------------
         if (!ParseAndCheckCommandLine(argc, argv)) {
             return 0;
         }
+        enableHugePages(FLAGS_huge_pages);
+
+        std::unique_ptr<ThreadBudget> threadBudget;
+        if (!FLAGS_thread_budget.empty()) {
+            threadBudget.reset(new ThreadBudget(FLAGS_thread_budget));
+            threadBudget->setInferenceStreams(FLAGS_n_ir);
+            threadBudget->configureOpenCV();
+            threadBudget->attachCurrentThread(ThreadBudget::POSTPROCESSING);
+            slog::info << "Thread budget: " << threadBudget->toString()
+                       << ", inference streams: " << threadBudget->inferenceStreams() << slog::endl;
+        }
+        std::unique_ptr<PerfCountersSampler> perfSampler;
+        if (0 != FLAGS_pc_period) {
+            perfSampler.reset(new PerfCountersSampler(std::chrono::milliseconds(FLAGS_pc_period), FLAGS_pc_budget / 100.));
+            perfSampler->setMetricsFile(FLAGS_pc_metrics);
+        }
+#if USE_TBB
+        TbbArenaWrapper arena(threadBudget ? static_cast<int>(threadBudget->threads(ThreadBudget::PREPROCESSING))
+                                           : static_cast<int>(tbb::task_arena::automatic));
+#endif
 
         std::string weightsPath;
         std::string modelPath = FLAGS_m;
-        std::size_t found = modelPath.find_last_of(".");
-        if (found > modelPath.size()) {
-            slog::info << "Invalid model name: " << modelPath << slog::endl;
-            slog::info << "Expected to be <model_name>.xml" << slog::endl;
-            return -1;
+        if (FLAGS_replay.empty()) {
+            std::size_t found = modelPath.find_last_of(".");
+            if (found > modelPath.size()) {
+                slog::info << "Invalid model name: " << modelPath << slog::endl;
+                slog::info << "Expected to be <model_name>.xml" << slog::endl;
+                return -1;
+            }
+            weightsPath = modelPath.substr(0, found) + ".bin";
+            slog::info << "Model   path: " << modelPath << slog::endl;
+            slog::info << "Weights path: " << weightsPath << slog::endl;
         }
-        weightsPath = modelPath.substr(0, found) + ".bin";
-        slog::info << "Model   path: " << modelPath << slog::endl;
-        slog::info << "Weights path: " << weightsPath << slog::endl;
 
         IEGraph::InitParams graphParams;
         graphParams.batchSize       = FLAGS_bs;
@@ -234,6 +266,11 @@ int main(int argc, char* argv[]) {
         graphParams.cpuExtPath      = FLAGS_l;
         graphParams.cldnnConfigPath = FLAGS_c;
         graphParams.deviceName      = FLAGS_d;
+        graphParams.recordPath      = FLAGS_record;
+        graphParams.replayPath      = FLAGS_replay;
+        graphParams.replayLatency   = std::chrono::milliseconds(FLAGS_replay_latency);
+        graphParams.threadBudget    = threadBudget.get();
+        graphParams.perfSampler     = perfSampler.get();
 
         std::shared_ptr<IEGraph> network(new IEGraph(graphParams));
         auto inputDims = network->getInputDims();
@@ -262,6 +299,9 @@ int main(int argc, char* argv[]) {
         vsParams.queueSize            = FLAGS_n_iqs;
         vsParams.collectStats         = FLAGS_show_stats;
         vsParams.realFps              = FLAGS_real_input_fps;
+        vsParams.threadBudget         = threadBudget.get();
+        vsParams.captureCpus          = FLAGS_capture_cpus;
+        vsParams.captureScheduling    = FLAGS_capture_sched;
         vsParams.expectedHeight = static_cast<unsigned>(inputDims[2]);
         vsParams.expectedWidth  = static_cast<unsigned>(inputDims[3]);
 
@@ -347,6 +387,8 @@ int main(int argc, char* argv[]) {
         const size_t outputQueueSize = 1;
         AsyncOutput output(FLAGS_show_stats, outputQueueSize,
         [&](const std::vector<std::shared_ptr<VideoFrame>>& result) {
+            // the output thread is attached once and detached when it exits
+            thread_local ThreadBudget::ScopedAttachment attachment(threadBudget.get(), ThreadBudget::POSTPROCESSING);
             std::string str;
             if (FLAGS_show_stats) {
                 std::unique_lock<std::mutex> lock(statMutex);
@@ -399,9 +441,19 @@ int main(int argc, char* argv[]) {
                 auto frameTime = durMsec / static_cast<float>(fpsCounter);
                 fpsCounter = 0;
                 lastTime = currTime;
+                std::string cpuUtilization = threadBudget ? threadBudget->utilizationReport() : std::string();
 
                 if (FLAGS_no_show) {
                     slog::info << "Average Throughput : " << 1000.f/frameTime << " fps" << slog::endl;
+                    if (!cpuUtilization.empty()) {
+                        slog::info << "CPU utilization : " << cpuUtilization << slog::endl;
+                    }
+                    if (!FLAGS_huge_pages.empty()) {
+                        slog::info << "Memory : " << HugePageArena::instance().report() << slog::endl;
+                    }
+                    if (perfSampler) {
+                        slog::info << perfSampler->report() << slog::endl;
+                    }
                     if (++perfItersCounter >= FLAGS_n_sp) {
                         break;
                     }
@@ -428,6 +480,14 @@ int main(int argc, char* argv[]) {
                     statStream << "HW decoding latency: "
                                << inputStat.decodingLatency << "ms";
                     statStream << std::endl;
+                    for (const auto& capture : inputStat.captureStats) {
+                        statStream << "Capture " << capture.sourceIdx << ": " << capture.frames << " frames, "
+                                   << capture.droppedBuffers << " dropped by driver, "
+                                   << capture.droppedFrames << " dropped by demo, interval mean "
+                                   << capture.meanIntervalMs << "ms p50 " << capture.p50IntervalMs << "ms p99 "
+                                   << capture.p99IntervalMs << "ms max " << capture.maxIntervalMs << "ms";
+                        statStream << std::endl;
+                    }
                     statStream << "Preprocess time: "
                                << inferStat.preprocessTime << "ms";
                     statStream << std::endl;
@@ -437,6 +497,9 @@ int main(int argc, char* argv[]) {
 
                     statStream << "Render time: " << outputStat.renderTime
                                << "ms" << std::endl;
+                    if (!cpuUtilization.empty()) {
+                        statStream << "CPU utilization: " << cpuUtilization << std::endl;
+                    }
 
                     if (FLAGS_no_show) {
                         slog::info << statStream.str() << slog::endl;
@@ -12,6 +12,8 @@
 #include <utility>
 #include <algorithm>
 
+#include <samples/huge_pages.hpp>
+
 using namespace InferenceEngine;
 using namespace InferenceEngine::Extensions;
 using namespace InferenceEngine::Extensions::Cpu;
@@ -97,40 +99,33 @@ public:
                                                     static_cast<size_t>(_num_classes),
                                                     static_cast<size_t>(_num_priors),
                                                     4};
-            _decoded_bboxes = make_shared_blob<float>({Precision::FP32, bboxes_size, NCHW});
-            _decoded_bboxes->allocate();
+            _decoded_bboxes = makeScratchBlob<float>({Precision::FP32, bboxes_size, NCHW});
 
             SizeVector buf_size{static_cast<size_t>(_num),
                                                  static_cast<size_t>(_num_classes),
                                                  static_cast<size_t>(_num_priors)};
-            _buffer = make_shared_blob<int>({Precision::I32, buf_size, {buf_size, {0, 1, 2}}});
-            _buffer->allocate();
+            _buffer = makeScratchBlob<int>({Precision::I32, buf_size, {buf_size, {0, 1, 2}}});
 
             SizeVector indices_size{static_cast<size_t>(_num),
                                                      static_cast<size_t>(_num_classes),
                                                      static_cast<size_t>(_num_priors)};
-            _indices = make_shared_blob<int>(
+            _indices = makeScratchBlob<int>(
                     {Precision::I32, indices_size, {indices_size, {0, 1, 2}}});
-            _indices->allocate();
 
             SizeVector detections_size{static_cast<size_t>(_num * _num_classes)};
-            _detections_count = make_shared_blob<int>({Precision::I32, detections_size, C});
-            _detections_count->allocate();
+            _detections_count = makeScratchBlob<int>({Precision::I32, detections_size, C});
 
             SizeVector conf_size1 = { conf_size, 1 };
-            _reordered_conf = make_shared_blob<float>({Precision::FP32, conf_size1, ANY});
-            _reordered_conf->allocate();
+            _reordered_conf = makeScratchBlob<float>({Precision::FP32, conf_size1, ANY});
 
             SizeVector decoded_bboxes_size{static_cast<size_t>(_num),
                                                             static_cast<size_t>(_num_priors),
                                                             static_cast<size_t>(_num_classes)};
-            _bbox_sizes = make_shared_blob<float>(
+            _bbox_sizes = makeScratchBlob<float>(
                     {Precision::FP32, decoded_bboxes_size, {decoded_bboxes_size, {0, 1, 2}}});
-            _bbox_sizes->allocate();
 
             SizeVector num_priors_actual_size{static_cast<size_t>(_num)};
-            _num_priors_actual = make_shared_blob<int>({Precision::I32, num_priors_actual_size, C});
-            _num_priors_actual->allocate();
+            _num_priors_actual = makeScratchBlob<int>({Precision::I32, num_priors_actual_size, C});
         } catch (const InferenceEngineException& ex) {
             throw std::logic_error(std::string("Can't create detection output: ") + ex.what());
         }
@@ -304,6 +299,15 @@ public:
     }
 
 private:
+    /// @brief Scratch buffers are rewritten on every frame, so they are placed on huge pages if the demo enabled them
+    template <typename T>
+    static Blob::Ptr makeScratchBlob(const TensorDesc& desc) {
+        std::shared_ptr<IAllocator> allocator = hugePageBlobAllocator();
+        Blob::Ptr blob = allocator ? make_shared_blob<T>(desc, allocator) : make_shared_blob<T>(desc);
+        blob->allocate();
+        return blob;
+    }
+
     const int idx_location = 0;
     const int idx_confidence = 1;
     const int idx_priors = 2;
@@ -17,6 +17,7 @@
 #include <samples/common.hpp>
 #include <samples/slog.hpp>
 #include <samples/args_helper.hpp>
+#include <samples/huge_pages.hpp>
 #include "object_detection_demo_faster_rcnn.h"
 #include "detectionoutput.h"
 
@@ -61,6 +62,7 @@ int main(int argc, char *argv[]) {
         if (!ParseAndCheckCommandLine(argc, argv)) {
             return 0;
         }
+        enableHugePages(FLAGS_huge_pages);
 
         /** This vector stores paths to the processed images **/
         std::vector<std::string> images;
@@ -276,6 +278,7 @@ int main(int argc, char *argv[]) {
         // --------------------------- 5. Create infer request -------------------------------------------------
         slog::info << "Create infer request" << slog::endl;
         InferRequest infer_request = executable_network.CreateInferRequest();
+        allocateInputsOnHugePages(infer_request, executable_network.GetInputsInfo());
         // -----------------------------------------------------------------------------------------------------
 
         // --------------------------- 6. Prepare input --------------------------------------------------------
@@ -410,6 +413,9 @@ int main(int argc, char *argv[]) {
                 throw std::logic_error(std::string("Can't create a file: ") + image_path);
             }
         }
+        if (!FLAGS_huge_pages.empty()) {
+            slog::info << "Memory: " << HugePageArena::instance().report() << slog::endl;
+        }
         // -----------------------------------------------------------------------------------------------------
     }
     catch (const std::exception& error) {
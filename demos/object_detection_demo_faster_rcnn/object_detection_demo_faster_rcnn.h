@@ -83,6 +83,15 @@ DEFINE_string(prob_name, "cls_prob", prob_layer_name_message);
 /// @brief Enable plugin messages
 DEFINE_bool(p_msg, false, plugin_message);
 
+/// @brief message for huge pages mode
+static const char huge_pages_message[] = "Optional. Allocate input tensors and detection output scratch buffers on huge pages "
+"local to the NUMA node of the allocating thread. \"thp\" uses transparent huge pages, \"explicit\" uses the pages "
+"reserved in /proc/sys/vm/nr_hugepages and falls back to transparent ones. Supported on Linux only.";
+
+/// @brief Define parameter for huge pages mode <br>
+/// It is an optional parameter
+DEFINE_string(huge_pages, "", huge_pages_message);
+
 /**
 * @brief This function show a help message
 */
@@ -101,4 +110,5 @@ static void showUsage() {
     std::cout << "    -proposal_name \"<string>\" " << proposal_layer_name_message << std::endl;
     std::cout << "    -prob_name \"<string>\"     " << prob_layer_name_message << std::endl;
     std::cout << "    -p_msg                    " << plugin_message << std::endl;
+    std::cout << "    -huge_pages \"<mode>\"      " << huge_pages_message << std::endl;
 }
@@ -19,6 +19,7 @@
 
 #include <inference_engine.hpp>
 
+#include <samples/huge_pages.hpp>
 #include <samples/ocv_common.hpp>
 #include <samples/slog.hpp>
 
@@ -70,6 +71,7 @@ int main(int argc, char *argv[]) {
         if (!ParseAndCheckCommandLine(argc, argv)) {
             return 0;
         }
+        enableHugePages(FLAGS_huge_pages);
 
         slog::info << "Reading input" << slog::endl;
         cv::VideoCapture cap;
@@ -213,6 +215,10 @@ int main(int argc, char *argv[]) {
         // --------------------------- 5. Create infer request -------------------------------------------------
         InferRequest::Ptr async_infer_request_curr = network.CreateInferRequestPtr();
         InferRequest::Ptr async_infer_request_next = network.CreateInferRequestPtr();
+        if (!FLAGS_auto_resize) {  // otherwise frames are wrapped into the input blobs
+            allocateInputsOnHugePages(*async_infer_request_curr, network.GetInputsInfo());
+            allocateInputsOnHugePages(*async_infer_request_next, network.GetInputsInfo());
+        }
 
         /* it's enough just to set image info input (if used in the model) only once */
         if (!imageInfoInputName.empty()) {
@@ -378,6 +384,9 @@ int main(int argc, char *argv[]) {
         auto total_t1 = std::chrono::high_resolution_clock::now();
         ms total = std::chrono::duration_cast<ms>(total_t1 - total_t0);
         std::cout << "Total Inference time: " << total.count() << std::endl;
+        if (!FLAGS_huge_pages.empty()) {
+            std::cout << "Memory: " << HugePageArena::instance().report() << std::endl;
+        }
 
         /** Show performace results **/
         if (FLAGS_pc) {
@@ -43,6 +43,11 @@ static const char raw_output_message[] = "Optional. Inference results as raw val
 /// @brief message resizable input flag
 static const char input_resizable_message[] = "Optional. Enables resizable input with support of ROI crop & auto resize.";
 
+/// @brief message for huge pages
+static const char huge_pages_message[] = "Optional. Allocate frames and input tensors on huge pages local to the NUMA node " \
+"of the allocating thread. \"thp\" uses transparent huge pages, \"explicit\" uses the pages reserved in " \
+"/proc/sys/vm/nr_hugepages and falls back to transparent ones. Supported on Linux only.";
+
 
 /// \brief Define flag for showing help message <br>
 DEFINE_bool(h, false, help_message);
@@ -81,6 +86,10 @@ DEFINE_double(t, 0.5, thresh_output_message);
 /// It is an optional parameter
 DEFINE_bool(auto_resize, false, input_resizable_message);
 
+/// \brief Defines the huge pages mode<br>
+/// It is an optional parameter
+DEFINE_string(huge_pages, "", huge_pages_message);
+
 
 /**
 * \brief This function show a help message
@@ -101,4 +110,5 @@ static void showUsage() {
     std::cout << "    -r                        " << raw_output_message << std::endl;
     std::cout << "    -t                        " << thresh_output_message << std::endl;
     std::cout << "    -auto_resize              " << input_resizable_message << std::endl;
+    std::cout << "    -huge_pages \"<mode>\"      " << huge_pages_message << std::endl;
 }
@@ -11,6 +11,7 @@
 #include <functional>
 
 #include <samples/ocv_common.hpp>
+#include <samples/memory_usage.hpp>
 
 #include <inference_engine.hpp>
 
@@ -41,7 +42,7 @@ public:
      * @brief Constructor
      */
     CnnBase(const Config& config,
-            const InferenceEngine::Core & ie,
+            InferenceEngine::Core& ie,
             const std::string & deviceName);
 
     /**
@@ -80,8 +81,8 @@ protected:
 
     /** @brief Config */
     Config config_;
-    /** @brief Inference Engine instance */
-    InferenceEngine::Core ie_;
+    /** @brief Inference Engine instance shared by all networks of the process */
+    InferenceEngine::Core& ie_;
     /** @brief Inference Engine device */
     std::string deviceName_;
     /** @brief Net outputs info */
@@ -99,7 +100,7 @@ protected:
 class VectorCNN : public CnnBase {
 public:
     VectorCNN(const CnnConfig& config,
-              const InferenceEngine::Core & ie,
+              InferenceEngine::Core& ie,
               const std::string & deviceName);
 
     void Compute(const cv::Mat& image,
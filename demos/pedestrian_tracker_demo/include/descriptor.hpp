@@ -114,7 +114,7 @@ private:
 
 public:
     DescriptorIE(const CnnConfig& config,
-                 const InferenceEngine::Core& ie,
+                 InferenceEngine::Core& ie,
                  const std::string & deviceName):
         handler(config, ie, deviceName) {}
 
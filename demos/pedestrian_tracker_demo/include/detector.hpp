@@ -31,7 +31,7 @@ class ObjectDetector {
 private:
     InferenceEngine::InferRequest::Ptr request;
     DetectorConfig config_;
-    InferenceEngine::Core ie_;
+    InferenceEngine::Core& ie_;
     std::string deviceName_;
 
     InferenceEngine::ExecutableNetwork net_;
@@ -54,7 +54,7 @@ private:
 
 public:
     ObjectDetector(const DetectorConfig& config,
-                   const InferenceEngine::Core& ie,
+                   InferenceEngine::Core& ie,
                    const std::string & deviceName);
 
     void submitFrame(const cv::Mat &frame, int frame_idx);
@@ -6,6 +6,7 @@
 
 #include "core.hpp"
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -281,6 +282,10 @@ public:
 
     ///
     /// \brief Draws active tracks on a given frame.
+    /// The trails are kept in a persistent overlay where only the segments
+    /// added since the previous call are drawn, so the cost does not grow with
+    /// the track length. The segments of dead and trimmed tracks are erased
+    /// in the same call, the area they covered is redrawn from the active tracks.
     /// \param[in] frame Colored image (CV_8UC3).
     /// \return Colored image with drawn active tracks.
     ///
@@ -516,5 +521,26 @@ private:
     std::vector<cv::Scalar> colors_;
 
     uint64_t prev_timestamp_;
+
+    // Trail of a track drawn on the overlay.
+    struct DrawnTrail {
+        // Timestamps and centers of the drawn objects of the track.
+        std::deque<std::pair<uint64_t, cv::Point>> points;
+    };
+
+    // Draws the segments of the track trail added after the last drawn object.
+    void DrawNewTrailSegments(size_t track_id, DrawnTrail *trail);
+
+    // Clears the area of the overlay and redraws the segments of the drawn trails in it.
+    void RedrawTrails(cv::Rect area);
+
+    // Persistent overlay with the trails of the active tracks.
+    cv::Mat trails_;
+
+    // Mask of the pixels covered by the trails.
+    cv::Mat trails_mask_;
+
+    // Trails drawn on the overlay by track ID.
+    std::unordered_map<size_t, DrawnTrail> drawn_trails_;
 };
 
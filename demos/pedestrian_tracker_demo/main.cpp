@@ -27,7 +27,7 @@ using ImageWithFrameIndex = std::pair<cv::Mat, int>;
 std::unique_ptr<PedestrianTracker>
 CreatePedestrianTracker(const std::string& reid_model,
                         const std::string& reid_weights,
-                        const InferenceEngine::Core & ie,
+                        InferenceEngine::Core& ie,
                         const std::string & deviceName,
                         bool should_keep_tracking_info) {
     TrackerParams params;
@@ -18,11 +18,12 @@
 using namespace InferenceEngine;
 
 CnnBase::CnnBase(const Config& config,
-                 const InferenceEngine::Core & ie,
+                 InferenceEngine::Core& ie,
                  const std::string & deviceName) :
     config_(config), ie_(ie), deviceName_(deviceName) {}
 
 void CnnBase::Load() {
+    ModelMemoryReport memoryReport(config_.path_to_model);
     CNNNetReader net_reader;
     net_reader.ReadNetwork(config_.path_to_model);
     net_reader.ReadWeights(config_.path_to_weights);
@@ -94,7 +95,7 @@ void CnnBase::Infer(const cv::Mat& frame,
 }
 
 VectorCNN::VectorCNN(const Config& config,
-                     const InferenceEngine::Core& ie,
+                     InferenceEngine::Core& ie,
                      const std::string & deviceName)
     : CnnBase(config, ie, deviceName) {
     Load();
@@ -86,11 +86,12 @@ void ObjectDetector::submitFrame(const cv::Mat &frame, int frame_idx) {
 
 ObjectDetector::ObjectDetector(
     const DetectorConfig& config,
-    const InferenceEngine::Core & ie,
+    InferenceEngine::Core& ie,
     const std::string & deviceName) :
     config_(config),
     ie_(ie),
     deviceName_(deviceName) {
+    ModelMemoryReport memoryReport(config.path_to_model);
     CNNNetReader net_reader;
     net_reader.ReadNetwork(config.path_to_model);
     net_reader.ReadWeights(config.path_to_weights);
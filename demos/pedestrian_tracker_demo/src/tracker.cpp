@@ -73,6 +73,27 @@ std::vector<cv::Scalar> GenRandomColors(int colors_num) {
     return colors;
 }
 
+const int kTrailWidth = 5;
+
+// Bounding rectangle of the pixels of a trail segment.
+cv::Rect SegmentRect(const cv::Point &from, const cv::Point &to) {
+    cv::Rect rect(from, to);
+    return cv::Rect(rect.x - kTrailWidth, rect.y - kTrailWidth,
+                    rect.width + 2 * kTrailWidth + 1, rect.height + 2 * kTrailWidth + 1);
+}
+
+cv::Rect Union(const cv::Rect &a, const cv::Rect &b) {
+    return a.area() == 0 ? b : (b.area() == 0 ? a : (a | b));
+}
+
+// Draws a trail segment clipped to the area of the overlay.
+void DrawTrailSegment(const cv::Point &from, const cv::Point &to, const cv::Scalar &color,
+                      const cv::Rect &area, cv::Mat *trails, cv::Mat *trails_mask) {
+    cv::Mat trails_area = (*trails)(area), mask_area = (*trails_mask)(area);
+    cv::line(trails_area, from - area.tl(), to - area.tl(), color, kTrailWidth);
+    cv::line(mask_area, from - area.tl(), to - area.tl(), cv::Scalar(255), kTrailWidth);
+}
+
 }  // anonymous namespace
 
 TrackerParams::TrackerParams()
@@ -538,6 +559,13 @@ void PedestrianTracker::DropForgottenTracks() {
     active_track_ids_.swap(new_active_tracks);
 
     tracks_counter_ = reassign_id ? counter : tracks_counter_;
+
+    if (reassign_id) {
+        // The drawn trails are keyed and colored by track ID, the overlay is redrawn from scratch
+        drawn_trails_.clear();
+        trails_.release();
+        trails_mask_.release();
+    }
 }
 
 void PedestrianTracker::DropForgottenTrack(size_t track_id) {
@@ -866,26 +894,103 @@ TrackedObjects PedestrianTracker::TrackedDetections() const {
     return detections;
 }
 
-cv::Mat PedestrianTracker::DrawActiveTracks(const cv::Mat &frame) {
-    cv::Mat out_frame = frame.clone();
+void PedestrianTracker::DrawNewTrailSegments(size_t track_id, DrawnTrail *trail) {
+    const auto &objects = tracks().at(track_id).objects;
+    const cv::Scalar &color = colors_[track_id % colors_.size()];
+    const cv::Rect frame_rect(cv::Point(), trails_.size());
+    auto &points = trail->points;
 
+    size_t first_new = objects.size();
+    while (first_new > 0 && (points.empty() || objects[first_new - 1].timestamp > points.back().first)) {
+        first_new--;
+    }
+    for (size_t i = first_new; i < objects.size(); i++) {
+        cv::Point center = Center(objects[i].rect);
+        if (!points.empty()) {
+            DrawTrailSegment(points.back().second, center, color, frame_rect, &trails_, &trails_mask_);
+        }
+        points.emplace_back(objects[i].timestamp, center);
+    }
+}
+
+void PedestrianTracker::RedrawTrails(cv::Rect area) {
+    area &= cv::Rect(cv::Point(), trails_.size());
+    if (area.area() == 0) {
+        return;
+    }
+    trails_(area).setTo(cv::Scalar::all(0));
+    trails_mask_(area).setTo(cv::Scalar::all(0));
+    for (const auto &drawn : drawn_trails_) {
+        const cv::Scalar &color = colors_[drawn.first % colors_.size()];
+        const auto &points = drawn.second.points;
+        for (size_t i = 1; i < points.size(); i++) {
+            const cv::Point &from = points[i - 1].second, &to = points[i].second;
+            if ((SegmentRect(from, to) & area).area() > 0) {
+                DrawTrailSegment(from, to, color, area, &trails_, &trails_mask_);
+            }
+        }
+    }
+}
+
+cv::Mat PedestrianTracker::DrawActiveTracks(const cv::Mat &frame) {
     if (colors_.empty()) {
         int num_colors = 100;
         colors_ = GenRandomColors(num_colors);
     }
 
-    auto active_tracks = GetActiveTracks();
-    for (auto active_track : active_tracks) {
-        size_t idx = active_track.first;
-        auto centers = active_track.second;
-        DrawPolyline(centers, colors_[idx % colors_.size()], &out_frame);
+    std::vector<size_t> active_ids;
+    for (size_t idx : active_track_ids()) {
+        if (IsTrackValid(idx) && !IsTrackForgotten(idx)) {
+            active_ids.push_back(idx);
+        }
+    }
+
+    if (trails_.size() != frame.size()) {
+        trails_.create(frame.size(), CV_8UC3);
+        trails_mask_.create(frame.size(), CV_8UC1);
+        trails_.setTo(cv::Scalar::all(0));
+        trails_mask_.setTo(cv::Scalar::all(0));
+        drawn_trails_.clear();
+    }
+
+    // The segments of the dead tracks and the ones trimmed from the beginning
+    // of the tracks are erased, the area they covered is redrawn.
+    cv::Rect stale_area;
+    for (auto it = drawn_trails_.begin(); it != drawn_trails_.end();) {
+        auto &points = it->second.points;
+        bool active = std::binary_search(active_ids.begin(), active_ids.end(), it->first);
+        uint64_t first_timestamp = active ? tracks().at(it->first).objects.front().timestamp
+                                          : std::numeric_limits<uint64_t>::max();
+        while (!points.empty() && points.front().first < first_timestamp) {
+            if (points.size() > 1) {
+                stale_area = Union(stale_area, SegmentRect(points[0].second, points[1].second));
+            }
+            points.pop_front();
+        }
+        if (!active) {
+            it = drawn_trails_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    RedrawTrails(stale_area);
+
+    for (size_t idx : active_ids) {
+        DrawNewTrailSegments(idx, &drawn_trails_[idx]);
+    }
+
+    cv::Mat out_frame = frame.clone();
+    trails_.copyTo(out_frame, trails_mask_);
+
+    for (size_t idx : active_ids) {
+        const auto &track = tracks().at(idx);
+        cv::Point last_center = Center(track.objects.back().rect);
         std::stringstream ss;
         ss << idx;
-        cv::putText(out_frame, ss.str(), centers.back(), cv::FONT_HERSHEY_SCRIPT_COMPLEX, 2.0,
+        cv::putText(out_frame, ss.str(), last_center, cv::FONT_HERSHEY_SCRIPT_COMPLEX, 2.0,
                     colors_[idx % colors_.size()], 3);
-        auto track = tracks().at(idx);
         if (track.lost) {
-            cv::line(out_frame, active_track.second.back(),
+            cv::line(out_frame, last_center,
                      Center(track.predicted_rect), cv::Scalar(0, 0, 0), 4);
         }
     }
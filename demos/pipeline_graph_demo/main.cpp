@@ -0,0 +1,137 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+/**
+* \brief The entry point for the Inference Engine pipeline_graph demo application
+* \file pipeline_graph_demo/main.cpp
+* \example pipeline_graph_demo/main.cpp
+*/
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <inference_engine.hpp>
+
+#include <samples/common.hpp>
+#include <samples/pipeline_graph.hpp>
+#include <samples/pipeline_stages.hpp>
+#include <samples/slog.hpp>
+#include <samples/thread_budget.hpp>
+
+#include "pipeline_graph_demo.hpp"
+#include <ext_list.hpp>
+
+using namespace InferenceEngine;
+
+namespace {
+
+bool ParseAndCheckCommandLine(int argc, char *argv[]) {
+    // ---------------------------Parsing and validation of input args--------------------------------------
+    gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+    if (FLAGS_h) {
+        showUsage();
+        showAvailableDevices();
+        return false;
+    }
+    slog::info << "Parsing input parameters" << slog::endl;
+
+    if (FLAGS_g.empty()) {
+        throw std::logic_error("Parameter -g is not set");
+    }
+    return true;
+}
+
+std::string directoryOf(const std::string& path) {
+    const std::size_t pos = path.find_last_of("/\\");
+    return std::string::npos == pos ? "." : path.substr(0, pos);
+}
+
+// Counts the network stages of the graph inferred on the CPU, they share the inference threads of the budget
+unsigned cpuNetworksNumber(const std::string& description) {
+    cv::FileStorage fs(description, cv::FileStorage::READ);
+    const cv::FileNode stagesNode = fs["stages"];
+    unsigned networks = 0;
+    for (cv::FileNodeIterator it = stagesNode.begin(); it != stagesNode.end(); ++it) {
+        const cv::FileNode stage = *it;
+        const std::string device = stage["device"].empty() ? "CPU" : static_cast<std::string>(stage["device"]);
+        if (!stage["model"].empty() && std::string::npos != device.find("CPU")) {
+            networks++;
+        }
+    }
+    return std::max(networks, 1u);
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    try {
+        std::cout << "InferenceEngine: " << GetInferenceEngineVersion() << std::endl;
+
+        // ------------------------------ Parsing and validation of input args ---------------------------------
+        if (!ParseAndCheckCommandLine(argc, argv)) {
+            return 0;
+        }
+
+        std::unique_ptr<ThreadBudget> threadBudget;
+        if (!FLAGS_thread_budget.empty()) {
+            threadBudget.reset(new ThreadBudget(FLAGS_thread_budget));
+            threadBudget->configureOpenCV();
+            slog::info << "Thread budget: " << threadBudget->toString() << slog::endl;
+        }
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 1. Load inference engine -------------------------------------
+        slog::info << "Loading Inference Engine" << slog::endl;
+        Core ie;
+
+        ie.AddExtension(std::make_shared<Extensions::Cpu::CpuExtensions>(), "CPU");
+        if (!FLAGS_l.empty()) {
+            // CPU(MKLDNN) extensions are loaded as a shared library and passed as a pointer to base extension
+            IExtensionPtr extension_ptr = make_so_pointer<IExtension>(FLAGS_l.c_str());
+            ie.AddExtension(extension_ptr, "CPU");
+        }
+        if (!FLAGS_c.empty()) {
+            // clDNN Extensions are loaded from an .xml description and OpenCL kernel files
+            ie.SetConfig({{PluginConfigParams::KEY_CONFIG_FILE, FLAGS_c}}, "GPU");
+        }
+        if (threadBudget) {
+            threadBudget->configurePlugin(ie, cpuNetworksNumber(FLAGS_g));
+        }
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 2. Build the graph ------------------------------------------------------
+        slog::info << "Reading the graph " << FLAGS_g << slog::endl;
+        pipeline::StageFactory factory;
+        pipeline::addBuiltinStages(factory, ie, FLAGS_i, directoryOf(FLAGS_g));
+        pipeline::Graph graph(FLAGS_g, factory, threadBudget.get());
+        // -----------------------------------------------------------------------------------------------------
+
+        // --------------------------- 3. Run the graph --------------------------------------------------------
+        slog::info << "Start processing with " << graph.threadsNumber() << " threads" << slog::endl;
+        slog::info << "Press Esc or Q in a display window to stop" << slog::endl;
+        graph.run();
+
+        std::cout << std::endl;
+        graph.report(std::cout);
+        if (threadBudget) {
+            slog::info << "CPU utilization: " << threadBudget->utilizationReport() << slog::endl;
+        }
+        // -----------------------------------------------------------------------------------------------------
+    }
+    catch (const std::exception& error) {
+        slog::err << error.what() << slog::endl;
+        return 1;
+    }
+    catch (...) {
+        slog::err << "Unknown/internal exception happened." << slog::endl;
+        return 1;
+    }
+
+    slog::info << "Execution successful" << slog::endl;
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2019 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <string>
+#include <vector>
+#include <gflags/gflags.h>
+#include <iostream>
+
+/// @brief message for help argument
+static const char help_message[] = "Print a usage message.";
+
+/// @brief message for graph argument
+static const char graph_message[] = "Required. Path to a .json or .yml file with the pipeline graph description. "
+"Relative model paths of the graph are resolved against the directory of the file.";
+
+/// @brief message for video argument
+static const char video_message[] = "Optional. Path to a video file or a camera index for the video sources of the graph "
+"which do not specify their own input.";
+
+/// @brief message for clDNN custom kernels desc
+static const char custom_cldnn_message[] = "Required for GPU custom kernels. "\
+"Absolute path to the .xml file with the kernels descriptions.";
+
+/// @brief message for user library argument
+static const char custom_cpu_library_message[] = "Required for CPU custom layers. " \
+"Absolute path to a shared library with the kernels implementations.";
+
+/// @brief Message for thread budget
+static const char thread_budget_message[] = "Optional. Split CPU cores between the pipeline stages, " \
+"for example \"capture:2,preprocessing:2,inference:16,postprocessing:4\". " \
+"Partitions which are not listed get one thread, inference gets the rest of the cores, " \
+"which are split between the networks loaded to the CPU.";
+
+/// \brief Define flag for showing help message <br>
+DEFINE_bool(h, false, help_message);
+
+/// \brief Define parameter for graph description file <br>
+/// It is a required parameter
+DEFINE_string(g, "", graph_message);
+
+/// \brief Define parameter for the default input of video sources <br>
+/// It is an optional parameter
+DEFINE_string(i, "", video_message);
+
+/// @brief clDNN custom kernels path <br>
+/// Default is ./lib
+DEFINE_string(c, "", custom_cldnn_message);
+
+/// @brief Absolute path to CPU library with user layers <br>
+/// It is a optional parameter
+DEFINE_string(l, "", custom_cpu_library_message);
+
+/// \brief Define parameter for thread budget <br>
+/// It is an optional parameter
+DEFINE_string(thread_budget, "", thread_budget_message);
+
+
+/**
+* \brief This function show a help message
+*/
+static void showUsage() {
+    std::cout << std::endl;
+    std::cout << "pipeline_graph_demo [OPTION]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << std::endl;
+    std::cout << "    -h                        " << help_message << std::endl;
+    std::cout << "    -g \"<path>\"               " << graph_message << std::endl;
+    std::cout << "    -i \"<path>\"               " << video_message << std::endl;
+    std::cout << "      -l \"<absolute_path>\"    " << custom_cpu_library_message << std::endl;
+    std::cout << "          Or" << std::endl;
+    std::cout << "      -c \"<absolute_path>\"    " << custom_cldnn_message << std::endl;
+    std::cout << "    -thread_budget \"<budget>\" " << thread_budget_message << std::endl;
+}
@@ -16,6 +16,7 @@
 """
 
 import os
+import itertools
 import logging
 
 import numpy as np
@@ -92,6 +93,15 @@ def parse_arguments():
     args.add_argument('-c', '--path_to_cldnn_config', type=str, required=False,
                         help="Required for GPU custom kernels. "
                              "Absolute path to an .xml file with the kernels description.")
+    args.add_argument('-sw', '--sliding_window', default=False, action='store_true',
+                        help="Optional. Infer NIfTI data of native resolution by overlapping patches of the network "
+                             "input size instead of resampling it to the input size")
+    args.add_argument('-ov', '--overlap', type=float, required=False, default=0.5,
+                        help="Optional. Overlap of neighbouring patches in sliding window mode, "
+                             "a share of the patch size in [0, 1)")
+    args.add_argument('-nireq', '--number_infer_requests', type=int, required=False, default=2,
+                        help="Optional. Number of infer requests to infer patches in parallel in sliding window mode. "
+                             "On CPU each request runs in its own stream")
     return parser.parse_args()
 
 
@@ -153,6 +163,91 @@ def resample_np(data, output_shape, order):
     return interpolation.zoom(data, zoom=factor, order=order)
 
 
+def patch_starts(size, patch_size, stride):
+    if size <= patch_size:
+        return [0]
+    return list(range(0, size - patch_size, stride)) + [size - patch_size]
+
+
+def gaussian_importance_map(patch_size, sigma_scale=1. / 8):
+    weights = np.ones(patch_size, dtype=np.float32)
+    for axis, size in enumerate(patch_size):
+        coords = np.arange(size, dtype=np.float32) - (size - 1) / 2.
+        shape = [1] * len(patch_size)
+        shape[axis] = size
+        weights *= np.exp(-coords ** 2 / (2 * (size * sigma_scale) ** 2)).reshape(shape)
+    weights /= weights.max()
+    # the border voxels of the volume are covered by patch borders only, keep them from division by zero
+    return np.maximum(weights, 1e-3)
+
+
+def infer_sliding_window(executable_network, input_name, out_name, data, patch_size, batch_size, overlap):
+    """
+    Infers overlapping patches of the volume on all infer requests of the network and blends the patch logits
+    with Gaussian weights, so the patch centers outweigh the less reliable patch borders.
+    Only the logits and weights of the volume and one batch of patches for each request are held in memory.
+    Returns: logits of the volume (channels x volume size)
+    """
+    channels = data.shape[1]
+    volume_size = data.shape[2:]
+    padded_size = tuple(max(size, patch) for size, patch in zip(volume_size, patch_size))
+    if padded_size != volume_size:
+        padded = np.zeros((1, channels) + padded_size, dtype=np.float32)
+        padded[:, :, :volume_size[0], :volume_size[1], :volume_size[2]] = data
+        data = padded
+
+    strides = [max(1, int(patch * (1 - overlap))) for patch in patch_size]
+    positions = list(itertools.product(*[
+        patch_starts(size, patch, stride) for size, patch, stride in zip(padded_size, patch_size, strides)
+    ]))
+    logger.info("Volume {} is split into {} patches {}".format(volume_size, len(positions), tuple(patch_size)))
+
+    importance = gaussian_importance_map(patch_size)
+    weights = np.zeros(padded_size, dtype=np.float32)
+    logits = None
+    requests = executable_network.requests
+    in_flight = [None] * len(requests)  # positions of the patches of the batch inferred by the request
+
+    def patch_region(position):
+        return tuple(slice(start, start + size) for start, size in zip(position, patch_size))
+
+    def accumulate(request_id):
+        nonlocal logits
+        request = requests[request_id]
+        request.wait(-1)
+        output = request.outputs[out_name]
+        if tuple(output.shape[2:]) != tuple(patch_size):
+            raise AttributeError("Sliding window mode requires the network output of the input size, "
+                                 "but output shape is {}".format(output.shape))
+        if logits is None:
+            logits = np.zeros((output.shape[1],) + padded_size, dtype=np.float32)
+        for patch, position in zip(output, in_flight[request_id]):
+            region = patch_region(position)
+            logits[(slice(None),) + region] += patch * importance
+            weights[region] += importance
+        in_flight[request_id] = None
+
+    patches = np.zeros((batch_size, channels) + tuple(patch_size), dtype=np.float32)
+    for batch_id, first in enumerate(range(0, len(positions), batch_size)):
+        request_id = batch_id % len(requests)
+        if in_flight[request_id] is not None:
+            accumulate(request_id)
+
+        batch_positions = positions[first:first + batch_size]
+        patches.fill(0)
+        for patch_id, position in enumerate(batch_positions):
+            patches[patch_id] = data[(0, slice(None)) + patch_region(position)]
+        in_flight[request_id] = batch_positions
+        requests[request_id].async_infer({input_name: patches})
+
+    for request_id, batch_positions in enumerate(in_flight):
+        if batch_positions is not None:
+            accumulate(request_id)
+
+    logits /= weights
+    return logits[:, :volume_size[0], :volume_size[1], :volume_size[2]]
+
+
 def read_image(test_data_path, series_name, sizes=(128, 128, 128)):
     images_list = []
     handle = None
@@ -176,10 +271,9 @@ def read_image(test_data_path, series_name, sizes=(128, 128, 128)):
     bbox[1] = bbox_max
 
     data = np.concatenate(images_list, axis=1)
-    data_crop = resample_np(
-        data[:, :, bbox_min[0]:bbox_max[0], bbox_min[1]:bbox_max[1], bbox_min[2]:bbox_max[2]],
-        (1, len(DATA_SUFFIXES),) + sizes,
-        1)
+    data_crop = data[:, :, bbox_min[0]:bbox_max[0], bbox_min[1]:bbox_max[1], bbox_min[2]:bbox_max[2]]
+    if sizes is not None:
+        data_crop = resample_np(data_crop, (1, len(DATA_SUFFIXES),) + sizes, 1)
 
     bbox_ret = [
         bbox_min[0], bbox_max[0],
@@ -202,6 +296,8 @@ def main():
             ie.add_extension(args.path_to_extension, "CPU")
         if args.number_threads is not None:
             ie.set_config({'CPU_THREADS_NUM': str(args.number_threads)}, "CPU")
+        if args.sliding_window:
+            ie.set_config({'CPU_THROUGHPUT_STREAMS': str(args.number_infer_requests)}, "CPU")
     elif 'GPU' in args.target_device:
         if args.path_to_cldnn_config:
             ie.set_config({'CONFIG_FILE':  args.path_to_cldnn_config}, "GPU")
@@ -250,10 +346,19 @@ def main():
 
     is_nifti_data = os.path.isdir(args.path_to_input_data)
 
+    if args.sliding_window:
+        if not is_nifti_data:
+            raise AttributeError("Sliding window mode is supported for NIfTI data only")
+        if not 0 <= args.overlap < 1:
+            raise AttributeError("Overlap {} is out of [0, 1) range".format(args.overlap))
+        if args.number_infer_requests < 1:
+            raise AttributeError("Number of infer requests must be positive")
+
     if is_nifti_data:
         series_name = find_series_name(args.path_to_input_data)
         original_data, data_crop, affine, original_size, bbox = \
-            read_image(args.path_to_input_data, series_name=series_name, sizes=(h, w, d))
+            read_image(args.path_to_input_data, series_name=series_name,
+                       sizes=None if args.sliding_window else (h, w, d))
 
     else:
         if not (fnmatch(args.path_to_input_data, '*.tif') or fnmatch(args.path_to_input_data, '*.tiff')):
@@ -272,20 +377,30 @@ def main():
 
     # ------------------------------------- 4. Loading model to the plugin -------------------------------------
     logger.info("Loading model to the plugin")
-    executable_network = ie.load_network(network=ie_network, device_name=args.target_device)
+    num_requests = args.number_infer_requests if args.sliding_window else 1
+    executable_network = ie.load_network(network=ie_network, device_name=args.target_device,
+                                         num_requests=num_requests)
     del ie_network
 
     # ---------------------------------------------- 5. Do inference --------------------------------------------
     logger.info("Start inference")
     start_time = datetime.now()
-    res = executable_network.infer(test_im)
+    if args.sliding_window:
+        # the patch axes follow the order of the resampled input
+        result = infer_sliding_window(executable_network, input_name, out_name, data_crop, (h, w, d), n,
+                                      args.overlap)[np.newaxis]
+    else:
+        res = executable_network.infer(test_im)
+        result = res[out_name]
     infer_time = datetime.now() - start_time
     logger.info("Finish inference")
     logger.info("Inference time is {}".format(infer_time))
 
     # ---------------------------- 6. Processing of the received inference results ------------------------------
-    result = res[out_name]
     batch, channels, out_d, out_h, out_w = result.shape
+    if args.sliding_window:
+        # all slices of the native resolution volume are saved
+        out_d = original_size[2]
 
     list_img = list()
     list_seg_result = list()
@@ -294,7 +409,10 @@ def main():
     start_time = datetime.now()
     for batch, data in enumerate(result):
         seg_result = np.zeros(shape=original_size, dtype=np.uint8)
-        if data.shape[1:] != original_size:
+        if args.sliding_window:
+            seg_result[bbox[0]:bbox[1], bbox[2]:bbox[3], bbox[4]:bbox[5]] = \
+                data[0] > 0.5 if channels == 1 else np.argmax(data, axis=0)
+        elif data.shape[1:] != original_size:
             x = bbox[1] - bbox[0]
             y = bbox[3] - bbox[2]
             z = bbox[5] - bbox[4]
@@ -335,7 +453,8 @@ def main():
 
     # --------------------------------------------- 7. Save output -----------------------------------------------
     tiff_output_name = os.path.join(args.path_to_output, 'output.tiff')
-    Image.new('RGB', (data.shape[3], data.shape[2])).save(tiff_output_name, append_images=list_img, save_all=True)
+    frame_size = (original_size[1], original_size[0]) if args.sliding_window else (data.shape[3], data.shape[2])
+    Image.new('RGB', frame_size).save(tiff_output_name, append_images=list_img, save_all=True)
     logger.info("Result tiff file was saved to {}".format(tiff_output_name))
 
     if args.output_nifti and is_nifti_data:
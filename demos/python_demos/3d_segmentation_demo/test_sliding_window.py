@@ -0,0 +1,146 @@
+"""
+ Copyright (c) 2019 Intel Corporation
+
+ Licensed under the Apache License, Version 2.0 (the "License");
+ you may not use this file except in compliance with the License.
+ You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+ Unless required by applicable law or agreed to in writing, software
+ distributed under the License is distributed on an "AS IS" BASIS,
+ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ See the License for the specific language governing permissions and
+ limitations under the License.
+"""
+
+import importlib.util
+import itertools
+import os
+import sys
+import types
+
+import numpy as np
+import pytest
+
+
+def stub_missing_module(name, **attributes):
+    try:
+        importlib.import_module(name)
+    except ImportError:
+        module = types.ModuleType(name)
+        module.__dict__.update(attributes)
+        sys.modules[name] = module
+
+
+# sliding window inference does not use the Inference Engine and image readers, the demo is loaded without them
+stub_missing_module('nibabel')
+stub_missing_module('openvino')
+stub_missing_module('openvino.inference_engine', IENetwork=None, IECore=None)
+
+spec = importlib.util.spec_from_file_location(
+    'segmentation_3d_demo', os.path.join(os.path.dirname(os.path.abspath(__file__)), '3d_segmentation_demo.py')
+)
+demo = importlib.util.module_from_spec(spec)
+spec.loader.exec_module(demo)
+
+
+class FakeRequest:
+    def __init__(self, out_name, model):
+        self.out_name = out_name
+        self.model = model
+        self.outputs = {}
+        self.pending = None
+
+    def async_infer(self, inputs):
+        # the demo reuses the input buffer for the next batch, so it is copied like the plugin does
+        self.pending = np.array(next(iter(inputs.values())))
+
+    def wait(self, timeout):
+        self.outputs = {self.out_name: self.model(self.pending)}
+        return 0
+
+
+class FakeNetwork:
+    def __init__(self, model, num_requests=2):
+        self.requests = [FakeRequest('out', model) for _ in range(num_requests)]
+
+
+def infer(model, data, patch_size, batch_size=2, overlap=0.5, num_requests=2):
+    return demo.infer_sliding_window(
+        FakeNetwork(model, num_requests), 'in', 'out', data, patch_size, batch_size, overlap
+    )
+
+
+class TestPatchStarts:
+    @pytest.mark.parametrize('size,patch_size,stride', [(10, 4, 2), (11, 4, 2), (13, 5, 3), (7, 7, 3), (100, 32, 16)])
+    def test_patches_cover_volume_up_to_last_edge(self, size, patch_size, stride):
+        starts = demo.patch_starts(size, patch_size, stride)
+
+        covered = np.zeros(size, dtype=bool)
+        for start in starts:
+            covered[start:start + patch_size] = True
+
+        assert covered.all()
+        assert starts[0] == 0
+        assert starts[-1] == size - patch_size
+        assert starts == sorted(set(starts))
+
+    def test_volume_smaller_than_patch_has_one_patch(self):
+        assert demo.patch_starts(3, 8, 4) == [0]
+
+
+class TestInferSlidingWindow:
+    def test_constant_logits_are_reproduced(self):
+        logits = np.array([0.5, -1., 2.], dtype=np.float32)
+
+        def constant_model(patches):
+            return np.broadcast_to(logits[:, None, None, None], (len(patches), 3, 4, 4, 4)).copy()
+
+        data = np.zeros((1, 1, 9, 7, 5), dtype=np.float32)
+
+        result = infer(constant_model, data, (4, 4, 4))
+
+        assert result.shape == (3, 9, 7, 5)
+        np.testing.assert_allclose(result, np.broadcast_to(logits[:, None, None, None], result.shape), rtol=1e-5)
+
+    def test_voxelwise_model_reproduces_argmax_of_volume_not_divisible_by_patch(self):
+        random_state = np.random.RandomState(0)
+        data = random_state.uniform(-1, 1, size=(1, 3, 11, 9, 7)).astype(np.float32)
+
+        result = infer(lambda patches: patches, data, (4, 4, 4), batch_size=3, overlap=0.3, num_requests=3)
+
+        assert result.shape == data.shape[1:]
+        np.testing.assert_allclose(result, data[0], rtol=1e-5, atol=1e-6)
+        np.testing.assert_array_equal(np.argmax(result, axis=0), np.argmax(data[0], axis=0))
+
+    def test_single_channel_threshold_is_reproduced_for_volume_smaller_than_patch(self):
+        random_state = np.random.RandomState(1)
+        data = random_state.uniform(0, 1, size=(1, 1, 3, 6, 5)).astype(np.float32)
+
+        result = infer(lambda patches: patches, data, (4, 4, 4), batch_size=1)
+
+        assert result.shape == (1, 3, 6, 5)
+        np.testing.assert_array_equal(result[0] > 0.5, data[0, 0] > 0.5)
+
+    def test_all_patch_batches_are_inferred(self):
+        seen = []
+
+        def recording_model(patches):
+            seen.append(len(patches))
+            return np.ones_like(patches)
+
+        data = np.zeros((1, 1, 10, 10, 10), dtype=np.float32)
+        result = infer(recording_model, data, (4, 4, 4), batch_size=4, overlap=0.5)
+
+        starts = demo.patch_starts(10, 4, 2)
+        positions = len(list(itertools.product(starts, starts, starts)))
+        assert len(seen) == (positions + 3) // 4
+        assert np.isfinite(result).all()
+        np.testing.assert_allclose(result, 1., rtol=1e-5)
+
+    def test_output_of_other_size_raises_error(self):
+        data = np.zeros((1, 1, 8, 8, 8), dtype=np.float32)
+
+        with pytest.raises(AttributeError):
+            infer(lambda patches: patches[:, :, :2, :2, :2], data, (4, 4, 4))
@@ -17,6 +17,55 @@
 import numpy as np
 
 
+# number of set bits of each byte value
+POPCOUNT = np.array([bin(value).count('1') for value in range(256)], dtype=np.uint8)
+
+
+class PackedMask(object):
+    """
+    Binary mask cropped to the bounding box of its pixels and packed to bits. The packed columns start from a byte
+    aligned image column, so bytes of different masks cover the same image columns and can be intersected directly.
+    """
+
+    def __init__(self, mask):
+        rows = np.flatnonzero(mask.max(axis=1))
+        if rows.size == 0:
+            self.box = None
+            self.area = 0
+            return
+        y0, y1 = rows[0], rows[-1] + 1
+        cols = np.flatnonzero(mask[y0:y1].max(axis=0))
+        x0, x1 = cols[0], cols[-1] + 1
+        # box of the pixels: y0, x0 and exclusive y1, x1
+        self.box = (y0, x0, y1, x1)
+        self.byte_x0 = x0 // 8
+        self.bits = np.packbits(mask[y0:y1, self.byte_x0 * 8:x1] > 0, axis=1)
+        self.area = int(POPCOUNT[self.bits].sum(dtype=np.int64))
+
+    def intersection(self, other):
+        if self.box is None or other.box is None:
+            return 0
+        y0 = max(self.box[0], other.box[0])
+        y1 = min(self.box[2], other.box[2])
+        x0 = max(self.box[1], other.box[1])
+        x1 = min(self.box[3], other.box[3])
+        if y0 >= y1 or x0 >= x1:
+            return 0
+        byte_x0 = x0 // 8
+        byte_x1 = (x1 + 7) // 8
+        # the bits outside of the own boxes are zeros, so the whole bytes of the overlap can be intersected
+        bits = self.crop(y0, y1, byte_x0, byte_x1) & other.crop(y0, y1, byte_x0, byte_x1)
+        return int(POPCOUNT[bits].sum(dtype=np.int64))
+
+    def crop(self, y0, y1, byte_x0, byte_x1):
+        rows = slice(y0 - self.box[0], y1 - self.box[0])
+        bits = self.bits[rows, byte_x0 - self.byte_x0:byte_x1 - self.byte_x0]
+        if bits.shape[1] < byte_x1 - byte_x0:
+            # the last byte of the overlap is beyond the packed columns
+            bits = np.pad(bits, ((0, 0), (0, byte_x1 - byte_x0 - bits.shape[1])), 'constant')
+        return bits
+
+
 class StaticIOUTracker(object):
     def __init__(self, iou_threshold=0.5, age_threshold=10):
         super().__init__()
@@ -30,20 +79,25 @@ class StaticIOUTracker(object):
         self.last_id = 0
 
     def affinity(self, masks, classes):
-        areas = [np.count_nonzero(mask) for mask in masks]
+        # Masks are intersected only inside of the overlap of their boxes.
+        areas = [mask.area for mask in masks]
         affinity_matrix = np.zeros((len(masks), len(self.history)), dtype=np.float32)
         for i, (history_mask, history_area, history_class) in \
                 enumerate(zip(self.history, self.history_areas, self.history_classes)):
             for j, (mask, area, cls) in enumerate(zip(masks, areas, classes)):
                 if cls != history_class:
                     continue
-                intersection = np.count_nonzero(np.logical_and(history_mask, mask))
+                intersection = history_mask.intersection(mask)
+                if intersection == 0:
+                    continue
                 union = history_area + area - intersection
                 iou = intersection / union
                 affinity_matrix[j, i] = iou
         return affinity_matrix, areas
 
     def __call__(self, masks, classes):
+        masks = [PackedMask(mask) for mask in masks]
+
         # Get affinity with history.
         affinity_matrix, areas = self.affinity(masks, classes)
 
@@ -18,6 +18,9 @@
 
 #include <opencv2/core/core.hpp>
 
+#include <samples/perf_sampler.hpp>
+#include <samples/thread_budget.hpp>
+
 class VideoFrame {  // VideoFrame can represent not a single image but the whole grid
 public:
     typedef std::shared_ptr<VideoFrame> Ptr;
@@ -39,6 +42,10 @@ public:
         sharedVideoFrame{sharedVideoFrame}, priority{priority} {}
     virtual bool isReady() = 0;
     virtual void process() = 0;
+    /// @brief The partition of the thread budget the CPU time of process() is accounted to
+    virtual ThreadBudget::Partition partition() const {
+        return ThreadBudget::POSTPROCESSING;
+    }
     virtual ~Task() = default;
 
     VideoFrame::Ptr sharedVideoFrame;  // it is possible that two tasks try to draw on the same cvMat
@@ -55,8 +62,8 @@ struct HigherPriority {
 
 class Worker {
 public:
-    explicit Worker(unsigned threadNum):
-        threadPull(threadNum), running{false} {}
+    explicit Worker(unsigned threadNum, ThreadBudget* threadBudget = nullptr):
+        threadPull(threadNum), running{false}, threadBudget{threadBudget} {}
     ~Worker() {
         stop();
     }
@@ -84,7 +91,12 @@ public:
                     const std::shared_ptr<Task> task = std::move(*it);
                     tasks.erase(it);
                     lk.unlock();
-                    task->process();
+                    if (nullptr != threadBudget) {
+                        ThreadBudget::ScopedCharge charge(*threadBudget, task->partition());
+                        task->process();
+                    } else {
+                        task->process();
+                    }
                 }
             } catch (...) {
                 std::lock_guard<std::mutex> lock{excpetionMutex};
@@ -114,6 +126,7 @@ private:
     std::mutex tasksMutex;
     std::vector<std::thread> threadPull;
     std::atomic<bool> running;
+    ThreadBudget* threadBudget;
     std::exception_ptr currentException;
     std::mutex excpetionMutex;
 };
@@ -12,12 +12,14 @@
 #include <utility>
 #include <vector>
 #include <set>
+#include <sstream>
 
 #include <inference_engine.hpp>
 #include <vpu/vpu_plugin_config.hpp>
 #include <ext_list.hpp>
 #include <samples/ocv_common.hpp>
 #include <samples/args_helper.hpp>
+#include <samples/degradation.hpp>
 
 #include "common.hpp"
 #include "grid_mat.hpp"
@@ -29,6 +31,29 @@ using namespace InferenceEngine;
 
 typedef std::chrono::duration<double, std::ratio<1, 1000>> ms;
 
+// Degradation steps of -degrade with the names of the levels they start
+const std::map<std::string, std::string> degradationSteps = {
+    {"resolution", "low detector resolution"},
+    {"classifiers", "classifiers on alternate frames"},
+    {"display", "low display rate"}
+};
+
+std::vector<std::string> parseDegradationSteps(const std::string& steps) {
+    std::vector<std::string> result;
+    std::istringstream stream(steps);
+    std::string step;
+    while (std::getline(stream, step, ',')) {
+        if (degradationSteps.end() == degradationSteps.find(step)) {
+            throw std::logic_error("Unknown degradation step \"" + step + "\" in -degrade, expected resolution, classifiers or display");
+        }
+        if (result.end() != std::find(result.begin(), result.end(), step)) {
+            throw std::logic_error("Degradation step \"" + step + "\" is repeated in -degrade");
+        }
+        result.push_back(step);
+    }
+    return result;
+}
+
 bool ParseAndCheckCommandLine(int argc, char *argv[]) {
     // ---------------------------Parsing and validation of input args--------------------------------------
     gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
@@ -50,6 +75,13 @@ bool ParseAndCheckCommandLine(int argc, char *argv[]) {
     if (FLAGS_n_wt == 0) {
         throw std::logic_error("-n_wt can not be zero");
     }
+    parseDegradationSteps(FLAGS_degrade);
+    if (FLAGS_degrade_scale <= 0 || FLAGS_degrade_scale > 1) {
+        throw std::logic_error("-degrade_scale must be in (0, 1]");
+    }
+    if (FLAGS_degrade_fps == 0) {
+        throw std::logic_error("-degrade_fps can not be zero");
+    }
     return true;
 }
 
@@ -109,7 +141,6 @@ struct Context {  // stores all global data for tasks
         nireq{nireq},
         isVideo{isVideo},
         t0{std::chrono::steady_clock::time_point()},
-        freeDetectionInfersCount{0},
         frameCounter{0}
     {
         assert(inputChannels.size() == gridParam.size());
@@ -153,6 +184,7 @@ struct Context {  // stores all global data for tasks
         std::vector<cv::Size> gridParam;
         cv::Size displayResolution;
         std::chrono::steady_clock::duration showPeriod;  // desiered frequency of imshow
+        std::chrono::steady_clock::duration degradedShowPeriod = std::chrono::steady_clock::duration::zero();
         std::weak_ptr<Worker> drawersWorker;
         int64_t lastShownframeId;
         std::chrono::steady_clock::time_point prevShow;  // time stamp of previous imshow
@@ -167,9 +199,34 @@ struct Context {  // stores all global data for tasks
     uint64_t nireq;
     bool isVideo;
     std::chrono::steady_clock::time_point t0;
-    std::atomic<std::vector<InferRequest>::size_type> freeDetectionInfersCount;
     std::atomic<uint64_t> frameCounter;
     InferRequestsContainer detectorsInfers, attributesInfers, platesInfers;
+    InferRequestsContainer lowResolutionDetectorsInfers;
+    // the pools of the detector resolutions are sampled separately, they are used at different degradation levels
+    struct InfersUsage {
+        std::atomic<std::vector<InferRequest>::size_type> freeCount{0};
+        std::atomic<uint64_t> samples{0};
+
+        void sample(InferRequestsContainer& infers) {
+            freeCount += infers.inferRequests.lockedSize();
+            samples++;
+        }
+
+        /** @brief Share of busy infer requests of the pool of nireq requests */
+        float usage(uint64_t nireq) const {
+            const uint64_t total = samples * nireq;
+            return 0 == total ? 0.f : static_cast<float>(total - freeCount) / total;
+        }
+    } detectionInfersUsage, lowResolutionDetectionInfersUsage;
+    PerfCountersSampler* perfSampler = nullptr;
+    std::unique_ptr<DegradationController> degradation;
+    std::map<std::string, std::size_t> degradationStepLevels;  // the level each of -degrade steps is applied from
+    std::atomic<std::size_t> framesWaitingForDetection{0};
+
+    bool isDegraded(const std::string& step) const {
+        auto it = degradationStepLevels.find(step);
+        return degradation && degradationStepLevels.end() != it && degradation->level() >= it->second;
+    }
 };
 
 class ReborningVideoFrame: public VideoFrame {
@@ -178,6 +235,10 @@ public:
         VideoFrame{sourceID, frameId, frame}, context(context) {}  // can not write context{context} because of CentOS 7.4 compiler bug
     virtual ~ReborningVideoFrame();
     Context& context;
+    // stage boundaries for the degradation controller
+    std::chrono::steady_clock::time_point captureTime;
+    std::chrono::steady_clock::time_point detectionStartTime;
+    std::chrono::steady_clock::time_point detectionEndTime;
 };
 
 class Drawer: public Task {  // accumulates and shows processed frames
@@ -233,31 +294,47 @@ private:
 
 class DetectionsProcessor: public Task {  // extracts detections from blob InferRequests and runs classifiers and recognisers
 public:
-    DetectionsProcessor(VideoFrame::Ptr sharedVideoFrame, InferRequest* inferRequest):
-        Task{sharedVideoFrame, 1.0}, inferRequest{inferRequest}, requireGettingNumberOfDetections{true} {}
+    DetectionsProcessor(VideoFrame::Ptr sharedVideoFrame, InferRequest* inferRequest, InferRequestsContainer* detectorsInfers):
+        Task{sharedVideoFrame, 1.0}, inferRequest{inferRequest}, detectorsInfers{detectorsInfers}, requireGettingNumberOfDetections{true},
+        runClassifiers{true} {}
     DetectionsProcessor(VideoFrame::Ptr sharedVideoFrame, std::shared_ptr<ClassifiersAggreagator>&& classifiersAggreagator, std::list<cv::Rect>&& vehicleRects,
     std::list<cv::Rect>&& plateRects):
-        Task{sharedVideoFrame, 1.0}, classifiersAggreagator{std::move(classifiersAggreagator)}, inferRequest{nullptr},
-        vehicleRects{std::move(vehicleRects)}, plateRects{std::move(plateRects)}, requireGettingNumberOfDetections{false} {}
+        Task{sharedVideoFrame, 1.0}, classifiersAggreagator{std::move(classifiersAggreagator)}, inferRequest{nullptr}, detectorsInfers{nullptr},
+        vehicleRects{std::move(vehicleRects)}, plateRects{std::move(plateRects)}, requireGettingNumberOfDetections{false}, runClassifiers{true} {}
     bool isReady() override;
     void process() override;
 
 private:
+    bool runAttributes() const {
+        return runClassifiers && !FLAGS_m_va.empty();
+    }
+    bool runLpr() const {
+        return runClassifiers && !FLAGS_m_lpr.empty();
+    }
+
     std::shared_ptr<ClassifiersAggreagator> classifiersAggreagator;  // when no one stores this object we will draw
     InferRequest* inferRequest;
+    InferRequestsContainer* detectorsInfers;  // the pool inferRequest is returned to
     std::list<cv::Rect> vehicleRects;
     std::list<cv::Rect> plateRects;
     std::vector<std::reference_wrapper<InferRequest>> reservedAttributesRequests;
     std::vector<std::reference_wrapper<InferRequest>> reservedLprRequests;
     bool requireGettingNumberOfDetections;
+    bool runClassifiers;  // false if the classifiers skip the frame because of the degradation
 };
 
 class InferTask: public Task {  // runs detection
 public:
     explicit InferTask(VideoFrame::Ptr sharedVideoFrame):
-        Task{sharedVideoFrame, 5.0} {}
+        Task{sharedVideoFrame, 5.0}, detectorsInfers{nullptr} {}
     bool isReady() override;
     void process() override;
+    ThreadBudget::Partition partition() const override {
+        return ThreadBudget::PREPROCESSING;
+    }
+
+private:
+    InferRequestsContainer* detectorsInfers;  // the pool of the detector resolution chosen by isReady()
 };
 
 class Reader: public Task {
@@ -266,6 +343,9 @@ public:
         Task{sharedVideoFrame, 2.0} {}
     bool isReady() override;
     void process() override;
+    ThreadBudget::Partition partition() const override {
+        return ThreadBudget::CAPTURE;
+    }
 };
 
 ReborningVideoFrame::~ReborningVideoFrame() {
@@ -327,12 +407,20 @@ void Drawer::process() {
     gridMatIt->second.update(sharedVideoFrame->frame, sharedVideoFrame->sourceID);
     auto firstGridIt = gridMats.begin();
     int64_t& lastShownframeId = context.drawersContext.lastShownframeId;
-    if (firstGridIt->first == lastShownframeId && firstGridIt->second.isFilled()) {
+    // the reduced display rate skips showing of the frames, but not their processing
+    const bool show = !context.isVideo || !context.isDegraded("display")
+        || std::chrono::steady_clock::now() - context.drawersContext.prevShow > context.drawersContext.degradedShowPeriod;
+    if (firstGridIt->first == lastShownframeId && firstGridIt->second.isFilled() && !show) {
+        lastShownframeId++;
+        firstGridIt->second.clear();
+        gridMats.emplace((--gridMats.end())->first + 1, firstGridIt->second);
+        gridMats.erase(firstGridIt);
+    } else if (firstGridIt->first == lastShownframeId && firstGridIt->second.isFilled()) {
         lastShownframeId++;
         cv::Mat mat = firstGridIt->second.getMat();
 
         float opacity = 0.6f;
-        fillROIColor(mat, cv::Rect(5, 5, 700, 115), cv::Scalar(255, 0, 0), opacity);
+        fillROIColor(mat, cv::Rect(5, 5, 700, context.degradation ? 150 : 115), cv::Scalar(255, 0, 0), opacity);
 
         std::ostringstream out;
         out << "Mean overall time per all inputs: " << std::fixed << std::setprecision(2) << std::setw(6);
@@ -344,12 +432,19 @@ void Drawer::process() {
         out << "ms /" << std::setw(6) << std::chrono::seconds(1) / meanOverallTimePerAllInputs << "FPS";
 
         cv::putText(mat, out.str(), cv::Point2f(10, 35), cv::FONT_HERSHEY_TRIPLEX, 0.7, cv::Scalar{255, 255, 255});
-        cv::putText(mat, "Detection InferRequests usage", cv::Point2f(10, 70), cv::FONT_HERSHEY_TRIPLEX, 0.7, cv::Scalar{255, 255, 255});
+        const bool lowResolution = context.isDegraded("resolution");
+        cv::putText(mat, lowResolution ? "Low resolution detection InferRequests usage" : "Detection InferRequests usage",
+                    cv::Point2f(10, 70), cv::FONT_HERSHEY_TRIPLEX, 0.7, cv::Scalar{255, 255, 255});
         cv::Rect usage(15, 90, 400, 20);
         cv::rectangle(mat, usage, {0, 255, 0}, 2);
-        uint64_t nireq = context.nireq;
-        usage.width = static_cast<int>(usage.width * static_cast<float>(frameCounter * nireq - context.freeDetectionInfersCount) / (frameCounter * nireq));
+        const Context::InfersUsage& infersUsage = lowResolution ? context.lowResolutionDetectionInfersUsage : context.detectionInfersUsage;
+        usage.width = static_cast<int>(usage.width * infersUsage.usage(context.nireq));
         cv::rectangle(mat, usage, {0, 255, 0}, cv::FILLED);
+        if (context.degradation) {
+            const std::size_t level = context.degradation->level();
+            cv::putText(mat, "Degradation level: " + std::to_string(level) + " (" + context.degradation->levelName(level) + ")",
+                        cv::Point2f(10, 140), cv::FONT_HERSHEY_TRIPLEX, 0.7, cv::Scalar{255, 255, 255});
+        }
 
         cv::imshow("Detection results", firstGridIt->second.getMat());
         context.drawersContext.prevShow = std::chrono::steady_clock::now();
@@ -369,9 +464,22 @@ void Drawer::process() {
 }
 
 void ResAggregator::process() {
-    Context& context = static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->context;
-    context.freeDetectionInfersCount += context.detectorsInfers.inferRequests.lockedSize();
+    ReborningVideoFrame& frame = *static_cast<ReborningVideoFrame*>(sharedVideoFrame.get());
+    Context& context = frame.context;
+    if (context.isDegraded("resolution")) {
+        context.lowResolutionDetectionInfersUsage.sample(context.lowResolutionDetectorsInfers);
+    } else {
+        context.detectionInfersUsage.sample(context.detectorsInfers);
+    }
     context.frameCounter++;
+    if (context.degradation) {
+        const auto now = std::chrono::steady_clock::now();
+        context.degradation->addLatency("queue", frame.detectionStartTime - frame.captureTime);
+        context.degradation->addLatency("detection", frame.detectionEndTime - frame.detectionStartTime);
+        context.degradation->addLatency("classification", now - frame.detectionEndTime);
+        context.degradation->addQueueDepth(context.framesWaitingForDetection);
+        context.degradation->update(now);
+    }
     if (!FLAGS_no_show) {
         for (const BboxAndDescr& bboxAndDescr : boxesAndDescrs) {
             switch (bboxAndDescr.objectType) {
@@ -434,11 +542,16 @@ bool DetectionsProcessor::isReady() {
                          break;
             }
         }
-        context.detectorsInfers.inferRequests.lockedPush_back(*inferRequest);
+        if (context.perfSampler) {
+            context.perfSampler->onCompleted(*inferRequest, "detection");
+        }
+        detectorsInfers->inferRequests.lockedPush_back(*inferRequest);
         requireGettingNumberOfDetections = false;
+        static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->detectionEndTime = std::chrono::steady_clock::now();
+        runClassifiers = !(context.isDegraded("classifiers") && sharedVideoFrame->frameId % 2 == 1);
     }
 
-    if ((vehicleRects.empty() || FLAGS_m_va.empty()) && (plateRects.empty() || FLAGS_m_lpr.empty())) {
+    if ((vehicleRects.empty() || !runAttributes()) && (plateRects.empty() || !runLpr())) {
         return true;
     } else {
         // isReady() is called under mutexes so it is assured that available InferRequests will not be taken, but new InferRequests can come in
@@ -465,7 +578,7 @@ bool DetectionsProcessor::isReady() {
 
 void DetectionsProcessor::process() {
     Context& context = static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->context;
-    if (!FLAGS_m_va.empty()) {
+    if (runAttributes()) {
         auto vehicleRectsIt = vehicleRects.begin();
         for (auto attributesRequestIt = reservedAttributesRequests.begin(); attributesRequestIt != reservedAttributesRequests.end();
                 vehicleRectsIt++, attributesRequestIt++) {
@@ -489,6 +602,9 @@ void DetectionsProcessor::process() {
                                                                                       + attributes.second + '\n');
                             }
                             classifiersAggreagator->push(BboxAndDescr{BboxAndDescr::ObjectType::VEHICCLE, rect, attributes.first + ' ' + attributes.second});
+                            if (context.perfSampler) {
+                                context.perfSampler->onCompleted(attributesRequest, "attributes");
+                            }
                             context.attributesInfers.inferRequests.lockedPush_back(attributesRequest);
                         }, classifiersAggreagator,
                            std::ref(attributesRequest),
@@ -505,7 +621,7 @@ void DetectionsProcessor::process() {
         vehicleRects.clear();
     }
 
-    if (!FLAGS_m_lpr.empty()) {
+    if (runLpr()) {
         auto plateRectsIt = plateRects.begin();
         for (auto lprRequestsIt = reservedLprRequests.begin(); lprRequestsIt != reservedLprRequests.end(); plateRectsIt++, lprRequestsIt++) {
             const cv::Rect plateRect = *plateRectsIt;
@@ -526,6 +642,9 @@ void DetectionsProcessor::process() {
                                 classifiersAggreagator->rawDecodedPlates.lockedPush_back("License Plate Recognition results:" + result + '\n');
                             }
                             classifiersAggreagator->push(BboxAndDescr{BboxAndDescr::ObjectType::PLATE, rect, std::move(result)});
+                            if (context.perfSampler) {
+                                context.perfSampler->onCompleted(lprRequest, "lpr");
+                            }
                             context.platesInfers.inferRequests.lockedPush_back(lprRequest);
                         }, classifiersAggreagator,
                            std::ref(lprRequest),
@@ -548,13 +667,14 @@ void DetectionsProcessor::process() {
 }
 
 bool InferTask::isReady() {
-    InferRequestsContainer& detectorsInfers = static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->context.detectorsInfers;
-    if (detectorsInfers.inferRequests.container.empty()) {
+    Context& context = static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->context;
+    detectorsInfers = context.isDegraded("resolution") ? &context.lowResolutionDetectorsInfers : &context.detectorsInfers;
+    if (detectorsInfers->inferRequests.container.empty()) {
         return false;
     } else {
-        detectorsInfers.inferRequests.mutex.lock();
-        if (detectorsInfers.inferRequests.container.empty()) {
-            detectorsInfers.inferRequests.mutex.unlock();
+        detectorsInfers->inferRequests.mutex.lock();
+        if (detectorsInfers->inferRequests.container.empty()) {
+            detectorsInfers->inferRequests.mutex.unlock();
             return false;
         } else {
             return true;  // process() will unlock the mutex
@@ -563,11 +683,13 @@ bool InferTask::isReady() {
 }
 
 void InferTask::process() {
-    Context& context = static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->context;
-    InferRequestsContainer& detectorsInfers = context.detectorsInfers;
-    std::reference_wrapper<InferRequest> inferRequest = detectorsInfers.inferRequests.container.back();
-    detectorsInfers.inferRequests.container.pop_back();
-    detectorsInfers.inferRequests.mutex.unlock();
+    ReborningVideoFrame& frame = *static_cast<ReborningVideoFrame*>(sharedVideoFrame.get());
+    Context& context = frame.context;
+    std::reference_wrapper<InferRequest> inferRequest = detectorsInfers->inferRequests.container.back();
+    detectorsInfers->inferRequests.container.pop_back();
+    detectorsInfers->inferRequests.mutex.unlock();
+    context.framesWaitingForDetection--;
+    frame.detectionStartTime = std::chrono::steady_clock::now();
 
     context.inferTasksContext.detector.setImage(inferRequest, sharedVideoFrame->frame);
 
@@ -575,12 +697,14 @@ void InferTask::process() {
         std::bind(
             [](VideoFrame::Ptr sharedVideoFrame,
                InferRequest& inferRequest,
+               InferRequestsContainer* detectorsInfers,
                Context& context) {
                     inferRequest.SetCompletionCallback([]{});  // destroy the stored bind object
                     tryPush(context.detectionsProcessorsContext.detectionsProcessorsWorker,
-                        std::make_shared<DetectionsProcessor>(sharedVideoFrame, &inferRequest));
+                        std::make_shared<DetectionsProcessor>(sharedVideoFrame, &inferRequest, detectorsInfers));
                 }, sharedVideoFrame,
                    inferRequest,
+                   detectorsInfers,
                    std::ref(context)));
     inferRequest.get().StartAsync();
     // do not push as callback does it
@@ -604,6 +728,8 @@ void Reader::process() {
     if (inputChannels[sourceID]->read(sharedVideoFrame->frame)) {
         context.readersContext.lastCapturedFrameIds[sourceID]++;
         context.readersContext.lastCapturedFrameIdsMutexes[sourceID].unlock();
+        static_cast<ReborningVideoFrame*>(sharedVideoFrame.get())->captureTime = std::chrono::steady_clock::now();
+        context.framesWaitingForDetection++;
         tryPush(context.inferTasksContext.inferTasksWorker, std::make_shared<InferTask>(sharedVideoFrame));
     } else {
         context.readersContext.lastCapturedFrameIds[sourceID]++;
@@ -627,6 +753,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "[ ERROR ] " << error.what() << std::endl;
             return 1;
         }
+        enableHugePages(FLAGS_huge_pages);
 
         std::vector<std::string> files;
         parseInputFilesArguments(files);
@@ -681,6 +808,15 @@ int main(int argc, char* argv[]) {
         // --------------------------- 1. Load Inference Engine -------------------------------------
         InferenceEngine::Core ie;
 
+        std::unique_ptr<ThreadBudget> threadBudget;
+        if (!FLAGS_thread_budget.empty()) {
+            threadBudget.reset(new ThreadBudget(FLAGS_thread_budget));
+            threadBudget->setInferenceStreams(FLAGS_nireq == 0 ? inputChannels.size() : FLAGS_nireq);
+            threadBudget->configureOpenCV();
+            slog::info << "Thread budget: " << threadBudget->toString()
+                       << ", inference streams: " << threadBudget->inferenceStreams() << slog::endl;
+        }
+
         std::set<std::string> loadedDevices;
         std::vector<std::string> pluginNames = {
                 FLAGS_d,
@@ -709,7 +845,17 @@ int main(int argc, char* argv[]) {
                     ie.AddExtension(extension_ptr, "CPU");
                     slog::info << "CPU Extension loaded: " << FLAGS_l << slog::endl;
                 }
-                if (inputChannels.size() > 1) {
+                if (threadBudget) {
+                    // the inference threads are split between the networks loaded to the CPU
+                    unsigned cpuNetworks = 0;
+                    for (const auto& net : {std::make_pair(FLAGS_d, true), std::make_pair(FLAGS_d_va, !FLAGS_m_va.empty()),
+                                            std::make_pair(FLAGS_d_lpr, !FLAGS_m_lpr.empty())}) {
+                        if (net.second && net.first.find("CPU") != std::string::npos) {
+                            cpuNetworks++;
+                        }
+                    }
+                    threadBudget->configurePlugin(ie, cpuNetworks);
+                } else if (inputChannels.size() > 1) {
                     ie.SetConfig({{PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS, PluginConfigParams::CPU_THROUGHPUT_AUTO}}, "CPU");
                 }
             }
@@ -733,9 +879,16 @@ int main(int argc, char* argv[]) {
         /** Per layer metrics **/
         std::map<std::string, std::string> mapDevices;
         if (FLAGS_pc) {
-            ie.SetConfig({{PluginConfigParams::KEY_PERF_COUNT, PluginConfigParams::YES}});
             mapDevices = getMapFullDevicesNames(ie, pluginNames);
         }
+        if (FLAGS_pc || 0 != FLAGS_pc_period) {
+            ie.SetConfig({{PluginConfigParams::KEY_PERF_COUNT, PluginConfigParams::YES}});
+        }
+        std::unique_ptr<PerfCountersSampler> perfSampler;
+        if (0 != FLAGS_pc_period) {
+            perfSampler.reset(new PerfCountersSampler(std::chrono::milliseconds(FLAGS_pc_period), FLAGS_pc_budget / 100.));
+            perfSampler->setMetricsFile(FLAGS_pc_metrics);
+        }
 
         /** Graph tagging via config options**/
         auto makeTagConfig = [&](const std::string &deviceName, const std::string &suffix) {
@@ -748,9 +901,15 @@ int main(int argc, char* argv[]) {
 
         // -----------------------------------------------------------------------------------------------------
         unsigned nireq = FLAGS_nireq == 0 ? inputChannels.size() : FLAGS_nireq;
+        const std::vector<std::string> degradation = parseDegradationSteps(FLAGS_degrade);
+        const bool lowResolution = degradation.end() != std::find(degradation.begin(), degradation.end(), "resolution");
         slog::info << "Loading detection model to the "<< FLAGS_d << " plugin" << slog::endl;
         Detector detector(ie, FLAGS_d, FLAGS_m,
-            {static_cast<float>(FLAGS_t), static_cast<float>(FLAGS_t)}, FLAGS_auto_resize, makeTagConfig(FLAGS_d, "Detect"));
+            {static_cast<float>(FLAGS_t), static_cast<float>(FLAGS_t)}, FLAGS_auto_resize, makeTagConfig(FLAGS_d, "Detect"),
+            lowResolution ? FLAGS_degrade_scale : 0.);
+        if (detector.hasLowResolution()) {
+            slog::info << "Detector input resolution for the degradation: " << detector.getLowResolutionSize() << slog::endl;
+        }
         VehicleAttributesClassifier vehicleAttributesClassifier;
         std::size_t nclassifiersireq{0};
         Lpr lpr;
@@ -765,7 +924,12 @@ int main(int argc, char* argv[]) {
             lpr = Lpr(ie, FLAGS_d_lpr, FLAGS_m_lpr, FLAGS_auto_resize, makeTagConfig(FLAGS_d_lpr, "LPR"));
             nrecognizersireq = nireq * 3;
         }
-        std::shared_ptr<Worker> worker = std::make_shared<Worker>(FLAGS_n_wt - 1);
+        unsigned workerThreads = FLAGS_n_wt;
+        if (threadBudget) {
+            workerThreads = threadBudget->threads(ThreadBudget::CAPTURE) + threadBudget->threads(ThreadBudget::PREPROCESSING)
+                + threadBudget->threads(ThreadBudget::POSTPROCESSING);
+        }
+        std::shared_ptr<Worker> worker = std::make_shared<Worker>(workerThreads - 1, threadBudget.get());
         bool isVideo = imageSourcess.empty() ? true : false;
         int pause = imageSourcess.empty() ? 1 : 0;
         std::chrono::steady_clock::duration showPeriod = 0 == FLAGS_fps ? std::chrono::steady_clock::duration::zero()
@@ -791,6 +955,27 @@ int main(int argc, char* argv[]) {
                         nireq,
                         isVideo,
                         nclassifiersireq, nrecognizersireq};
+        context.perfSampler = perfSampler.get();
+        if (!degradation.empty()) {
+            std::vector<std::string> levelNames{"full quality"};
+            for (const std::string& step : degradation) {
+                levelNames.push_back(degradationSteps.at(step));
+                context.degradationStepLevels[step] = levelNames.size() - 1;
+            }
+            DegradationController::Params degradationParams;
+            degradationParams.latencyBudget = std::chrono::milliseconds(FLAGS_degrade_latency);
+            degradationParams.maxQueueDepth = FLAGS_degrade_queue;
+            context.degradation.reset(new DegradationController(levelNames, degradationParams));
+            context.drawersContext.degradedShowPeriod = std::max(showPeriod,
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds{1}) / FLAGS_degrade_fps);
+            if (lowResolution) {
+                std::vector<InferRequest> lowResolutionInferRequests;
+                std::generate_n(std::back_inserter(lowResolutionInferRequests), nireq, [&]{
+                    return context.inferTasksContext.detector.createInferRequest(true);});
+                context.lowResolutionDetectorsInfers = InferRequestsContainer(lowResolutionInferRequests);
+            }
+            slog::info << "Degradation steps: " << FLAGS_degrade << slog::endl;
+        }
 
         for (uint64_t i = 0; i < FLAGS_n_iqs; i++) {
             for (unsigned sourceID = 0; sourceID < inputChannels.size(); sourceID++) {
@@ -806,14 +991,18 @@ int main(int argc, char* argv[]) {
         }
 
         // Running
+        if (threadBudget) {
+            threadBudget->utilization();  // start measuring from the beginning of processing
+        }
         context.t0 = std::chrono::steady_clock::now();
         worker->runThreads();
         worker->threadFunc();
         worker->join();
         const auto t1 = std::chrono::steady_clock::now();
 
-        for (auto& net : std::array<std::pair<std::vector<InferRequest>, std::string>, 3>{
+        for (auto& net : std::array<std::pair<std::vector<InferRequest>, std::string>, 4>{
             std::make_pair(context.detectorsInfers.getActualInferRequests(), FLAGS_d),
+                std::make_pair(context.lowResolutionDetectorsInfers.getActualInferRequests(), FLAGS_d),
                 std::make_pair(context.attributesInfers.getActualInferRequests(), FLAGS_d_va),
                 std::make_pair(context.platesInfers.getActualInferRequests(), FLAGS_d_lpr)}) {
             for (InferRequest& ir : net.first) {
@@ -830,9 +1019,24 @@ int main(int argc, char* argv[]) {
                 * context.readersContext.inputChannels.size()) / frameCounter;
             std::cout << "Mean overall time per all inputs: " << std::fixed << std::setprecision(2) << meanOverallTimePerAllInputs.count()
                       << "ms / " << std::chrono::seconds(1) / meanOverallTimePerAllInputs << "FPS for " << frameCounter << " frames\n";
-            const double detectionsInfersUsage = static_cast<float>(frameCounter * context.nireq - context.freeDetectionInfersCount)
-                / (frameCounter * context.nireq) * 100;
-            std::cout << "Detection InferRequests usage: " << detectionsInfersUsage << "%\n";
+            std::cout << "Detection InferRequests usage: " << context.detectionInfersUsage.usage(context.nireq) * 100 << "%\n";
+            if (0 != context.lowResolutionDetectionInfersUsage.samples) {
+                std::cout << "Low resolution detection InferRequests usage: "
+                          << context.lowResolutionDetectionInfersUsage.usage(context.nireq) * 100 << "%\n";
+            }
+        }
+        if (context.degradation) {
+            std::cout << "Degradation level changes: " << context.degradation->changes() << ", final level: "
+                      << context.degradation->levelName(context.degradation->level()) << "\n";
+        }
+        if (threadBudget) {
+            std::cout << "CPU utilization: " << threadBudget->utilizationReport() << "\n";
+        }
+        if (!FLAGS_huge_pages.empty()) {
+            std::cout << "Memory: " << HugePageArena::instance().report() << "\n";
+        }
+        if (perfSampler) {
+            std::cout << perfSampler->report();
         }
     } catch (const std::exception& error) {
         std::cerr << "[ ERROR ] " << error.what() << std::endl;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <string>
 #include <utility>
@@ -12,6 +13,8 @@
 
 #include <inference_engine.hpp>
 #include <samples/common.hpp>
+#include <samples/huge_pages.hpp>
+#include <samples/memory_usage.hpp>
 #include <samples/ocv_common.hpp>
 
 class Detector {
@@ -26,9 +29,15 @@ public:
     static constexpr int objectSize = 7;  // Output should have 7 as a last dimension"
 
     Detector() = default;
+    /**
+     * @param lowResolutionScale if positive, the detector is also loaded with the input resolution scaled by it
+     * to trade the detection quality for speed, see createInferRequest()
+     */
     Detector(InferenceEngine::Core& ie, const std::string deviceName, const std::string& xmlPath, const std::vector<float>& detectionTresholds,
-            const bool autoResize, const std::map<std::string, std::string> & pluginConfig) :
-        detectionTresholds{detectionTresholds}, ie_{ie} {
+            const bool autoResize, const std::map<std::string, std::string> & pluginConfig, double lowResolutionScale = 0) :
+        detectionTresholds{detectionTresholds} {
+        // The parsed network is released at the end of the constructor, the report is made after that
+        ModelMemoryReport memoryReport(xmlPath);
         InferenceEngine::CNNNetReader netReader;
         netReader.ReadNetwork(xmlPath);
         std::string detectorBinFileName = fileNameNoExt(xmlPath) + ".bin";
@@ -67,11 +76,42 @@ public:
         }
         _output->setPrecision(InferenceEngine::Precision::FP32);
 
-        net = ie_.LoadNetwork(netReader.getNetwork(), deviceName, pluginConfig);
+        net = ie.LoadNetwork(netReader.getNetwork(), deviceName, pluginConfig);
+
+        if (lowResolutionScale > 0) {
+            // The network is compiled right after the reshape, so the full resolution network is not affected
+            InferenceEngine::CNNNetwork network = netReader.getNetwork();
+            InferenceEngine::ICNNNetwork::InputShapes shapes = network.getInputShapes();
+            InferenceEngine::SizeVector& dims = shapes.at(detectorInputBlobName);
+            dims[2] = std::max<size_t>(1, static_cast<size_t>(dims[2] * lowResolutionScale + 0.5));
+            dims[3] = std::max<size_t>(1, static_cast<size_t>(dims[3] * lowResolutionScale + 0.5));
+            network.reshape(shapes);
+            lowResolutionNet = ie.LoadNetwork(network, deviceName, pluginConfig);
+            lowResolutionSize = cv::Size(static_cast<int>(dims[3]), static_cast<int>(dims[2]));
+        }
     }
 
-    InferenceEngine::InferRequest createInferRequest() {
-        return net.CreateInferRequest();
+    /** @brief Whether the detector is loaded with the reduced input resolution */
+    bool hasLowResolution() const {
+        return lowResolutionSize.area() > 0;
+    }
+
+    cv::Size getLowResolutionSize() const {
+        return lowResolutionSize;
+    }
+
+    /**
+     * @brief Creates a request of the full resolution detector or of the reduced resolution one,
+     * setImage() and getResults() handle both
+     */
+    InferenceEngine::InferRequest createInferRequest(bool lowResolution = false) {
+        InferenceEngine::ExecutableNetwork& executableNet = lowResolution ? lowResolutionNet : net;
+        InferenceEngine::InferRequest inferRequest = executableNet.CreateInferRequest();
+        // Frames are copied into the input only without autoResize, otherwise it wraps the frame
+        if (InferenceEngine::Layout::NHWC != inferRequest.GetBlob(detectorInputBlobName)->getTensorDesc().getLayout()) {
+            allocateInputsOnHugePages(inferRequest, executableNet.GetInputsInfo());
+        }
+        return inferRequest;
     }
 
     void setImage(InferenceEngine::InferRequest& inferRequest, const cv::Mat& img) {
@@ -124,15 +164,17 @@ private:
     std::vector<float> detectionTresholds;
     std::string detectorInputBlobName;
     std::string detectorOutputBlobName;
-    InferenceEngine::Core ie_;  // The only reason to store a plugin as to assure that it lives at least as long as ExecutableNetwork
-    InferenceEngine::ExecutableNetwork net;
+    InferenceEngine::ExecutableNetwork net;  // keeps the device plugin loaded, so Core does not need to be stored
+    InferenceEngine::ExecutableNetwork lowResolutionNet;
+    cv::Size lowResolutionSize;
 };
 
 class VehicleAttributesClassifier {
 public:
     VehicleAttributesClassifier() = default;
     VehicleAttributesClassifier(InferenceEngine::Core& ie, const std::string & deviceName,
-        const std::string& xmlPath, const bool autoResize, const std::map<std::string, std::string> & pluginConfig) : ie_(ie) {
+        const std::string& xmlPath, const bool autoResize, const std::map<std::string, std::string> & pluginConfig) {
+        ModelMemoryReport memoryReport(xmlPath);
         InferenceEngine::CNNNetReader attributesNetReader;
         attributesNetReader.ReadNetwork(FLAGS_m_va);
         std::string attributesBinFileName = fileNameNoExt(FLAGS_m_va) + ".bin";
@@ -162,7 +204,7 @@ public:
         it->second->setPrecision(InferenceEngine::Precision::FP32);
         outputNameForType = (it)->second->getName();  // type is the second output.
 
-        net = ie_.LoadNetwork(attributesNetReader.getNetwork(), deviceName, pluginConfig);
+        net = ie.LoadNetwork(attributesNetReader.getNetwork(), deviceName, pluginConfig);
     }
 
     InferenceEngine::InferRequest createInferRequest() {
@@ -204,7 +246,6 @@ private:
     std::string attributesInputName;
     std::string outputNameForColor;
     std::string outputNameForType;
-    InferenceEngine::Core ie_;  // The only reason to store a device is to assure that it lives at least as long as ExecutableNetwork
     InferenceEngine::ExecutableNetwork net;
 };
 
@@ -212,8 +253,8 @@ class Lpr {
 public:
     Lpr() = default;
     Lpr(InferenceEngine::Core& ie, const std::string & deviceName, const std::string& xmlPath, const bool autoResize,
-        const std::map<std::string, std::string> &pluginConfig) :
-        ie_{ie} {
+        const std::map<std::string, std::string> &pluginConfig) {
+        ModelMemoryReport memoryReport(xmlPath);
         InferenceEngine::CNNNetReader LprNetReader;
         LprNetReader.ReadNetwork(FLAGS_m_lpr);
         std::string lprBinFileName = fileNameNoExt(FLAGS_m_lpr) + ".bin";
@@ -246,7 +287,7 @@ public:
         }
         LprOutputName = LprOutputInfo.begin()->first;
 
-        net = ie_.LoadNetwork(LprNetReader.getNetwork(), deviceName, pluginConfig);
+        net = ie.LoadNetwork(LprNetReader.getNetwork(), deviceName, pluginConfig);
     }
 
     InferenceEngine::InferRequest createInferRequest() {
@@ -307,6 +348,5 @@ private:
     std::string LprInputName;
     std::string LprInputSeqName;
     std::string LprOutputName;
-    InferenceEngine::Core ie_;  // The only reason to store a device as to assure that it lives at least as long as ExecutableNetwork
     InferenceEngine::ExecutableNetwork net;
 };
@@ -87,6 +87,52 @@ static const char fps[] = "Optional. Set the playback speed not faster than the
 /// @brief message for setting the number of threads in Worker
 static const char worker_threads[] = "Optional. Set the number of threads including the main thread a Worker class will use.";
 
+/// @brief message for the thread budget
+static const char thread_budget_message[] = "Optional. Split CPU cores between the pipeline stages, "
+                                            "for example \"capture:1,preprocessing:1,inference:8,postprocessing:2\". "
+                                            "Partitions which are not listed get one thread, inference gets the rest of the cores, "
+                                            "which are split between the networks loaded to the CPU. "
+                                            "Overrides -n_wt with the sum of the capture, preprocessing and postprocessing threads.";
+
+/// @brief message for huge pages
+static const char huge_pages_message[] = "Optional. Allocate frames and input tensors on huge pages local to the NUMA node of the "
+                                         "allocating thread. \"thp\" uses transparent huge pages, \"explicit\" uses the pages reserved in "
+                                         "/proc/sys/vm/nr_hugepages and falls back to transparent ones. Supported on Linux only.";
+
+/// @brief message for per-layer performance sampling period
+static const char pc_period_message[] = "Optional. Sample per-layer performance counters of a completed infer request of every "
+                                        "network every specified number of milliseconds and report the layer time distributions "
+                                        "at the end. 0 disables sampling.";
+
+/// @brief message for per-layer performance sampling overhead
+static const char pc_budget_message[] = "Optional. Maximal share of time in percent spent on per-layer performance sampling, "
+                                        "the sampling period is increased to stay within it.";
+
+/// @brief message for per-layer performance metrics file
+static const char pc_metrics_message[] = "Optional. Write the sampled layer time histograms in Prometheus text format "
+                                         "to the specified file every sampling period.";
+
+/// @brief message for degradation steps
+static const char degrade_message[] = "Optional. Comma-separated degradation steps applied one by one while the pipeline is overloaded "
+                                      "and reverted in the reverse order when the load drops. \"resolution\" runs the detector at a "
+                                      "reduced input resolution, \"classifiers\" runs the Vehicle Attributes and License Plate "
+                                      "Recognition models on every other frame only, \"display\" reduces the display rate. "
+                                      "For example \"classifiers,resolution,display\". Empty disables the degradation.";
+
+/// @brief message for degradation latency budget
+static const char degrade_latency_message[] = "Optional. Mean frame latency from capture to drawing in milliseconds "
+                                              "above which the pipeline is considered overloaded.";
+
+/// @brief message for degradation queue depth limit
+static const char degrade_queue_message[] = "Optional. Mean number of frames waiting for the detector above which "
+                                            "the pipeline is considered overloaded. 0 ignores the queue depth.";
+
+/// @brief message for degraded detector resolution
+static const char degrade_scale_message[] = "Optional. Scale of the detector input resolution for the \"resolution\" degradation step.";
+
+/// @brief message for degraded display rate
+static const char degrade_fps_message[] = "Optional. Display rate in FPS for the \"display\" degradation step.";
+
 /// @brief Message for display resolution argument
 static const char display_resolution_message[] = "Optional. Specify the maximum output window resolution.";
 
@@ -184,6 +230,46 @@ DEFINE_uint32(fps, 0, fps);
 /// It is a optional parameter
 DEFINE_uint32(n_wt, 1, worker_threads);
 
+/// \brief Define parameter for the thread budget<br>
+/// It is a optional parameter
+DEFINE_string(thread_budget, "", thread_budget_message);
+
+/// \brief Define parameter for huge pages<br>
+/// It is a optional parameter
+DEFINE_string(huge_pages, "", huge_pages_message);
+
+/// \brief Define parameter for per-layer performance sampling period<br>
+/// It is a optional parameter
+DEFINE_uint32(pc_period, 0, pc_period_message);
+
+/// \brief Define parameter for per-layer performance sampling overhead<br>
+/// It is a optional parameter
+DEFINE_double(pc_budget, 1.0, pc_budget_message);
+
+/// \brief Define parameter for per-layer performance metrics file<br>
+/// It is a optional parameter
+DEFINE_string(pc_metrics, "", pc_metrics_message);
+
+/// \brief Define parameter for degradation steps<br>
+/// It is a optional parameter
+DEFINE_string(degrade, "", degrade_message);
+
+/// \brief Define parameter for degradation latency budget<br>
+/// It is a optional parameter
+DEFINE_uint32(degrade_latency, 200, degrade_latency_message);
+
+/// \brief Define parameter for degradation queue depth limit<br>
+/// It is a optional parameter
+DEFINE_uint32(degrade_queue, 0, degrade_queue_message);
+
+/// \brief Define parameter for degraded detector resolution<br>
+/// It is a optional parameter
+DEFINE_double(degrade_scale, 0.5, degrade_scale_message);
+
+/// \brief Define parameter for degraded display rate<br>
+/// It is a optional parameter
+DEFINE_uint32(degrade_fps, 5, degrade_fps_message);
+
 /// \brief Flag to specify the maximum output window resolution<br>
 /// It is an optional parameter
 DEFINE_string(display_resolution, "1920x1080", display_resolution_message);
@@ -212,6 +298,9 @@ void showUsage() {
     std::cout << "    -d_va \"<device>\"           " << target_device_message_vehicle_attribs << std::endl;
     std::cout << "    -d_lpr \"<device>\"          " << target_device_message_lpr << std::endl;
     std::cout << "    -pc                        " << performance_counter_message << std::endl;
+    std::cout << "    -pc_period                 " << pc_period_message << std::endl;
+    std::cout << "    -pc_budget                 " << pc_budget_message << std::endl;
+    std::cout << "    -pc_metrics \"<path>\"       " << pc_metrics_message << std::endl;
     std::cout << "    -r                         " << raw_output_message << std::endl;
     std::cout << "    -t                         " << thresh_output_message << std::endl;
     std::cout << "    -no_show                   " << no_show_processed_video << std::endl;
@@ -224,6 +313,13 @@ void showUsage() {
     std::cout << "    -ni                        " << ninputs_message << std::endl;
     std::cout << "    -fps                       " << fps << std::endl;
     std::cout << "    -n_wt                      " << worker_threads << std::endl;
+    std::cout << "    -thread_budget \"<budget>\"  " << thread_budget_message << std::endl;
+    std::cout << "    -huge_pages \"<mode>\"       " << huge_pages_message << std::endl;
+    std::cout << "    -degrade \"<steps>\"         " << degrade_message << std::endl;
+    std::cout << "    -degrade_latency           " << degrade_latency_message << std::endl;
+    std::cout << "    -degrade_queue             " << degrade_queue_message << std::endl;
+    std::cout << "    -degrade_scale             " << degrade_scale_message << std::endl;
+    std::cout << "    -degrade_fps               " << degrade_fps_message << std::endl;
     std::cout << "    -display_resolution        " << display_resolution_message << std::endl;
 
     std::cout << "    -tag                       " << use_tag_scheduler_message << std::endl;
@@ -18,6 +18,8 @@
 #include <samples/common.hpp>
 #include <samples/slog.hpp>
 #include <samples/args_helper.hpp>
+#include <samples/ocv_common.hpp>
+#include <samples/shape_buckets.hpp>
 
 #include <vpu/vpu_tools_common.hpp>
 #include <vpu/vpu_plugin_config.hpp>
@@ -54,6 +56,113 @@ static std::map<std::string, std::string> configure(const std::string& confFileN
     return config;
 }
 
+/**
+ * @brief Finds the class of every pixel of the given region of a segmentation output
+ * @param data output of one image in CHW layout, or HW layout if C is 1 (the output is already ArgMax'ed)
+ */
+static std::vector<std::vector<size_t>> outputClasses(const float* data, size_t C, size_t H, size_t W, const cv::Rect& roi) {
+    /** This vector stores pixels classes **/
+    std::vector<std::vector<size_t>> outArrayClasses(roi.height, std::vector<size_t>(roi.width, 0));
+    std::vector<std::vector<float>> outArrayProb(roi.height, std::vector<float>(roi.width, 0.));
+    /** Iterating over each pixel **/
+    for (int w = 0; w < roi.width; ++w) {
+        for (int h = 0; h < roi.height; ++h) {
+            size_t offset = W * (roi.y + h) + roi.x + w;
+            /* number of channels = 1 means that the output is already ArgMax'ed */
+            if (C == 1) {
+                outArrayClasses[h][w] = static_cast<size_t>(data[offset]);
+            } else {
+                /** Iterating over each class probability **/
+                for (size_t ch = 0; ch < C; ++ch) {
+                    auto prob = data[W * H * ch + offset];
+                    if (prob > outArrayProb[h][w]) {
+                        outArrayClasses[h][w] = ch;
+                        outArrayProb[h][w] = prob;
+                    }
+                }
+            }
+        }
+    }
+    return outArrayClasses;
+}
+
+static void writeClasses(const std::vector<std::vector<size_t>>& classes, size_t C, size_t image) {
+    /** Dump resulting image **/
+    std::string fileName = "out_" + std::to_string(image) + ".bmp";
+    std::ofstream outFile(fileName, std::ofstream::binary);
+    if (!outFile.is_open()) {
+        throw std::logic_error("Can't open file : " + fileName);
+    }
+
+    writeOutputBmp(classes, C, outFile);
+    slog::info << "File : " << fileName << " was created" << slog::endl;
+}
+
+/**
+ * @brief Groups the images into shape buckets chosen from their sizes, so that the images are inferred
+ * close to their own resolution with one network load per bucket instead of per image
+ */
+static void processWithShapeBuckets(Core& ie, CNNNetwork& network, const std::vector<std::string>& images) {
+    std::vector<cv::Mat> inputImages;
+    std::vector<cv::Size> sizes;
+    for (const auto& i : images) {
+        cv::Mat img = cv::imread(i);
+        if (img.empty()) {
+            slog::warn << "Image " + i + " cannot be read!" << slog::endl;
+            continue;
+        }
+        inputImages.push_back(img);
+        sizes.push_back(img.size());
+    }
+    if (inputImages.empty()) throw std::logic_error("Valid input images were not found!");
+
+    InputsDataMap inputInfo(network.getInputsInfo());
+    if (inputInfo.size() != 1) throw std::logic_error("Demo supports topologies only with 1 input");
+    const std::string inputName = inputInfo.begin()->first;
+    inputInfo.begin()->second->setPrecision(Precision::U8);
+    OutputsDataMap outputInfo(network.getOutputsInfo());
+    const std::string outputName = outputInfo.begin()->first;
+    for (auto& item : outputInfo) {
+        item.second->setPrecision(Precision::FP32);
+    }
+
+    /** The bucket sizes are aligned to the stride of typical segmentation topologies **/
+    const int bucketAlignment = 32;
+    std::vector<cv::Size> buckets = chooseBuckets(sizes, FLAGS_buckets, bucketAlignment);
+    for (const auto& bucket : buckets) {
+        slog::info << "Shape bucket " << bucket.width << "x" << bucket.height << slog::endl;
+    }
+
+    slog::info << "Loading model to the device" << slog::endl;
+    ShapeBucketedBatcher batcher(ie, network, FLAGS_d, buckets, FLAGS_b, paddingPolicyFromString(FLAGS_bucket_policy),
+        [&](InferRequest& request, size_t slot, const cv::Mat& input) {
+            Blob::Ptr blob = request.GetBlob(inputName);
+            matU8ToBlob<uint8_t>(input, blob, static_cast<int>(slot));
+        },
+        [&](InferRequest& request, const ShapeBucketedBatcher::Placement& placement) {
+            const Blob::Ptr outputBlob = request.GetBlob(outputName);
+            const SizeVector& dims = outputBlob->getTensorDesc().getDims();
+            size_t C = dims.size() == 4 ? dims[1] : 1;
+            size_t H = dims[dims.size() - 2];
+            size_t W = dims[dims.size() - 1];
+            /** The output may be downscaled relative to the input, the image region is scaled accordingly **/
+            cv::Rect roi(static_cast<int>(placement.roi.x * W / placement.bucket.width),
+                         static_cast<int>(placement.roi.y * H / placement.bucket.height),
+                         static_cast<int>((placement.roi.width * W + placement.bucket.width - 1) / placement.bucket.width),
+                         static_cast<int>((placement.roi.height * H + placement.bucket.height - 1) / placement.bucket.height));
+            roi &= cv::Rect(0, 0, static_cast<int>(W), static_cast<int>(H));
+            writeClasses(outputClasses(outputBlob->buffer().as<float*>() + W * H * C * placement.slot, C, H, W, roi),
+                         C, placement.id);
+        }, configure(FLAGS_config));
+
+    slog::info << "Start inference" << slog::endl;
+    for (size_t i = 0; i < inputImages.size(); i++) {
+        batcher.push(i, inputImages[i]);
+    }
+    batcher.flush();
+    slog::info << "Shape buckets: " << batcher.report() << slog::endl;
+}
+
 /**
  * @brief The entry point for inference engine deconvolution demo application
  * @file segmentation_demo/main.cpp
@@ -120,6 +229,12 @@ int main(int argc, char *argv[]) {
         CNNNetwork network = networkReader.getNetwork();
         // -----------------------------------------------------------------------------------------------------
 
+        if (FLAGS_buckets > 0) {
+            processWithShapeBuckets(ie, network, images);
+            slog::info << "Execution successful" << slog::endl;
+            return 0;
+        }
+
         // --------------------------- 3. Configure input & output ---------------------------------------------
 
         // --------------------------- Prepare input blobs -----------------------------------------------------
@@ -242,40 +357,10 @@ int main(int argc, char *argv[]) {
             throw std::logic_error("Unexpected output blob shape. Only 4D and 3D output blobs are supported.");
         }
 
-        size_t image_stride = W*H*C;
-
         /** Iterating over all images **/
         for (size_t image = 0; image < N; ++image) {
-            /** This vector stores pixels classes **/
-            std::vector<std::vector<size_t>> outArrayClasses(H, std::vector<size_t>(W, 0));
-            std::vector<std::vector<float>> outArrayProb(H, std::vector<float>(W, 0.));
-            /** Iterating over each pixel **/
-            for (size_t w = 0; w < W; ++w) {
-                for (size_t h = 0; h < H; ++h) {
-                    /* number of channels = 1 means that the output is already ArgMax'ed */
-                    if (C == 1) {
-                        outArrayClasses[h][w] = static_cast<size_t>(output_data[image_stride * image + W * h + w]);
-                    } else {
-                        /** Iterating over each class probability **/
-                        for (size_t ch = 0; ch < C; ++ch) {
-                            auto data = output_data[image_stride * image + W * H * ch + W * h + w];
-                            if (data > outArrayProb[h][w]) {
-                                outArrayClasses[h][w] = ch;
-                                outArrayProb[h][w] = data;
-                            }
-                        }
-                    }
-                }
-            }
-            /** Dump resulting image **/
-            std::string fileName = "out_" + std::to_string(image) + ".bmp";
-            std::ofstream outFile(fileName, std::ofstream::binary);
-            if (!outFile.is_open()) {
-                throw std::logic_error("Can't open file : " + fileName);
-            }
-
-            writeOutputBmp(outArrayClasses, C, outFile);
-            slog::info << "File : " << fileName << " was created" << slog::endl;
+            writeClasses(outputClasses(output_data + W * H * C * image, C, H, W,
+                                       cv::Rect(0, 0, static_cast<int>(W), static_cast<int>(H))), C, image);
         }
         // -----------------------------------------------------------------------------------------------------
     }
@@ -34,6 +34,19 @@ static const char custom_cpu_library_message[] = "Required for CPU custom layers
 /// @brief message for config argument
 static constexpr char config_message[] = "Path to the configuration file. Default value: \"config\".";
 
+/// @brief message for shape buckets argument
+static const char buckets_message[] = "Optional. Maximum number of input shapes the images are grouped into. " \
+"The shapes are chosen from the sizes of the input images, the network is reshaped and loaded for each of them. " \
+"Default value is 0, every image is resized to the network input.";
+
+/// @brief message for bucket padding policy argument
+static const char bucket_policy_message[] = "Optional. Placement of an image into its shape bucket: " \
+"\"pad\" keeps the resolution and pads with zeros, \"resize\" stretches the image to the bucket, " \
+"\"letterbox\" scales the image keeping its aspect ratio and pads with zeros. Default value is pad.";
+
+/// @brief message for bucket batch size argument
+static const char bucket_batch_message[] = "Optional. Batch size of every shape bucket. Default value is 1.";
+
 /// @brief Define parameter for clDNN custom kernels path <br>
 /// Default is ./lib
 DEFINE_string(c, "", custom_cldnn_message);
@@ -59,6 +72,18 @@ DEFINE_string(d, "CPU", target_device_message);
 /// @brief Define path to plugin config
 DEFINE_string(config, "", config_message);
 
+/// @brief Define parameter for the number of shape buckets <br>
+/// It is a optional parameter
+DEFINE_uint32(buckets, 0, buckets_message);
+
+/// @brief Define parameter for the bucket padding policy <br>
+/// It is a optional parameter
+DEFINE_string(bucket_policy, "pad", bucket_policy_message);
+
+/// @brief Define parameter for the bucket batch size <br>
+/// It is a optional parameter
+DEFINE_uint32(b, 1, bucket_batch_message);
+
 
 /**
 * @brief This function show a help message
@@ -75,4 +100,7 @@ static void showUsage() {
     std::cout << "          Or" << std::endl;
     std::cout << "      -c \"<absolute_path>\"    " << custom_cldnn_message << std::endl;
     std::cout << "    -d \"<device>\"             " << target_device_message << std::endl;
+    std::cout << "    -buckets                  " << buckets_message << std::endl;
+    std::cout << "    -bucket_policy \"<policy>\" " << bucket_policy_message << std::endl;
+    std::cout << "    -b                        " << bucket_batch_message << std::endl;
 }
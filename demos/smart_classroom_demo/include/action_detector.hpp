@@ -117,6 +117,21 @@ public:
     void enqueue(const cv::Mat &frame);
     void fetchResults();
 
+    /**
+    * @brief Carry out Soft Non-Maximum Suppression algorithm under detected actions
+    *
+    * @param detections Detected actions
+    * @param sigma Scale paramter
+    * @param top_k Number of top-score bboxes
+    * @param min_det_conf Minimum detection confidence
+    * @param out_indices Out indices of valid detections
+    */
+    static void SoftNonMaxSuppression(const DetectedActions& detections,
+                                      const float sigma,
+                                      const int top_k,
+                                      const float min_det_conf,
+                                      std::vector<int>* out_indices);
+
 private:
     ActionDetectorConfig config_;
     InferenceEngine::ExecutableNetwork net_;
@@ -198,19 +213,4 @@ private:
                            const NormalizedBBox& variances,
                            const NormalizedBBox& encoded_bbox,
                            const cv::Size& frame_size) const;
-
-     /**
-    * @brief Carry out Soft Non-Maximum Suppression algorithm under detected actions
-    *
-    * @param detections Detected actions
-    * @param sigma Scale paramter
-    * @param top_k Number of top-score bboxes
-    * @param min_det_conf Minimum detection confidence
-    * @param out_indices Out indices of valid detections
-    */
-    void SoftNonMaxSuppression(const DetectedActions& detections,
-                               const float sigma,
-                               const int top_k,
-                               const float min_det_conf,
-                               std::vector<int>* out_indices) const;
 };
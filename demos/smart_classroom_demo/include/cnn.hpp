@@ -6,11 +6,14 @@
 
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <functional>
 
 #include <samples/ocv_common.hpp>
+#include <samples/memory_usage.hpp>
+#include <samples/tensor_view.hpp>
 
 #include <inference_engine.hpp>
 
@@ -31,10 +34,18 @@ struct CnnConfig {
     /** @brief Enabled/disabled status */
     bool enabled{true};
 
-    /** @brief Inference Engine */
-    InferenceEngine::Core ie;
+    /** @brief Inference Engine shared by all networks of the process, it must outlive them */
+    InferenceEngine::Core* ie{nullptr};
     /** @brief Device name */
     std::string deviceName;
+
+    /** @brief Returns the shared Inference Engine, throws if the config was not given one */
+    InferenceEngine::Core& Engine() const {
+        if (nullptr == ie) {
+            throw std::logic_error("Inference Engine is not set for the model " + path_to_model);
+        }
+        return *ie;
+    }
 };
 
 /**
@@ -88,6 +99,20 @@ protected:
     void InferBatch(const std::vector<cv::Mat>& frames,
                     std::function<void(const InferenceEngine::BlobMap&, size_t)> results_fetcher) const;
 
+    /**
+   * @brief Run network in batch mode on warped images. The images are sampled
+   * straight into the input blob without intermediate warped or resized images.
+   *
+   * @param frames Vector of input images
+   * @param transforms Affine maps from pixel coordinates of the warped images
+   * to pixel coordinates of the input images, both of the input image size,
+   * one per frame or none for plain resizing
+   * @param results_fetcher Callback to fetch inference results
+   */
+    void InferBatch(const std::vector<cv::Mat>& frames,
+                    const std::vector<cv::Matx23d>& transforms,
+                    std::function<void(const InferenceEngine::BlobMap&, size_t)> results_fetcher) const;
+
     /** @brief Config */
     Config config_;
     /** @brief Net inputs info */
@@ -102,6 +127,8 @@ protected:
     std::string input_blob_name_;
     /** @brief Names of output blobs */
     std::vector<std::string> output_blobs_names_;
+    /** @brief Output blobs of the InferRequest, they are read in place after each inference */
+    InferenceEngine::BlobMap output_blobs_;
 };
 
 class VectorCNN : public CnnDLSDKBase {
@@ -112,6 +139,8 @@ public:
                  cv::Mat* vector, cv::Size outp_shape = cv::Size()) const;
     void Compute(const std::vector<cv::Mat>& images,
                  std::vector<cv::Mat>* vectors, cv::Size outp_shape = cv::Size()) const;
+    void Compute(const std::vector<cv::Mat>& images, const std::vector<cv::Matx23d>& transforms,
+                 std::vector<cv::Mat>* vectors, cv::Size outp_shape = cv::Size()) const;
 };
 
 class BaseCnnDetection {
@@ -59,3 +59,15 @@ private:
 
 void AlignFaces(std::vector<cv::Mat>* face_images,
                 std::vector<cv::Mat>* landmarks_vec);
+
+/**
+ * @brief Computes the affine maps aligning faces by their landmarks without warping the images.
+ * A map transforms pixel coordinates of the aligned face to pixel coordinates of the face image,
+ * both of the face image size.
+ *
+ * @param face_images Face images
+ * @param landmarks_vec Normalized landmarks of the faces, scaled to the image pixels on return
+ * @return Affine maps for every face
+ */
+std::vector<cv::Matx23d> GetAlignTransforms(const std::vector<cv::Mat>& face_images,
+                                            std::vector<cv::Mat>* landmarks_vec);
@@ -537,7 +537,7 @@ int main(int argc, char* argv[]) {
         // Load action detector
         ActionDetectorConfig action_config(ad_model_path, ad_weights_path);
         action_config.deviceName = FLAGS_d_act;
-        action_config.ie = ie;
+        action_config.ie = &ie;
         action_config.is_async = true;
         action_config.enabled = !ad_model_path.empty();
         action_config.detection_confidence_threshold = static_cast<float>(FLAGS_t_ad);
@@ -548,7 +548,7 @@ int main(int argc, char* argv[]) {
         // Load face detector
         detection::DetectorConfig face_config(fd_model_path, fd_weights_path);
         face_config.deviceName = FLAGS_d_fd;
-        face_config.ie = ie;
+        face_config.ie = &ie;
         face_config.is_async = true;
         face_config.enabled = !fd_model_path.empty();
         face_config.confidence_threshold = static_cast<float>(FLAGS_t_fd);
@@ -561,7 +561,7 @@ int main(int argc, char* argv[]) {
         // Load face detector for face database registration
         detection::DetectorConfig face_registration_det_config(fd_model_path, fd_weights_path);
         face_registration_det_config.deviceName = FLAGS_d_fd;
-        face_registration_det_config.ie = ie;
+        face_registration_det_config.ie = &ie;
         face_registration_det_config.enabled = !fd_model_path.empty();
         face_registration_det_config.is_async = false;
         face_registration_det_config.confidence_threshold = static_cast<float>(FLAGS_t_reg_fd);
@@ -574,7 +574,7 @@ int main(int argc, char* argv[]) {
         reid_config.max_batch_size = 16;
         reid_config.enabled = face_config.enabled && !fr_model_path.empty() && !lm_model_path.empty();
         reid_config.deviceName = FLAGS_d_reid;
-        reid_config.ie = ie;
+        reid_config.ie = &ie;
         VectorCNN face_reid(reid_config);
 
         // Load landmarks detector
@@ -582,7 +582,7 @@ int main(int argc, char* argv[]) {
         landmarks_config.max_batch_size = 16;
         landmarks_config.enabled = face_config.enabled && reid_config.enabled && !lm_model_path.empty();
         landmarks_config.deviceName = FLAGS_d_lm;
-        landmarks_config.ie = ie;
+        landmarks_config.ie = &ie;
         VectorCNN landmarks_detector(landmarks_config);
 
         // Create face gallery
@@ -812,8 +812,8 @@ int main(int argc, char* argv[]) {
                     face_rois.push_back(prev_frame(face.rect));
                 }
                 landmarks_detector.Compute(face_rois, &landmarks, cv::Size(2, 5));
-                AlignFaces(&face_rois, &landmarks);
-                face_reid.Compute(face_rois, &embeddings);
+                auto align_transforms = GetAlignTransforms(face_rois, &landmarks);
+                face_reid.Compute(face_rois, align_transforms, &embeddings);
                 auto ids = face_gallery.GetIDsByEmbeddings(embeddings);
 
                 for (size_t i = 0; i < faces.size(); i++) {
@@ -53,6 +53,7 @@ ActionDetection::ActionDetection(const ActionDetectorConfig& config)
     : BaseCnnDetection(config.enabled, config.is_async), config_(config) {
     if (config.enabled) {
         topoName = "action detector";
+        ModelMemoryReport memoryReport(config.path_to_model);
         CNNNetReader net_reader;
         net_reader.ReadNetwork(config.path_to_model);
         net_reader.ReadWeights(config.path_to_weights);
@@ -82,7 +83,7 @@ ActionDetection::ActionDetection(const ActionDetectorConfig& config)
 
         new_network_ = outputInfo.find(config_.new_loc_blob_name) != outputInfo.end();
         input_name_ = inputInfo.begin()->first;
-        net_ = config_.ie.LoadNetwork(net_reader.getNetwork(), config_.deviceName);
+        net_ = config_.Engine().LoadNetwork(net_reader.getNetwork(), config_.deviceName);
 
         const auto& head_anchors = new_network_ ? config_.new_anchors : config_.old_anchors;
         const int num_heads = head_anchors.size();
@@ -336,7 +337,7 @@ void ActionDetection::GetDetections(const cv::Mat& loc, const cv::Mat& main_conf
 
 void ActionDetection::SoftNonMaxSuppression(const DetectedActions& detections,
         const float sigma, const int top_k, const float min_det_conf,
-        std::vector<int>* out_indices) const {
+        std::vector<int>* out_indices) {
     /** Store input bbox scores **/
     std::vector<float> scores(detections.size());
     for (size_t i = 0; i < detections.size(); ++i) {
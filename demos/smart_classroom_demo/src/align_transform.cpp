@@ -48,25 +48,36 @@ cv::Mat GetTransform(cv::Mat* src, cv::Mat* dst) {
     return m;
 }
 
-void AlignFaces(std::vector<cv::Mat>* face_images,
-                std::vector<cv::Mat>* landmarks_vec) {
+std::vector<cv::Matx23d> GetAlignTransforms(const std::vector<cv::Mat>& face_images,
+                                            std::vector<cv::Mat>* landmarks_vec) {
+    std::vector<cv::Matx23d> transforms;
     if (landmarks_vec->size() == 0) {
-        return;
+        return transforms;
     }
-    CV_Assert(face_images->size() == landmarks_vec->size());
+    CV_Assert(face_images.size() == landmarks_vec->size());
     cv::Mat ref_landmarks = cv::Mat(5, 2, CV_32F);
 
-    for (size_t j = 0; j < face_images->size(); j++) {
+    for (size_t j = 0; j < face_images.size(); j++) {
         for (int i = 0; i < ref_landmarks.rows; i++) {
             ref_landmarks.at<float>(i, 0) =
-                    ref_landmarks_normalized[2 * i] * face_images->at(j).cols;
+                    ref_landmarks_normalized[2 * i] * face_images[j].cols;
             ref_landmarks.at<float>(i, 1) =
-                    ref_landmarks_normalized[2 * i + 1] * face_images->at(j).rows;
-            landmarks_vec->at(j).at<float>(i, 0) *= face_images->at(j).cols;
-            landmarks_vec->at(j).at<float>(i, 1) *= face_images->at(j).rows;
+                    ref_landmarks_normalized[2 * i + 1] * face_images[j].rows;
+            landmarks_vec->at(j).at<float>(i, 0) *= face_images[j].cols;
+            landmarks_vec->at(j).at<float>(i, 1) *= face_images[j].rows;
         }
         cv::Mat m = GetTransform(&ref_landmarks, &landmarks_vec->at(j));
-        cv::warpAffine(face_images->at(j), face_images->at(j), m,
+        transforms.emplace_back(m.at<float>(0, 0), m.at<float>(0, 1), m.at<float>(0, 2),
+                                m.at<float>(1, 0), m.at<float>(1, 1), m.at<float>(1, 2));
+    }
+    return transforms;
+}
+
+void AlignFaces(std::vector<cv::Mat>* face_images,
+                std::vector<cv::Mat>* landmarks_vec) {
+    std::vector<cv::Matx23d> transforms = GetAlignTransforms(*face_images, landmarks_vec);
+    for (size_t j = 0; j < transforms.size(); j++) {
+        cv::warpAffine(face_images->at(j), face_images->at(j), transforms[j],
                        face_images->at(j).size(), cv::WARP_INVERSE_MAP);
     }
 }
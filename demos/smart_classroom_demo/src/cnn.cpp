@@ -22,6 +22,7 @@ bool CnnDLSDKBase::Enabled() const {
 }
 
 void CnnDLSDKBase::Load() {
+    ModelMemoryReport memoryReport(config_.path_to_model);
     CNNNetReader net_reader;
     net_reader.ReadNetwork(config_.path_to_model);
     net_reader.ReadWeights(config_.path_to_weights);
@@ -48,34 +49,50 @@ void CnnDLSDKBase::Load() {
         output_blobs_names_.push_back(item.first);
     }
 
-    executable_network_ = config_.ie.LoadNetwork(net_reader.getNetwork(), config_.deviceName);
+    executable_network_ = config_.Engine().LoadNetwork(net_reader.getNetwork(), config_.deviceName);
     infer_request_ = executable_network_.CreateInferRequest();
+    for (const auto& name : output_blobs_names_)  {
+        output_blobs_[name] = infer_request_.GetBlob(name);
+    }
+}
+
+void CnnDLSDKBase::InferBatch(
+        const std::vector<cv::Mat>& frames,
+        std::function<void(const InferenceEngine::BlobMap&, size_t)> fetch_results) const {
+    InferBatch(frames, {}, fetch_results);
 }
 
 void CnnDLSDKBase::InferBatch(
         const std::vector<cv::Mat>& frames,
+        const std::vector<cv::Matx23d>& transforms,
         std::function<void(const InferenceEngine::BlobMap&, size_t)> fetch_results) const {
+    CV_Assert(transforms.empty() || transforms.size() == frames.size());
     if (!config_.enabled) {
         return;
     }
     Blob::Ptr input = infer_request_.GetBlob(input_blob_name_);
     const size_t batch_size = input->getTensorDesc().getDims()[0];
+    const cv::Size input_size(static_cast<int>(input->getTensorDesc().getDims()[3]),
+                              static_cast<int>(input->getTensorDesc().getDims()[2]));
 
     size_t num_imgs = frames.size();
     for (size_t batch_i = 0; batch_i < num_imgs; batch_i += batch_size) {
         const size_t current_batch_size = std::min(batch_size, num_imgs - batch_i);
         for (size_t b = 0; b < current_batch_size; b++) {
-            matU8ToBlob<uint8_t>(frames[batch_i + b], input, b);
+            const cv::Mat& frame = frames[batch_i + b];
+            if (transforms.empty()) {
+                matU8ToBlob<uint8_t>(frame, input, b);
+            } else {
+                cv::Matx23d transform = composeAffine(resizeAffine(frame.size(), input_size),
+                                                      transforms[batch_i + b]);
+                warpAffineToBlob<uint8_t>(frame, transform, input, b);
+            }
         }
 
         infer_request_.SetBatch(current_batch_size);
         infer_request_.Infer();
 
-        InferenceEngine::BlobMap blobs;
-        for (const auto& name : output_blobs_names_)  {
-            blobs[name] = infer_request_.GetBlob(name);
-        }
-        fetch_results(blobs, current_batch_size);
+        fetch_results(output_blobs_, current_batch_size);
     }
 }
 
@@ -111,25 +128,27 @@ void VectorCNN::Compute(const cv::Mat& frame,
 
 void VectorCNN::Compute(const std::vector<cv::Mat>& images, std::vector<cv::Mat>* vectors,
                                      cv::Size outp_shape) const {
+    Compute(images, {}, vectors, outp_shape);
+}
+
+void VectorCNN::Compute(const std::vector<cv::Mat>& images, const std::vector<cv::Matx23d>& transforms,
+                        std::vector<cv::Mat>* vectors, cv::Size outp_shape) const {
     if (images.empty()) {
         return;
     }
     vectors->clear();
     auto results_fetcher = [vectors, outp_shape](const InferenceEngine::BlobMap& outputs, size_t batch_size) {
         for (auto&& item : outputs) {
-            InferenceEngine::Blob::Ptr blob = item.second;
+            const InferenceEngine::Blob::Ptr& blob = item.second;
             if (blob == nullptr) {
                 THROW_IE_EXCEPTION << "VectorCNN::Compute() Invalid blob '" << item.first << "'";
             }
-            InferenceEngine::SizeVector ie_output_dims = blob->getTensorDesc().getDims();
-            std::vector<int> blob_sizes(ie_output_dims.size(), 0);
-            for (size_t i = 0; i < blob_sizes.size(); ++i) {
-                blob_sizes[i] = ie_output_dims[i];
-            }
-            cv::Mat out_blob(blob_sizes, CV_32F, blob->buffer());
+            const TensorView<const float> out_blob = tensorView<const float>(blob);
             for (size_t b = 0; b < batch_size; b++) {
-                cv::Mat blob_wrapper(out_blob.size[1], 1, CV_32F,
-                                     reinterpret_cast<void*>((out_blob.ptr<float>(0) + b * out_blob.size[1])));
+                // The embedding outlives the inference, so it is the only copy of the output
+                const TensorView<const float> embedding = out_blob[b];
+                cv::Mat blob_wrapper(static_cast<int>(embedding.size()), 1, CV_32F,
+                                     const_cast<float*>(embedding.begin()));
                 vectors->emplace_back();
                 if (outp_shape != cv::Size())
                     blob_wrapper = blob_wrapper.reshape(1, {outp_shape.height, outp_shape.width});
@@ -137,5 +156,5 @@ void VectorCNN::Compute(const std::vector<cv::Mat>& images, std::vector<cv::Mat>
             }
         }
     };
-    InferBatch(images, results_fetcher);
+    InferBatch(images, transforms, results_fetcher);
 }
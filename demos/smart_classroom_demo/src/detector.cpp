@@ -76,6 +76,7 @@ FaceDetection::FaceDetection(const DetectorConfig& config) :
     BaseCnnDetection(config.enabled, config.is_async), config_(config) {
     if (config.enabled) {
         topoName = "face detector";
+        ModelMemoryReport memoryReport(config.path_to_model);
         CNNNetReader net_reader;
         net_reader.ReadNetwork(config.path_to_model);
         net_reader.ReadWeights(config.path_to_weights);
@@ -130,7 +131,7 @@ FaceDetection::FaceDetection(const DetectorConfig& config) :
         _output->setLayout(TensorDesc::getLayoutByDims(_output->getDims()));
 
         input_name_ = inputInfo.begin()->first;
-        net_ = config_.ie.LoadNetwork(net_reader.getNetwork(), config_.deviceName);
+        net_ = config_.Engine().LoadNetwork(net_reader.getNetwork(), config_.deviceName);
     }
 }
 
@@ -139,25 +140,23 @@ void FaceDetection::fetchResults() {
     results.clear();
     if (results_fetched_) return;
     results_fetched_ = true;
-    const float *data = request->GetBlob(output_name_)->buffer().as<float *>();
+    const TensorView<const float> data = tensorView<const float>(request->GetBlob(output_name_));
 
     for (int det_id = 0; det_id < max_detections_count_; ++det_id) {
-        const int start_pos = det_id * object_size_;
-
-        const float batchID = data[start_pos];
+        const float batchID = data(0, 0, det_id, 0);
         if (batchID == SSD_EMPTY_DETECTIONS_INDICATOR) {
             break;
         }
 
-        const float score = std::min(std::max(0.0f, data[start_pos + 2]), 1.0f);
+        const float score = std::min(std::max(0.0f, data(0, 0, det_id, 2)), 1.0f);
         const float x0 =
-                std::min(std::max(0.0f, data[start_pos + 3]), 1.0f) * width_;
+                std::min(std::max(0.0f, data(0, 0, det_id, 3)), 1.0f) * width_;
         const float y0 =
-                std::min(std::max(0.0f, data[start_pos + 4]), 1.0f) * height_;
+                std::min(std::max(0.0f, data(0, 0, det_id, 4)), 1.0f) * height_;
         const float x1 =
-                std::min(std::max(0.0f, data[start_pos + 5]), 1.0f) * width_;
+                std::min(std::max(0.0f, data(0, 0, det_id, 5)), 1.0f) * width_;
         const float y1 =
-                std::min(std::max(0.0f, data[start_pos + 6]), 1.0f) * height_;
+                std::min(std::max(0.0f, data(0, 0, det_id, 6)), 1.0f) * height_;
 
         DetectedObject object;
         object.confidence = score;
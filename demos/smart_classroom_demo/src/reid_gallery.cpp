@@ -75,8 +75,10 @@ RegistrationStatus EmbeddingsGallery::RegisterIdentity(const std::string& identi
     landmarks_det.Compute(target, &landmarks, cv::Size(2, 5));
     std::vector<cv::Mat> images = {target};
     std::vector<cv::Mat> landmarks_vec = {landmarks};
-    AlignFaces(&images, &landmarks_vec);
-    image_reid.Compute(images[0], &embedding);
+    auto transforms = GetAlignTransforms(images, &landmarks_vec);
+    std::vector<cv::Mat> embeddings;
+    image_reid.Compute(images, transforms, &embeddings);
+    embedding = embeddings[0];
     return RegistrationStatus::SUCCESS;
 }
 
@@ -19,6 +19,7 @@
 #include <samples/slog.hpp>
 #include <samples/args_helper.hpp>
 #include <samples/ocv_common.hpp>
+#include <samples/shape_buckets.hpp>
 
 #include "super_resolution_demo.h"
 
@@ -51,6 +52,102 @@ bool ParseAndCheckCommandLine(int argc, char *argv[]) {
     return true;
 }
 
+/**
+ * @brief Converts a region of a network output with 3 planes in [0, 1] range to an image
+ */
+cv::Mat outputImage(float* data, size_t h, size_t w, const cv::Rect& roi) {
+    size_t nunOfPixels = w * h;
+    std::vector<cv::Mat> imgPlanes{cv::Mat(h, w, CV_32FC1, data)(roi),
+                                   cv::Mat(h, w, CV_32FC1, data + nunOfPixels)(roi),
+                                   cv::Mat(h, w, CV_32FC1, data + nunOfPixels * 2)(roi)};
+    for (auto & img : imgPlanes)
+        img.convertTo(img, CV_8UC1, 255);
+
+    cv::Mat resultImg;
+    cv::merge(imgPlanes, resultImg);
+    return resultImg;
+}
+
+void saveResult(const cv::Mat& resultImg, size_t i) {
+    if (FLAGS_show) {
+        cv::imshow("result", resultImg);
+        cv::waitKey();
+    }
+
+    std::string outImgName = std::string("sr_" + std::to_string(i + 1) + ".png");
+    cv::imwrite(outImgName, resultImg);
+}
+
+/**
+ * @brief Groups the images into shape buckets chosen from their sizes, the network is reshaped and loaded
+ * once per bucket, so images of any size are processed instead of only the ones of the network input size
+ */
+void processWithShapeBuckets(Core& ie, CNNNetwork& network, const std::vector<std::string>& imageNames,
+                             const std::string& lrInputBlobName) {
+    std::vector<cv::Mat> inputImages;
+    std::vector<cv::Size> sizes;
+    for (const auto &i : imageNames) {
+        cv::Mat img = cv::imread(i);
+        if (img.empty()) {
+            slog::warn << "Image " + i + " cannot be read!" << slog::endl;
+            continue;
+        }
+        inputImages.push_back(img);
+        sizes.push_back(img.size());
+    }
+    if (inputImages.empty()) throw std::logic_error("Valid input images were not found!");
+
+    OutputsDataMap outputInfo(network.getOutputsInfo());
+    const std::string outputName = outputInfo.begin()->first;
+    for (auto &item : outputInfo) {
+        item.second->setPrecision(Precision::FP32);
+    }
+
+    const bool twoInputs = network.getInputsInfo().size() == 2;
+    const int bucketAlignment = 8;
+    std::vector<cv::Size> buckets = chooseBuckets(sizes, FLAGS_buckets, bucketAlignment);
+    for (const auto& bucket : buckets) {
+        slog::info << "Shape bucket " << bucket.width << "x" << bucket.height << slog::endl;
+    }
+
+    slog::info << "Loading model to the device" << slog::endl;
+    ShapeBucketedBatcher batcher(ie, network, FLAGS_d, buckets, FLAGS_b, paddingPolicyFromString(FLAGS_bucket_policy),
+        [&](InferRequest& request, size_t slot, const cv::Mat& input) {
+            Blob::Ptr lrInputBlob = request.GetBlob(lrInputBlobName);
+            matU8ToBlob<float_t>(input, lrInputBlob, static_cast<int>(slot));
+            if (twoInputs) {
+                const std::string bicInputBlobName = "1";
+                Blob::Ptr bicInputBlob = request.GetBlob(bicInputBlobName);
+
+                int w = bicInputBlob->getTensorDesc().getDims()[3];
+                int h = bicInputBlob->getTensorDesc().getDims()[2];
+
+                cv::Mat resized;
+                cv::resize(input, resized, cv::Size(w, h), 0, 0, cv::INTER_CUBIC);
+
+                matU8ToBlob<float_t>(resized, bicInputBlob, static_cast<int>(slot));
+            }
+        },
+        [&](InferRequest& request, const ShapeBucketedBatcher::Placement& placement) {
+            const Blob::Ptr outputBlob = request.GetBlob(outputName);
+            size_t numOfChannels = outputBlob->getTensorDesc().getDims()[1];
+            size_t h = outputBlob->getTensorDesc().getDims()[2];
+            size_t w = outputBlob->getTensorDesc().getDims()[3];
+            /** The image region is scaled by the upsampling factor of the network **/
+            cv::Rect roi(0, 0, static_cast<int>(placement.roi.width * w / placement.bucket.width),
+                         static_cast<int>(placement.roi.height * h / placement.bucket.height));
+            float* outputData = outputBlob->buffer().as<float*>() + placement.slot * w * h * numOfChannels;
+            saveResult(outputImage(outputData, h, w, roi), placement.id);
+        });
+
+    slog::info << "Start inference" << slog::endl;
+    for (size_t i = 0; i < inputImages.size(); i++) {
+        batcher.push(i, inputImages[i]);
+    }
+    batcher.flush();
+    slog::info << "Shape buckets: " << batcher.report() << slog::endl;
+}
+
 int main(int argc, char *argv[]) {
     try {
         slog::info << "InferenceEngine: " << GetInferenceEngineVersion() << slog::endl;
@@ -122,6 +219,12 @@ int main(int argc, char *argv[]) {
 
         const std::string lrInputBlobName = "0";
 
+        if (FLAGS_buckets > 0) {
+            processWithShapeBuckets(ie, network, imageNames, lrInputBlobName);
+            slog::info << "Execution successful" << slog::endl;
+            return 0;
+        }
+
         /** Collect images**/
         std::vector<cv::Mat> inputImages;
         for (const auto &i : imageNames) {
@@ -225,22 +328,8 @@ int main(int argc, char *argv[]) {
         slog::info << "Output size [N,C,H,W]: " << numOfImages << ", " << numOfChannels << ", " << h << ", " << w << slog::endl;
 
         for (size_t i = 0; i < numOfImages; ++i) {
-            std::vector<cv::Mat> imgPlanes{cv::Mat(h, w, CV_32FC1, &(outputData[i * nunOfPixels * numOfChannels])),
-                                           cv::Mat(h, w, CV_32FC1, &(outputData[i * nunOfPixels * numOfChannels + nunOfPixels])),
-                                           cv::Mat(h, w, CV_32FC1, &(outputData[i * nunOfPixels * numOfChannels + nunOfPixels * 2]))};
-            for (auto & img : imgPlanes)
-                img.convertTo(img, CV_8UC1, 255);
-
-            cv::Mat resultImg;
-            cv::merge(imgPlanes, resultImg);
-
-            if (FLAGS_show) {
-                cv::imshow("result", resultImg);
-                cv::waitKey();
-            }
-
-            std::string outImgName = std::string("sr_" + std::to_string(i + 1) + ".png");
-            cv::imwrite(outImgName, resultImg);
+            saveResult(outputImage(&outputData[i * nunOfPixels * numOfChannels], h, w,
+                                   cv::Rect(0, 0, static_cast<int>(w), static_cast<int>(h))), i);
         }
         // -----------------------------------------------------------------------------------------------------
     }
@@ -38,6 +38,21 @@ static const char custom_cldnn_message[] = "Required for GPU custom kernels."\
 /// @brief message for show argument
 static const char show_processed_images[] = "Optional. Show processed images. Default value is false.";
 
+/// @brief message for shape buckets argument
+static const char buckets_message[] = "Optional. Maximum number of input shapes the images are grouped into. " \
+                                      "The shapes are chosen from the sizes of the input images, the network is " \
+                                      "reshaped and loaded for each of them. Default value is 0, only the images " \
+                                      "of the network input size are processed.";
+
+/// @brief message for bucket padding policy argument
+static const char bucket_policy_message[] = "Optional. Placement of an image into its shape bucket: " \
+                                            "\"pad\" keeps the resolution and pads with zeros, \"resize\" stretches " \
+                                            "the image to the bucket, \"letterbox\" scales the image keeping its " \
+                                            "aspect ratio and pads with zeros. Default value is pad.";
+
+/// @brief message for bucket batch size argument
+static const char bucket_batch_message[] = "Optional. Batch size of every shape bucket. Default value is 1.";
+
 
 /// @brief Define flag for showing help message <br>
 DEFINE_bool(h, false, help_message);
@@ -65,6 +80,18 @@ DEFINE_string(c, "", custom_cldnn_message);
 /// It is an optional parameter
 DEFINE_bool(show, false, show_processed_images);
 
+/// @brief Define parameter for the number of shape buckets <br>
+/// It is an optional parameter
+DEFINE_uint32(buckets, 0, buckets_message);
+
+/// @brief Define parameter for the bucket padding policy <br>
+/// It is an optional parameter
+DEFINE_string(bucket_policy, "pad", bucket_policy_message);
+
+/// @brief Define parameter for the bucket batch size <br>
+/// It is an optional parameter
+DEFINE_uint32(b, 1, bucket_batch_message);
+
 /**
 * @brief This function show a help message
 */
@@ -78,4 +105,7 @@ static void showUsage() {
     std::cout << "    -m \"<path>\"             " << model_message << std::endl;
     std::cout << "    -d \"<device>\"           " << target_device_message << std::endl;
     std::cout << "    -show                   " << show_processed_images << std::endl;
+    std::cout << "    -buckets                " << buckets_message << std::endl;
+    std::cout << "    -bucket_policy          " << bucket_policy_message << std::endl;
+    std::cout << "    -b                      " << bucket_batch_message << std::endl;
 }
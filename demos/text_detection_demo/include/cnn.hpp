@@ -19,7 +19,8 @@ class Cnn {
     void Init(const std::string &model_path, Core & ie, const std::string & deviceName,
               const cv::Size &new_input_resolution = cv::Size());
 
-    InferenceEngine::BlobMap Infer(const cv::Mat &frame);
+    // Returns the output blobs of the request, they are overwritten by the next call
+    const InferenceEngine::BlobMap& Infer(const cv::Mat &frame);
 
     bool is_initialized() const {return is_initialized_;}
 
@@ -36,6 +37,7 @@ class Cnn {
     float* input_data_;
     InferRequest infer_request_;
     std::vector<std::string> output_names_;
+    InferenceEngine::BlobMap output_blobs_;
 
     double time_elapsed_;
     size_t ncalls_;
@@ -9,7 +9,15 @@
 #include <inference_engine.hpp>
 #include <opencv2/opencv.hpp>
 
+#include <samples/tensor_view.hpp>
+
 using namespace InferenceEngine;
 
+cv::Mat decodeImageByJoin(const TensorView<const float> &cls_scores, const TensorView<const float> &link_scores,
+                          float cls_conf_threshold, float link_conf_threshold);
+
+std::vector<cv::RotatedRect> maskToBoxes(const cv::Mat &mask, float min_area, float min_height,
+                                         cv::Size image_size);
+
 std::vector<cv::RotatedRect> postProcess(const InferenceEngine::BlobMap &blobs, const cv::Size& image_size,
                                          float cls_conf_threshold, float link_conf_threshold);
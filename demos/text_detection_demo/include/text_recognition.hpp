@@ -7,4 +7,7 @@
 #include <string>
 #include <vector>
 
-std::string CTCGreedyDecoder(const std::vector<float> &data, const std::string& alphabet, char pad_symbol, double *conf);
+#include <samples/tensor_view.hpp>
+
+// The scores are indexed by time step, batch and class
+std::string CTCGreedyDecoder(const TensorView<const float> &data, const std::string& alphabet, char pad_symbol, double *conf);
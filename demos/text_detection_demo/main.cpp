@@ -156,7 +156,7 @@ int main(int argc, char *argv[]) {
             std::chrono::steady_clock::time_point begin_frame = std::chrono::steady_clock::now();
             std::vector<cv::RotatedRect> rects;
             if (text_detection.is_initialized()) {
-                auto blobs = text_detection.Infer(image);
+                const auto& blobs = text_detection.Infer(image);
                 std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
                 rects = postProcess(blobs, orig_image_size, cls_conf_threshold, link_conf_threshold);
                 std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
@@ -206,14 +206,11 @@ int main(int argc, char *argv[]) {
                 std::string res = "";
                 double conf = 1.0;
                 if (text_recognition.is_initialized()) {
-                    auto blobs = text_recognition.Infer(cropped_text);
-                    auto output_shape = blobs.begin()->second->getTensorDesc().getDims();
-                    if (output_shape[2] != kAlphabet.length())
+                    const auto& blobs = text_recognition.Infer(cropped_text);
+                    const TensorView<const float> output_data = tensorView<const float>(blobs.begin()->second);
+                    if (output_data.rank() != 3 || output_data.dim(2) != kAlphabet.length())
                         throw std::runtime_error("The text recognition model does not correspond to alphabet.");
 
-                    float *ouput_data_pointer = blobs.begin()->second->buffer().as<PrecisionTrait<Precision::FP32>::value_type *>();
-                    std::vector<float> output_data(ouput_data_pointer, ouput_data_pointer + output_shape[0] * output_shape[2]);
-
                     std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
                     res = CTCGreedyDecoder(output_data, kAlphabet, kPadSymbol, &conf);
                     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
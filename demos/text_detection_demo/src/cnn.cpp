@@ -69,6 +69,9 @@ void Cnn::Init(const std::string &model_path, Core & ie, const std::string & dev
 
     // --------------------------- Creating infer request ------------------------------------------------
     infer_request_ = executable_network.CreateInferRequest();
+    for (const auto &output_name : output_names_) {
+        output_blobs_[output_name] = infer_request_.GetBlob(output_name);
+    }
     // ---------------------------------------------------------------------------------------------------
 
     // --------------------------- Preparing input -------------------------------------------------------
@@ -80,7 +83,7 @@ void Cnn::Init(const std::string &model_path, Core & ie, const std::string & dev
     is_initialized_ = true;
 }
 
-InferenceEngine::BlobMap Cnn::Infer(const cv::Mat &frame) {
+const InferenceEngine::BlobMap& Cnn::Infer(const cv::Mat &frame) {
     std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
 
     cv::Mat image;
@@ -113,16 +116,9 @@ InferenceEngine::BlobMap Cnn::Infer(const cv::Mat &frame) {
     infer_request_.Infer();
     // ---------------------------------------------------------------------------------------------------
 
-    // --------------------------- Processing output -----------------------------------------------------
-
-    InferenceEngine::BlobMap blobs;
-    for (const auto &output_name : output_names_) {
-        blobs[output_name] = infer_request_.GetBlob(output_name);
-    }
-
     std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
     time_elapsed_ += std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
     ncalls_++;
 
-    return blobs;
+    return output_blobs_;
 }
@@ -12,13 +12,19 @@
 #include <stdexcept>
 
 namespace  {
-    void softmax(const std::vector<float>::const_iterator& begin, const std::vector<float>::const_iterator& end, int *argmax, float *prob) {
-        auto max_element = std::max_element(begin, end);
-        *argmax = static_cast<int>(std::distance(begin, max_element));
-        float max_val = *max_element;
+    void softmax(const TensorView<const float>& data, size_t step, int *argmax, float *prob) {
+        const size_t num_classes = data.dim(2);
+        size_t max_id = 0;
+        for (size_t i = 1; i < num_classes; i++) {
+            if (data(step, 0, i) > data(step, 0, max_id)) {
+                max_id = i;
+            }
+        }
+        *argmax = static_cast<int>(max_id);
+        float max_val = data(step, 0, max_id);
         double sum = 0;
-        for (auto i = begin; i != end; i++) {
-           sum += std::exp((*i) - max_val);
+        for (size_t i = 0; i < num_classes; i++) {
+           sum += std::exp(data(step, 0, i) - max_val);
         }
         if (std::fabs(sum) < std::numeric_limits<double>::epsilon()) {
             throw std::logic_error("sum can't be equal to zero");
@@ -27,17 +33,16 @@ namespace  {
     }
 }  // namespace
 
-std::string CTCGreedyDecoder(const std::vector<float> &data, const std::string& alphabet, char pad_symbol, double *conf) {
+std::string CTCGreedyDecoder(const TensorView<const float> &data, const std::string& alphabet, char pad_symbol, double *conf) {
     std::string res = "";
     bool prev_pad = false;
     *conf = 1;
 
-    const int num_classes = alphabet.length();
-    for (std::vector<float>::const_iterator it = data.begin(); it != data.end(); it += num_classes) {
+    for (size_t step = 0; step < data.dim(0); step++) {
       int argmax;
       float prob;
 
-      softmax(it, it + num_classes, &argmax, &prob);
+      softmax(data, step, &argmax, &prob);
 
       (*conf) *= prob;
 
@@ -24,6 +24,7 @@ from functools import partial
 
 import numpy as np
 
+from ..annotation_store import write_annotation_store, identifier_index
 from ..representation import ReIdentificationClassificationAnnotation
 from ..utils import get_path
 from ..data_analyzer import BaseDataAnalyzer
@@ -58,18 +59,19 @@ def build_argparser():
 
 def make_subset(annotation, size, seed=666):
     def make_subset_pairwise(annotation, size):
-        def get_pairs(pairs_list):
-            pairs_set = set()
-            for identifier in pairs_list:
-                next_annotation = next(
-                    pair_annotation for pair_annotation in annotation if pair_annotation.identifier == identifier
-                )
-                positive_pairs = get_pairs(next_annotation.positive_pairs)
-                negative_pairs = get_pairs(next_annotation.negative_pairs)
-                pairs_set.add(next_annotation)
-                pairs_set.update(positive_pairs)
-                pairs_set.update(negative_pairs)
-            return pairs_set
+        index_of = identifier_index(annotation)
+
+        def add_pairs(position, subsample_set):
+            # positions are collected instead of representations, because store representations are loaded on access
+            pending = [position]
+            while pending:
+                position = pending.pop()
+                if position in subsample_set:
+                    continue
+                subsample_set.add(position)
+                pair_annotation = annotation[position]
+                pending.extend(index_of(identifier) for identifier in pair_annotation.positive_pairs)
+                pending.extend(index_of(identifier) for identifier in pair_annotation.negative_pairs)
 
         subsample_set = set()
         while len(subsample_set) < size:
@@ -79,12 +81,8 @@ def make_subset(annotation, size, seed=666):
             negative_pairs = annotation_for_subset.negative_pairs
             if len(positive_pairs) + len(negative_pairs) == 0:
                 continue
-            updated_pairs = set()
-            updated_pairs.add(annotation_for_subset)
-            updated_pairs.update(get_pairs(positive_pairs))
-            updated_pairs.update(get_pairs(negative_pairs))
-            subsample_set.update(updated_pairs)
-        return list(subsample_set)
+            add_pairs(int(ann_ind[0]), subsample_set)
+        return [annotation[position] for position in sorted(subsample_set)]
 
     np.random.seed(seed)
     dataset_size = len(annotation)
@@ -94,7 +92,8 @@ def make_subset(annotation, size, seed=666):
     if isinstance(annotation[-1], ReIdentificationClassificationAnnotation):
         return make_subset_pairwise(annotation, size)
 
-    return list(np.random.choice(annotation, size=size, replace=False))
+    # positions are sampled, so only the selected representations are loaded from the annotation store
+    return [annotation[position] for position in np.random.choice(dataset_size, size=size, replace=False)]
 
 
 def main():
@@ -139,9 +138,7 @@ def main():
 
 def save_annotation(annotation, meta, annotation_file, meta_file):
     if annotation_file:
-        with annotation_file.open('wb') as file:
-            for representation in annotation:
-                representation.dump(file)
+        write_annotation_store(annotation, annotation_file)
     if meta_file and meta:
         with meta_file.open('wt') as file:
             json.dump(meta, file)
@@ -0,0 +1,203 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import json
+import mmap
+import pickle
+import struct
+import zlib
+from collections.abc import Sequence
+from pathlib import Path
+
+import numpy as np
+
+from .utils import get_path
+
+# Layout of the annotation store file:
+#   magic | pickled representations | columns | json header | header size | magic
+# The columns are aligned arrays of the record offsets, the identifier keys and the identifier hash index.
+STORE_MAGIC = b'ACSTORE1'
+STORE_VERSION = 1
+_TRAILER = struct.Struct('<Q8s')
+_COLUMN_ALIGNMENT = 8
+
+
+def _identifier_key(identifier):
+    # repr is stable between processes and gives the same key for equal identifiers of different objects
+    return repr(identifier).encode('utf-8')
+
+
+def _identifier_hash(key):
+    return zlib.crc32(key)
+
+
+def is_annotation_store(annotation_file):
+    with get_path(annotation_file).open('rb') as file:
+        return file.read(len(STORE_MAGIC)) == STORE_MAGIC
+
+
+def write_annotation_store(annotation, store_file: Path):
+    """
+    Writes representations to the annotation store file. The representations are pickled one by one,
+    so the store can be written from an iterator without holding all pickles in memory.
+    """
+    record_offsets = []
+    keys = []
+    with store_file.open('wb') as file:
+        file.write(STORE_MAGIC)
+        offset = len(STORE_MAGIC)
+        for representation in annotation:
+            record_offsets.append(offset)
+            keys.append(_identifier_key(representation.identifier))
+            offset += file.write(pickle.dumps(representation, protocol=pickle.HIGHEST_PROTOCOL))
+        record_offsets.append(offset)
+
+        key_offsets = np.zeros(len(keys) + 1, dtype=np.int64)
+        np.cumsum([len(key) for key in keys], out=key_offsets[1:])
+        columns = {
+            'record_offsets': np.array(record_offsets, dtype=np.int64),
+            'key_offsets': key_offsets,
+            'keys': np.frombuffer(b''.join(keys), dtype=np.uint8),
+            'index': _build_index(keys),
+        }
+
+        header = {'version': STORE_VERSION, 'size': len(keys), 'columns': {}}
+        for name, column in columns.items():
+            padding = -offset % _COLUMN_ALIGNMENT
+            offset += file.write(b'\0' * padding)
+            header['columns'][name] = {'offset': offset, 'dtype': column.dtype.str, 'length': column.size}
+            offset += file.write(column.tobytes())
+
+        header_data = json.dumps(header).encode('utf-8')
+        file.write(header_data)
+        file.write(_TRAILER.pack(len(header_data), STORE_MAGIC))
+
+
+def _build_index(keys):
+    # open addressing hash table with linear probing, the load factor is at most 0.5
+    buckets = 1
+    while buckets < 2 * len(keys):
+        buckets *= 2
+    mask = buckets - 1
+    index = [-1] * buckets
+    for position, key in enumerate(keys):
+        slot = _identifier_hash(key) & mask
+        while index[slot] >= 0:
+            slot = (slot + 1) & mask
+        index[slot] = position
+
+    return np.array(index, dtype=np.int64)
+
+
+class AnnotationStore(Sequence):
+    """
+    Read-only sequence of the representations of an annotation store file. The file is memory-mapped and
+    a representation is unpickled only when it is accessed, so opening the store does not depend on the dataset size.
+    Each access returns a new representation object, changes of the object are not stored.
+    """
+
+    def __init__(self, store_file):
+        self.store_file = get_path(store_file)
+        with self.store_file.open('rb') as file:
+            self._mapping = mmap.mmap(file.fileno(), 0, access=mmap.ACCESS_READ)
+
+        if len(self._mapping) < len(STORE_MAGIC) + _TRAILER.size or self._mapping[:len(STORE_MAGIC)] != STORE_MAGIC:
+            raise ValueError('{} is not an annotation store'.format(self.store_file))
+        header_size, magic = _TRAILER.unpack_from(self._mapping, len(self._mapping) - _TRAILER.size)
+        if magic != STORE_MAGIC:
+            raise ValueError('annotation store {} is truncated'.format(self.store_file))
+        header_end = len(self._mapping) - _TRAILER.size
+        header = json.loads(self._mapping[header_end - header_size:header_end].decode('utf-8'))
+        if header['version'] != STORE_VERSION:
+            raise ValueError('annotation store {} has unsupported version {}'.format(
+                self.store_file, header['version']
+            ))
+
+        self._size = header['size']
+        columns = {
+            name: np.frombuffer(
+                self._mapping, dtype=np.dtype(column['dtype']), count=column['length'], offset=column['offset']
+            )
+            for name, column in header['columns'].items()
+        }
+        self._record_offsets = columns['record_offsets']
+        self._key_offsets = columns['key_offsets']
+        self._keys = columns['keys']
+        self._index = columns['index']
+
+    def __len__(self):
+        return self._size
+
+    def __getitem__(self, item):
+        if isinstance(item, slice):
+            return [self._load(position) for position in range(*item.indices(self._size))]
+
+        position = item + self._size if item < 0 else item
+        if not 0 <= position < self._size:
+            raise IndexError('annotation store index out of range')
+
+        return self._load(position)
+
+    def __iter__(self):
+        for position in range(self._size):
+            yield self._load(position)
+
+    def index_of(self, identifier):
+        """
+        Returns:
+            position of the first representation with the identifier.
+        Raises:
+            KeyError if there is no representation with the identifier.
+        """
+        key = _identifier_key(identifier)
+        mask = self._index.size - 1
+        slot = _identifier_hash(key) & mask
+        while True:
+            position = int(self._index[slot])
+            if position < 0:
+                raise KeyError(identifier)
+            if self._keys[self._key_offsets[position]:self._key_offsets[position + 1]].tobytes() == key:
+                return position
+            slot = (slot + 1) & mask
+
+    def get(self, identifier, default=None):
+        try:
+            return self._load(self.index_of(identifier))
+        except KeyError:
+            return default
+
+    def _load(self, position):
+        start, end = self._record_offsets[position], self._record_offsets[position + 1]
+        return pickle.loads(self._mapping[start:end])
+
+
+def identifier_index(annotation):
+    """
+    Returns:
+        function which gives position of the first representation with the identifier in annotation,
+        the store index is used as is, for other sequences the index is built once.
+    """
+    if isinstance(annotation, AnnotationStore):
+        return annotation.index_of
+
+    positions = {}
+    for position, representation in enumerate(annotation):
+        positions.setdefault(_identifier_key(representation.identifier), position)
+
+    def index_of(identifier):
+        return positions[_identifier_key(identifier)]
+
+    return index_of
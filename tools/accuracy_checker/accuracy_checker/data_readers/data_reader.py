@@ -26,7 +26,7 @@ import nibabel as nib
 
 from ..utils import get_path, read_json, zipped_transform, set_image_metadata
 from ..dependency import ClassProvider
-from ..config import BaseField, StringField, ConfigValidator, ConfigError, DictField
+from ..config import BaseField, StringField, NumberField, ConfigValidator, ConfigError, DictField
 
 
 class DataRepresentation:
@@ -73,6 +73,8 @@ class DataReaderField(BaseField):
 
 class BaseReader(ClassProvider):
     __provider_type__ = 'reader'
+    # readers keeping state of opened sources between reads can not be shared by forked processes
+    multiprocessing_safe = True
 
     def __init__(self, data_source, config=None):
         self.config = config
@@ -148,6 +150,10 @@ class ReaderCombiner(BaseReader):
 
         self.reading_scheme = reading_scheme
 
+    @property
+    def multiprocessing_safe(self):
+        return all(reader.multiprocessing_safe for reader in self.reading_scheme.values())
+
     def read(self, data_id):
         for pattern, reader in self.reading_scheme.items():
             if pattern.match(str(data_id)):
@@ -184,35 +190,99 @@ class ScipyImageReader(BaseReader):
         return np.array(scipy.misc.imread(str(get_path(self.data_source / data_id))))
 
 
+class OpenCVFrameReaderConfig(ConfigValidator):
+    type = StringField()
+    cache_size = NumberField(value_type=int, min_value=0, optional=True)
+    seek_distance = NumberField(value_type=int, min_value=1, optional=True)
+
+
 class OpenCVFrameReader(BaseReader):
     __provider__ = 'opencv_capture'
+    multiprocessing_safe = False
+
+    # numbers of frames of the videos read to the end, shared by all readers
+    _video_lengths = {}
 
     def __init__(self, data_source, config=None):
         super().__init__(data_source, config)
         self.current = -1
+        # the position is unknown after seeking until a frame is read, e.g. seeking beyond the end fails silently
+        self.position_known = True
+
+    def validate_config(self):
+        if self.config:
+            config_validator = OpenCVFrameReaderConfig('opencv_capture_config')
+            config_validator.validate(self.config)
 
     def read(self, data_id):
-        if data_id < 0:
-            raise IndexError('frame with {} index can not be grabbed, non-negative index is expected')
-        if data_id < self.current:
-            self.videocap.set(cv2.CAP_PROP_POS_FRAMES, data_id)
-            self.current = data_id - 1
+        return self._read_frames([data_id])[0]
 
-        return self._read_sequence(data_id)
+    def _read_list(self, data_id):
+        return self._read_frames(data_id)
+
+    def _read_frames(self, frame_ids):
+        for frame_id in frame_ids:
+            if frame_id < 0:
+                raise IndexError('frame with {} index can not be grabbed, non-negative index is expected'.format(
+                    frame_id
+                ))
+
+        frames = {}
+        for frame_id in frame_ids:
+            if frame_id in self.cache:
+                self.cache.move_to_end(frame_id)
+                frames[frame_id] = self.cache[frame_id]
+        # missed frames are decoded in one forward run
+        for frame_id in sorted(set(frame_ids) - set(frames)):
+            frames[frame_id] = self._decode(frame_id)
+
+        # frames kept in the cache or requested several times are shared, so only they are copied
+        result, returned = [], set()
+        for frame_id in frame_ids:
+            shared = frame_id in self.cache or frame_id in returned
+            result.append(frames[frame_id].copy() if shared else frames[frame_id])
+            returned.add(frame_id)
+
+        return result
+
+    def _decode(self, frame_id):
+        video_length = self._video_lengths.get(self.data_source)
+        if video_length is not None and frame_id >= video_length:
+            raise EOFError('frame with {} index does not exists in {}'.format(frame_id, self.data_source))
+        # seeking decodes from the preceding key frame, it is cheaper than decoding a long gap
+        if frame_id <= self.current or frame_id - self.current > self.seek_distance:
+            self.videocap.set(cv2.CAP_PROP_POS_FRAMES, frame_id)
+            self.current = frame_id - 1
+            self.position_known = False
 
-    def _read_sequence(self, data_id):
         frame = None
-        while self.current != data_id:
+        while self.current != frame_id:
             success, frame = self.videocap.read()
-            self.current += 1
             if not success:
-                raise EOFError('frame with {} index does not exists in {}'.format(self.current, self.data_source))
+                if self.position_known:
+                    self._video_lengths[self.data_source] = self.current + 1
+                raise EOFError('frame with {} index does not exists in {}'.format(self.current + 1, self.data_source))
+            self.current += 1
+            self.position_known = True
+            self._cache_frame(self.current, frame)
 
         return frame
 
+    def _cache_frame(self, frame_id, frame):
+        if not self.cache_size:
+            return
+        self.cache[frame_id] = frame
+        self.cache.move_to_end(frame_id)
+        if len(self.cache) > self.cache_size:
+            self.cache.popitem(last=False)
+
     def configure(self):
         self.data_source = get_path(self.data_source)
         self.videocap = cv2.VideoCapture(str(self.data_source))
+        config = self.config or {}
+        self.cache_size = config.get('cache_size', 64)
+        self.seek_distance = config.get('seek_distance', 250)
+        self.cache = OrderedDict()
 
 
 class JSONReaderConfig(ConfigValidator):
@@ -276,6 +346,7 @@ class NumPyReader(BaseReader):
 
 class TensorflowImageReader(BaseReader):
     __provider__ = 'tf_imread'
+    multiprocessing_safe = False
 
     def __init__(self, config=None):
         super().__init__(config)
@@ -14,9 +14,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 """
 
+from collections.abc import Sequence
 from copy import deepcopy
 from pathlib import Path
 
+from .annotation_store import AnnotationStore, is_annotation_store
 from .annotation_converters import BaseFormatConverter, save_annotation, make_subset, analyze_dataset
 from .config import ConfigValidator, StringField, PathField, ListField, DictField, BaseField, NumberField, ConfigError
 from .utils import JSONDecoderWithAutoConversion, read_json, get_path, contains_all
@@ -40,6 +42,7 @@ class DatasetConfig(ConfigValidator):
     subsample_size = BaseField(optional=True)
     subsample_seed = NumberField(value_type=int, min_value=0, optional=True)
     analyze_dataset = BaseField(optional=True)
+    early_termination = DictField(optional=True)
 
 
 class Dataset:
@@ -107,6 +110,12 @@ class Dataset:
     def labels(self):
         return self._meta.get('label_map', {})
 
+    def reorder(self, positions):
+        """
+        Changes the order of processing of the annotation, representations are accessed in the new order lazily.
+        """
+        self._annotation = ReorderedAnnotation(self._annotation, positions)
+
     def __call__(self, context, *args, **kwargs):
         batch_annotation = self.__getitem__(self.iteration)
         self.iteration += 1
@@ -154,9 +163,27 @@ class Dataset:
         return annotation, meta
 
 
+class ReorderedAnnotation(Sequence):
+    def __init__(self, annotation, positions):
+        self._annotation = annotation
+        self._positions = positions
+
+    def __len__(self):
+        return len(self._positions)
+
+    def __getitem__(self, item):
+        if isinstance(item, slice):
+            return [self._annotation[position] for position in self._positions[item]]
+
+        return self._annotation[self._positions[item]]
+
+
 def read_annotation(annotation_file: Path):
     annotation_file = get_path(annotation_file)
+    if is_annotation_store(annotation_file):
+        return AnnotationStore(annotation_file)
 
+    # annotation saved by previous versions is a sequence of pickled representations
     result = []
     with annotation_file.open('rb') as file:
         while True:
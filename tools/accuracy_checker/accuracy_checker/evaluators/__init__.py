@@ -16,9 +16,12 @@ limitations under the License.
 
 from .model_evaluator import ModelEvaluator
 from .pipeline_evaluator import PipeLineEvaluator, get_processing_info
+from .sweep import SweepConfig, SweepEvaluator
 
 __all__ = [
     'ModelEvaluator',
     'PipeLineEvaluator',
+    'SweepConfig',
+    'SweepEvaluator',
     'get_processing_info'
 ]
@@ -0,0 +1,231 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import multiprocessing
+import pickle
+import queue
+import traceback
+from collections import namedtuple
+
+import cv2
+import numpy as np
+
+from ..logging import warning
+
+SharedArray = namedtuple('SharedArray', ['shape', 'dtype', 'offset'])
+
+
+class SequentialDataLoader:
+    """
+    Prepares network inputs of the dataset batches on the calling thread.
+    """
+
+    def __init__(self, prepare_batch):
+        self.prepare_batch = prepare_batch
+
+    def iterate(self, dataset):
+        """
+        Yields:
+            batch id, batch annotation, filled inputs, batch meta and batch identifiers in the dataset order.
+        """
+        for batch_id, batch_annotation in enumerate(dataset):
+            filled_inputs, batch_meta, batch_identifiers = self.prepare_batch(batch_annotation)
+            yield batch_id, batch_annotation, filled_inputs, batch_meta, batch_identifiers
+
+
+class ParallelDataLoader:
+    """
+    Prepares network inputs of the dataset batches in worker processes, so reading and preprocessing
+    overlap with inference. Every prefetched batch has its own shared memory slot the worker writes
+    the input arrays to, the batches are yielded in the dataset order. The slot of a batch is reused
+    after the next batch is requested, so the inputs have to be passed to the launcher before that.
+    The workers are forked, so they share the prepared reader, preprocessor and dataset state.
+    """
+
+    alignment = 64
+    # inputs of later batches may be larger than of the first one, e.g. for datasets of different image sizes
+    slot_reserve = 1.5
+
+    def __init__(self, prepare_batch, workers, prefetch=None):
+        self.prepare_batch = prepare_batch
+        self.workers = workers
+        self.prefetch = max(prefetch or 2 * workers, 1)
+
+    def iterate(self, dataset):
+        try:
+            first_batch = dataset[0]
+        except IndexError:
+            return
+
+        # the first batch is prepared in place to estimate the size of inputs
+        filled_inputs, batch_meta, batch_identifiers = self.prepare_batch(first_batch)
+        slot_size = int(_inputs_size(filled_inputs, self.alignment) * self.slot_reserve) + self.alignment
+        context = multiprocessing.get_context('fork')
+        slots = [context.RawArray('B', slot_size) for _ in range(self.prefetch)]
+        tasks = context.Queue()
+        results = context.Queue()
+        tasks.cancel_join_thread()
+        processes = [
+            context.Process(
+                target=_load_batches, args=(dataset, self.prepare_batch, slots, tasks, results), daemon=True
+            )
+            for _ in range(self.workers)
+        ]
+        for process in processes:
+            process.start()
+
+        try:
+            yield 0, first_batch, filled_inputs, batch_meta, batch_identifiers
+            yield from self._iterate_prefetched(dataset, slots, tasks, results, processes)
+        finally:
+            for _ in processes:
+                tasks.put(None)
+            for process in processes:
+                process.join(1)
+                if process.is_alive():
+                    process.terminate()
+
+    def _iterate_prefetched(self, dataset, slots, tasks, results, processes):
+        free_slots = list(range(len(slots)))
+        dispatched = {}
+        ready = {}
+        next_batch_id = 1
+        finished = False
+        batch_id = 1
+        while True:
+            while free_slots and not finished:
+                try:
+                    dispatched[next_batch_id] = dataset[next_batch_id]
+                except IndexError:
+                    finished = True
+                    break
+                tasks.put((next_batch_id, free_slots.pop()))
+                next_batch_id += 1
+
+            if batch_id not in dispatched:
+                return
+
+            while batch_id not in ready:
+                ready_id, slot_id, payload, error = self._get_result(results, processes)
+                if error:
+                    raise RuntimeError('data loader failed on batch {}:\n{}'.format(ready_id, error))
+                ready[ready_id] = (slot_id, payload)
+
+            slot_id, payload = ready.pop(batch_id)
+            batch_annotation = dispatched.pop(batch_id)
+            packed_inputs, batch_meta, batch_identifiers, annotation_metadata = pickle.loads(payload)
+            for annotation, metadata in zip(batch_annotation, annotation_metadata):
+                annotation.metadata = metadata
+            filled_inputs = _unpack_inputs(packed_inputs, np.frombuffer(slots[slot_id], dtype=np.uint8))
+
+            yield batch_id, batch_annotation, filled_inputs, batch_meta, batch_identifiers
+
+            free_slots.append(slot_id)
+            batch_id += 1
+
+    @staticmethod
+    def _get_result(results, processes):
+        while True:
+            try:
+                return results.get(timeout=1)
+            except queue.Empty:
+                if not all(process.is_alive() for process in processes):
+                    raise RuntimeError('data loader worker exited unexpectedly')
+
+
+def create_data_loader(prepare_batch, reader, workers=0, prefetch=None):
+    if not workers:
+        return SequentialDataLoader(prepare_batch)
+
+    if 'fork' not in multiprocessing.get_all_start_methods():
+        warning('parallel data loading requires fork start method of processes, data will be loaded sequentially')
+        return SequentialDataLoader(prepare_batch)
+
+    if not reader.multiprocessing_safe:
+        warning('{} reader can not be used in several processes, data will be loaded sequentially'.format(
+            reader.__provider__
+        ))
+        return SequentialDataLoader(prepare_batch)
+
+    return ParallelDataLoader(prepare_batch, workers, prefetch)
+
+
+def _load_batches(dataset, prepare_batch, slots, tasks, results):
+    # batches are prepared in parallel by processes, so threads of each process would only compete
+    cv2.setNumThreads(1)
+    buffers = [np.frombuffer(slot, dtype=np.uint8) for slot in slots]
+    while True:
+        task = tasks.get()
+        if task is None:
+            break
+        batch_id, slot_id = task
+        try:
+            batch_annotation = dataset[batch_id]
+            filled_inputs, batch_meta, batch_identifiers = prepare_batch(batch_annotation)
+            packed_inputs = _pack_inputs(filled_inputs, buffers[slot_id])
+            annotation_metadata = [annotation.metadata for annotation in batch_annotation]
+            payload = pickle.dumps((packed_inputs, batch_meta, batch_identifiers, annotation_metadata))
+            results.put((batch_id, slot_id, payload, None))
+        except Exception:  # pylint: disable=W0703
+            results.put((batch_id, slot_id, None, traceback.format_exc()))
+
+
+def _aligned(offset, alignment):
+    return (offset + alignment - 1) // alignment * alignment
+
+
+def _is_shareable(value):
+    return isinstance(value, np.ndarray) and value.dtype != object
+
+
+def _inputs_size(filled_inputs, alignment):
+    size = 0
+    for infer_inputs in filled_inputs:
+        for value in infer_inputs.values():
+            if _is_shareable(value):
+                size = _aligned(size, alignment) + value.nbytes
+
+    return size
+
+
+def _pack_inputs(filled_inputs, buffer, alignment=ParallelDataLoader.alignment):
+    packed_inputs = []
+    offset = 0
+    for infer_inputs in filled_inputs:
+        packed = {}
+        for name, value in infer_inputs.items():
+            start = _aligned(offset, alignment)
+            if _is_shareable(value) and start + value.nbytes <= buffer.size:
+                np.ndarray(value.shape, value.dtype, buffer=buffer, offset=start)[...] = value
+                packed[name] = SharedArray(value.shape, value.dtype.str, start)
+                offset = start + value.nbytes
+            else:
+                # inputs which do not fit the slot are passed through the queue
+                packed[name] = value
+        packed_inputs.append(packed)
+
+    return packed_inputs
+
+
+def _unpack_inputs(packed_inputs, buffer):
+    return [
+        {
+            name: np.ndarray(value.shape, np.dtype(value.dtype), buffer=buffer, offset=value.offset)
+            if isinstance(value, SharedArray) else value
+            for name, value in packed.items()
+        }
+        for packed in packed_inputs
+    ]
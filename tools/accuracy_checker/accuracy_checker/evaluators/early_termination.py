@@ -0,0 +1,279 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import copy
+import warnings
+from collections import Counter, OrderedDict, namedtuple
+
+import numpy as np
+from scipy.special import ndtri
+
+from ..config import ConfigError, ConfigValidator, NumberField
+from ..logging import print_info
+from ..representation import ClassificationAnnotation, DetectionAnnotation, ReIdentificationAnnotation
+
+MetricInterval = namedtuple('MetricInterval', ['name', 'value', 'lower', 'upper', 'decision'])
+
+PASSED = 'passed'
+FAILED = 'failed'
+
+# accuracy is a mean of per image outcomes, so its interval is analytical,
+# the other metrics are evaluated on the whole subset and their intervals are bootstrapped
+ANALYTICAL_METRICS = ('accuracy', )
+BOOTSTRAP_METRICS = ('map', 'cmc', 'reid_map')
+QUERY_METRICS = ('cmc', 'reid_map')
+
+
+class EarlyTerminationConfig(ConfigValidator):
+    confidence = NumberField(optional=True, min_value=0.5, max_value=0.9999)
+    min_size = NumberField(value_type=int, optional=True, min_value=1)
+    check_growth = NumberField(optional=True, min_value=1.01)
+    bootstrap_samples = NumberField(value_type=int, optional=True, min_value=10)
+    seed = NumberField(value_type=int, optional=True, min_value=0)
+
+
+def stratum_of(annotation):
+    """
+    Returns:
+        pair of the phase and the stratum of the annotation. Phases are processed one after another,
+        re-identification gallery comes first, so queries are matched against the complete gallery.
+    """
+
+    if isinstance(annotation, ClassificationAnnotation):
+        return 0, annotation.label
+    if isinstance(annotation, ReIdentificationAnnotation):
+        return int(bool(annotation.query)), annotation.person_id
+    if isinstance(annotation, DetectionAnnotation):
+        return 0, tuple(np.unique(annotation.labels).tolist())
+
+    return 0, None
+
+
+def stratified_order(annotation, seed=0):
+    """
+    Returns positions of the annotation in randomized stratified order: every stratum is shuffled and spread
+    evenly over the order, so each prefix of the order has nearly the same strata proportions as the dataset.
+    """
+
+    random_state = np.random.RandomState(seed)
+    strata = OrderedDict()
+    for position, representation in enumerate(annotation):
+        strata.setdefault(stratum_of(representation), []).append(position)
+
+    keys = []
+    for (phase, _), positions in strata.items():
+        positions = random_state.permutation(positions)
+        offsets = (np.arange(len(positions)) + random_state.uniform(size=len(positions))) / len(positions)
+        keys.extend(zip([phase] * len(positions), offsets, positions))
+
+    return [int(position) for _, _, position in sorted(keys)]
+
+
+def normal_quantile(alpha):
+    return float(ndtri(1 - alpha / 2))
+
+
+def wilson_interval(successes, total, alpha):
+    if not total:
+        return 0.0, 1.0
+
+    z = normal_quantile(alpha)
+    proportion = successes / total
+    denominator = 1 + z * z / total
+    center = (proportion + z * z / (2 * total)) / denominator
+    half_width = z * np.sqrt(proportion * (1 - proportion) / total + z * z / (4 * total * total)) / denominator
+
+    return max(center - half_width, 0.0), min(center + half_width, 1.0)
+
+
+def decide(lower, upper, reference, threshold):
+    """
+    Resolves the check of the metric against the reference the way the presenter does:
+    the check passes if the difference is less than the threshold.
+    """
+
+    if reference - threshold < lower and upper < reference + threshold:
+        return PASSED
+    if upper <= reference - threshold or lower >= reference + threshold:
+        return FAILED
+
+    return None
+
+
+class EarlyTermination:
+    """
+    Stops the evaluation as soon as confidence intervals of the metrics with reference and threshold
+    resolve the check: all of them pass or any of them fails.
+
+    Intervals are computed on the growing prefix of the dataset processed in stratified order.
+    The error probability is split between the checked metrics and spent over the repeated checks:
+    the k-th check uses alpha * 6 / (pi^2 k^2), these shares sum to alpha, so the probability of a wrong
+    decision over all checks does not exceed 1 - confidence however many checks are made.
+    """
+
+    def __init__(self, metric_executor, config=None, dataset_size=None):
+        config = config or {}
+        EarlyTerminationConfig('early_termination').validate(config)
+        self.confidence = config.get('confidence', 0.95)
+        self.check_growth = config.get('check_growth', 1.25)
+        self.bootstrap_samples = config.get('bootstrap_samples', 200)
+        self.seed = config.get('seed', 0)
+        self.dataset_size = dataset_size
+
+        self.metrics = [
+            metric for metric in metric_executor.metrics if metric.reference is not None and metric.threshold is not None
+        ]
+        if not self.metrics:
+            raise ConfigError('early termination requires at least one metric with reference and threshold')
+        for metric in self.metrics:
+            if metric.metric_type not in ANALYTICAL_METRICS + BOOTSTRAP_METRICS:
+                raise ConfigError('early termination does not support {} metric, supported metrics: {}'.format(
+                    metric.metric_type, ', '.join(ANALYTICAL_METRICS + BOOTSTRAP_METRICS)
+                ))
+        self.alpha = (1 - self.confidence) / len(self.metrics)
+
+        self.check_alpha = self.alpha
+
+        self.next_check = config.get('min_size', 200)
+        self.checks = 0
+        self.intervals = []
+        self.processed = 0
+        self.stopped = False
+        self._outcomes = {metric.name: [0, 0] for metric in self.metrics}
+        self._random_state = np.random.RandomState(self.seed)
+
+    def should_stop(self, annotations, predictions):
+        for metric in self.metrics:
+            if metric.metric_type in ANALYTICAL_METRICS:
+                self._update_outcomes(metric, annotations[self.processed:], predictions[self.processed:])
+        self.processed = len(annotations)
+
+        if self.processed < self.next_check:
+            return False
+        self.next_check = max(self.processed + 1, int(self.processed * self.check_growth))
+        self.checks += 1
+        self.check_alpha = self.alpha * 6 / (np.pi ** 2 * self.checks ** 2)
+
+        self.intervals = [self._interval(metric, annotations, predictions) for metric in self.metrics]
+        decisions = [interval.decision for interval in self.intervals]
+        self.stopped = FAILED in decisions or all(decision == PASSED for decision in decisions)
+
+        return self.stopped
+
+    def _update_outcomes(self, metric, annotations, predictions):
+        metric_fn = metric.metric_fn
+        outcomes = self._outcomes[metric.name]
+        for annotation, prediction in zip(annotations, predictions):
+            annotation, prediction = metric_fn._resolve_representation_containers(annotation, prediction)
+            outcomes[0] += int(annotation.label in prediction.top_k(metric_fn.top_k))
+            outcomes[1] += 1
+
+    def _interval(self, metric, annotations, predictions):
+        if metric.metric_type in ANALYTICAL_METRICS:
+            successes, total = self._outcomes[metric.name]
+            value = successes / total if total else 0.0
+            lower, upper = wilson_interval(successes, total, self.check_alpha)
+        else:
+            value, lower, upper = self._bootstrap_interval(metric, annotations, predictions)
+
+        if lower is None:
+            return MetricInterval(metric.name, value, None, None, None)
+
+        # references are given in the scale of the presented values, e.g. percents
+        scale = float(np.mean(metric.metric_fn.meta.get('scale', 100)))
+        value, lower, upper = value * scale, lower * scale, upper * scale
+
+        return MetricInterval(
+            metric.name, value, lower, upper, decide(lower, upper, metric.reference, metric.threshold)
+        )
+
+    def _bootstrap_interval(self, metric, annotations, predictions):
+        resolved = [
+            metric.metric_fn._resolve_representation_containers(annotation, prediction)
+            for annotation, prediction in zip(annotations, predictions)
+        ]
+        fixed, sampled = [], list(range(len(resolved)))
+        if metric.metric_type in QUERY_METRICS:
+            # the gallery precedes the queries, so only queries are resampled when the gallery is complete
+            fixed = [position for position, (annotation, _) in enumerate(resolved) if not annotation.query]
+            sampled = [position for position, (annotation, _) in enumerate(resolved) if annotation.query]
+            if not sampled:
+                return None, None, None
+
+        value = self._evaluate(metric, resolved, fixed + sampled)
+        if value is None:
+            return None, None, None
+
+        values = []
+        for _ in range(self.bootstrap_samples):
+            resampled = self._random_state.choice(sampled, size=len(sampled), replace=True).tolist()
+            resampled_value = self._evaluate(metric, resolved, fixed + resampled)
+            if resampled_value is not None:
+                values.append(resampled_value)
+        if len(values) < self.bootstrap_samples / 2:
+            return value, None, None
+
+        lower, upper = np.percentile(values, [50 * self.check_alpha, 100 - 50 * self.check_alpha])
+
+        return value, float(lower), float(upper)
+
+    @staticmethod
+    def _evaluate(metric, resolved, positions):
+        annotations, predictions = [], []
+        copies = Counter()
+        for position in positions:
+            annotation, prediction = resolved[position]
+            if copies[position]:
+                # metrics match objects of an image by its identifier, so a repeated image gets its own one
+                annotation, prediction = copy.copy(annotation), copy.copy(prediction)
+                annotation.identifier = prediction.identifier = (annotation.identifier, copies[position])
+            copies[position] += 1
+            annotations.append(annotation)
+            predictions.append(prediction)
+
+        metric_fn = metric.metric_fn
+        # metrics keep class names of the last evaluation in meta, the final evaluation should not depend on checks
+        meta = copy.deepcopy(metric_fn.meta)
+        try:
+            with warnings.catch_warnings():
+                warnings.simplefilter('ignore')
+                value = metric_fn.evaluate(annotations, predictions)
+        except (RuntimeError, ValueError, ZeroDivisionError):
+            # e.g. no valid queries in the subset
+            return None
+        finally:
+            metric_fn.meta = meta
+
+        value = np.nanmean(value) if np.size(value) else np.nan
+
+        return None if np.isnan(value) else float(value)
+
+    def report(self, output_callback=print_info):
+        if not self.stopped:
+            output_callback('early termination: the check is not resolved before the end of the dataset')
+            return
+
+        output_callback('early termination: evaluation stopped after {} of {} objects'.format(
+            self.processed, self.dataset_size
+        ))
+        for interval in self.intervals:
+            if interval.lower is None:
+                output_callback('{}: interval is not available'.format(interval.name))
+                continue
+            output_callback('{}: {:.2f}, {:.2%} confidence interval [{:.2f}, {:.2f}] {}'.format(
+                interval.name, interval.value, 1 - self.check_alpha, interval.lower, interval.upper,
+                (interval.decision or 'unresolved').upper()
+            ))
@@ -29,11 +29,14 @@ from ..preprocessor import PreprocessingExecutor
 from ..adapters import create_adapter
 from ..config import ConfigError
 from ..data_readers import BaseReader
+from .data_loader import create_data_loader
+from .early_termination import EarlyTermination, stratified_order
 
 
 class ModelEvaluator:
     def __init__(
-            self, launcher, input_feeder, adapter, reader, preprocessor, postprocessor, dataset, metric, async_mode
+            self, launcher, input_feeder, adapter, reader, preprocessor, postprocessor, dataset, metric, async_mode,
+            data_loader_workers=0, data_loader_prefetch=None, early_termination=None
     ):
         self.launcher = launcher
         self.input_feeder = input_feeder
@@ -44,12 +47,17 @@ class ModelEvaluator:
         self.dataset = dataset
         self.metric_executor = metric
         self.dataset_processor = self.process_dataset if not async_mode else self.process_dataset_async
+        self.data_loader = create_data_loader(self._get_batch_input, reader, data_loader_workers, data_loader_prefetch)
+        self.early_termination = early_termination
 
         self._annotations = []
         self._predictions = []
 
     @classmethod
-    def from_configs(cls, launcher_config, dataset_config):
+    def from_configs(
+            cls, launcher_config, dataset_config, data_loader_workers=0, data_loader_prefetch=None,
+            early_termination=False
+    ):
         dataset_name = dataset_config['name']
         data_reader_config = dataset_config.get('reader', 'opencv_imread')
         data_source = dataset_config.get('data_source')
@@ -74,10 +82,18 @@ class ModelEvaluator:
         )
         postprocessor = PostprocessingExecutor(dataset_config.get('postprocessing'), dataset_name, dataset.metadata)
         metric_dispatcher = MetricsExecutor(dataset_config.get('metrics', []), dataset)
+        termination = None
+        if early_termination:
+            if postprocessor.has_dataset_processors:
+                raise ConfigError('early termination is not supported with postprocessing of the whole dataset')
+            termination_config = dataset_config.get('early_termination') or {}
+            termination = EarlyTermination(metric_dispatcher, termination_config, dataset.size)
+            dataset.reorder(stratified_order(dataset.annotation, termination.seed))
 
         return cls(
             launcher, input_feeder, adapter, data_reader,
-            preprocessor, postprocessor, dataset, metric_dispatcher, async_mode
+            preprocessor, postprocessor, dataset, metric_dispatcher, async_mode,
+            data_loader_workers, data_loader_prefetch, termination
         )
 
     def _get_batch_input(self, batch_annotation):
@@ -106,13 +122,15 @@ class ModelEvaluator:
 
         self.dataset.batch = self.launcher.batch
         predictions_to_store = []
-        dataset_iterator = iter(enumerate(self.dataset))
+        dataset_iterator = self.data_loader.iterate(self.dataset)
         free_irs = self.launcher.infer_requests
         queued_irs = []
         wait_time = 0.01
+        terminated = False
 
         while free_irs or queued_irs:
-            self._fill_free_irs(free_irs, queued_irs, dataset_iterator)
+            if not terminated:
+                self._fill_free_irs(free_irs, queued_irs, dataset_iterator)
             free_irs[:] = []
 
             ready_irs, queued_irs = self._wait_for_any(queued_irs)
@@ -137,6 +155,8 @@ class ModelEvaluator:
                     if progress_reporter:
                         progress_reporter.update(batch_id, len(batch_predictions))
 
+                # requests in flight are completed, new batches are not submitted
+                terminated = terminated or self._should_terminate()
             else:
                 time.sleep(wait_time)
                 wait_time = max(wait_time * 2, .16)
@@ -162,8 +182,9 @@ class ModelEvaluator:
 
         self.dataset.batch = self.launcher.batch
         predictions_to_store = []
-        for batch_id, batch_annotation in enumerate(self.dataset):
-            filled_inputs, batch_meta, batch_identifiers = self._get_batch_input(batch_annotation)
+        for batch_id, batch_annotation, filled_inputs, batch_meta, batch_identifiers in self.data_loader.iterate(
+                self.dataset
+        ):
             batch_predictions = self.launcher.predict(filled_inputs, batch_meta, *args, **kwargs)
             if self.adapter:
                 self.adapter.output_blob = self.adapter.output_blob or self.launcher.output_blob
@@ -182,6 +203,9 @@ class ModelEvaluator:
             if progress_reporter:
                 progress_reporter.update(batch_id, len(batch_predictions))
 
+            if self._should_terminate():
+                break
+
         if progress_reporter:
             progress_reporter.finish()
 
@@ -193,6 +217,9 @@ class ModelEvaluator:
 
         return self.postprocessor.process_dataset(self._annotations, self._predictions)
 
+    def _should_terminate(self):
+        return bool(self.early_termination) and self.early_termination.should_stop(self._annotations, self._predictions)
+
     @staticmethod
     def _is_stored(stored_predictions=None):
         if not stored_predictions:
@@ -228,11 +255,10 @@ class ModelEvaluator:
     def _fill_free_irs(self, free_irs, queued_irs, dataset_iterator):
         for ir in free_irs:
             try:
-                batch_id, batch_annotation = next(dataset_iterator)
+                batch_id, batch_annotation, batch_input, batch_meta, _ = next(dataset_iterator)
             except StopIteration:
                 break
 
-            batch_input, batch_meta, _ = self._get_batch_input(batch_annotation)
             self.launcher.predict_async(ir, batch_input, batch_meta)
             queued_irs.append((batch_id, batch_annotation, batch_meta, ir))
 
@@ -242,9 +268,19 @@ class ModelEvaluator:
         for result_presenter, evaluated_metric in self.metric_executor.iterate_metrics(
                 self._annotations, self._predictions):
             result_presenter.write_result(evaluated_metric, output_callback, ignore_results_formatting)
+        if self.early_termination and self.early_termination.processed:
+            self.early_termination.report()
+
+    def metrics_results(self):
+        return [
+            evaluated_metric for _, evaluated_metric in self.metric_executor.iterate_metrics(
+                self._annotations, self._predictions
+            )
+        ]
 
     def load(self, stored_predictions, progress_reporter):
-        self._annotations = self.dataset.annotation
+        # postprocessing changes representations in place, so representations of the annotation store are loaded once
+        self._annotations = list(self.dataset.annotation)
         launcher = self.launcher
         if not isinstance(launcher, DummyLauncher):
             launcher = DummyLauncher({
@@ -0,0 +1,413 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import copy
+import csv
+import itertools
+import time
+from collections import OrderedDict, namedtuple
+
+import numpy as np
+
+from ..config import ConfigError, ConfigReader
+from ..logging import print_info, warning
+from ..utils import read_yaml
+from .model_evaluator import ModelEvaluator
+
+SweepPoint = namedtuple('SweepPoint', ['name', 'overrides'])
+SweepResult = namedtuple('SweepResult', ['point', 'metrics', 'performance', 'error'])
+
+OVERRIDE_ROOTS = ('launcher', 'dataset')
+
+
+class SweepConfig:
+    """
+    Describes the grid of the accuracy versus performance sweep.
+
+    The grid maps dotted paths of the launcher or dataset config entries, e.g. `launcher.batch`,
+    `launcher.device_config.CPU_THROUGHPUT_STREAMS` or `dataset.preprocessing.0.size`, to the lists of their values.
+    Variants are named sets of overrides applied together, e.g. model and weights of the same model in
+    different precisions. Every combination of the grid values and a variant is a point of the sweep.
+    """
+
+    def __init__(self, config):
+        if not isinstance(config, dict):
+            raise ConfigError('sweep config should be a dictionary')
+
+        self.grid = OrderedDict()
+        for key, values in (config.get('grid') or {}).items():
+            self._check_path(key)
+            if not isinstance(values, list) or not values:
+                raise ConfigError('sweep grid entry {} should be a non-empty list of values'.format(key))
+            self.grid[key] = values
+
+        self.variants = OrderedDict()
+        for name, overrides in (config.get('variants') or {}).items():
+            if not isinstance(overrides, dict) or not overrides:
+                raise ConfigError('sweep variant {} should be a non-empty dictionary of overrides'.format(name))
+            for key in overrides:
+                self._check_path(key)
+            self.variants[str(name)] = overrides
+
+        self.subsample_size = config.get('subsample_size')
+        self.metric = config.get('metric')
+        self.lower_is_better = bool(config.get('lower_is_better', False))
+        self.objective = config.get('objective', 'throughput')
+        if self.objective not in ('throughput', 'latency'):
+            raise ConfigError('sweep objective should be throughput or latency')
+        benchmark = config.get('benchmark') or {}
+        self.benchmark_batches = int(benchmark.get('batches', 4))
+        self.benchmark_iterations = int(benchmark.get('iterations', 50))
+        self.benchmark_warmup = int(benchmark.get('warmup', 5))
+        if self.benchmark_batches < 1 or self.benchmark_iterations < 1 or self.benchmark_warmup < 0:
+            raise ConfigError('sweep benchmark batches and iterations should be positive')
+        self.output = config.get('output')
+
+    @classmethod
+    def from_file(cls, path):
+        return cls(read_yaml(path))
+
+    @staticmethod
+    def _check_path(key):
+        parts = str(key).split('.')
+        if len(parts) < 2 or parts[0] not in OVERRIDE_ROOTS:
+            raise ConfigError('sweep entry {} should be a dotted path starting with {}'.format(
+                key, ' or '.join(OVERRIDE_ROOTS)
+            ))
+
+    def points(self):
+        keys = list(self.grid)
+        variants = list(self.variants.items()) or [(None, {})]
+        points = []
+        for variant_name, variant_overrides in variants:
+            for values in itertools.product(*self.grid.values()):
+                overrides = OrderedDict(zip(keys, values))
+                overrides.update(variant_overrides)
+                name = ', '.join('{}={}'.format(key.split('.')[-1], value) for key, value in zip(keys, values))
+                if variant_name is not None:
+                    name = '{}, {}'.format(variant_name, name) if name else variant_name
+                points.append(SweepPoint(name or 'default', overrides))
+
+        return points
+
+
+def set_by_path(config, path, value):
+    """
+    Sets the value of a nested dictionary or list entry, list items are addressed by their indices.
+    Missing dictionary entries are created.
+    """
+
+    parts = path.split('.')
+    container = config
+    for part in parts[:-1]:
+        if isinstance(container, list):
+            container = container[int(part)]
+            continue
+        if container.get(part) is None:
+            container[part] = {}
+        container = container[part]
+
+    if isinstance(container, list):
+        container[int(parts[-1])] = value
+    else:
+        container[parts[-1]] = value
+
+
+def apply_overrides(launcher_config, dataset_config, overrides, arguments=None):
+    """
+    Returns copies of the launcher and dataset configs with the overrides of a sweep point applied.
+    Relative paths of overridden top-level entries are prefixed by the command line arguments
+    the same way as the paths of the config file.
+    """
+
+    configs = {'launcher': copy.deepcopy(launcher_config), 'dataset': copy.deepcopy(dataset_config)}
+    overridden = {root: {} for root in OVERRIDE_ROOTS}
+    for path, value in overrides.items():
+        root, entry_path = path.split('.', 1)
+        set_by_path(configs[root], entry_path, copy.deepcopy(value))
+        top_entry = entry_path.split('.')[0]
+        overridden[root][top_entry] = configs[root][top_entry]
+
+    if arguments is not None:
+        # only overridden entries are prefixed, paths of the original config are already merged
+        ConfigReader._merge_paths_with_prefixes(arguments, {
+            'models': [{'launchers': [overridden['launcher']], 'datasets': [overridden['dataset']]}]
+        })
+        for root in OVERRIDE_ROOTS:
+            configs[root].update(overridden[root])
+
+    return configs['launcher'], configs['dataset']
+
+
+def collect_benchmark_batches(model_evaluator, batches_count):
+    """
+    Prepares the inputs of the first batches of the dataset, so inference is measured without data loading.
+    """
+
+    model_evaluator.dataset.batch = model_evaluator.launcher.batch
+    batches = []
+    iterator = model_evaluator.data_loader.iterate(model_evaluator.dataset)
+    try:
+        for _, _, filled_inputs, batch_meta, _ in iterator:
+            # parallel data loader reuses memory of the inputs for the next batches
+            batches.append((copy.deepcopy(filled_inputs), copy.deepcopy(batch_meta)))
+            if len(batches) == batches_count:
+                break
+    finally:
+        iterator.close()
+
+    return batches
+
+
+def measure_performance(launcher, batches, iterations, warmup=0, async_mode=False):
+    """
+    Measures latency and throughput of the launcher cycling through the prepared batches.
+
+    In asynchronous mode all infer requests of the launcher are kept busy, latency of a batch is
+    measured from its submission to the completion of its request.
+
+    Returns:
+        dictionary with throughput in frames per second and latency statistics in milliseconds.
+    """
+
+    if not batches:
+        raise ValueError('at least one batch is required to measure performance')
+
+    def batch_at(index):
+        return batches[index % len(batches)]
+
+    def frames_count(batch_meta):
+        return max(len(batch_meta), 1)
+
+    if async_mode:
+        latencies, frames, total_time = _measure_async(launcher, batch_at, frames_count, iterations, warmup)
+    else:
+        for iteration in range(warmup):
+            launcher.predict(*batch_at(iteration))
+        latencies = []
+        frames = 0
+        start = time.perf_counter()
+        for iteration in range(iterations):
+            filled_inputs, batch_meta = batch_at(iteration)
+            batch_start = time.perf_counter()
+            launcher.predict(filled_inputs, batch_meta)
+            latencies.append(time.perf_counter() - batch_start)
+            frames += frames_count(batch_meta)
+        total_time = time.perf_counter() - start
+
+    latencies = np.array(latencies) * 1000
+    return OrderedDict([
+        ('throughput', frames / total_time if total_time > 0 else float('inf')),
+        ('latency_mean', float(np.mean(latencies))),
+        ('latency_median', float(np.median(latencies))),
+        ('latency_p90', float(np.percentile(latencies, 90))),
+    ])
+
+
+def _measure_async(launcher, batch_at, frames_count, iterations, warmup):
+    requests = list(launcher.infer_requests)
+    submitted = 0
+    frames = 0
+    latencies = []
+    queued = []
+    start = None
+    total = warmup + iterations
+
+    def submit(request):
+        nonlocal submitted
+        filled_inputs, batch_meta = batch_at(submitted)
+        queued.append((request, time.perf_counter(), submitted, frames_count(batch_meta)))
+        launcher.predict_async(request, filled_inputs, batch_meta)
+        submitted += 1
+
+    for request in requests[:total]:
+        submit(request)
+
+    # requests complete in the order of submission on average, so the oldest one is waited for
+    while queued:
+        request, submit_time, index, batch_frames = queued.pop(0)
+        request.wait(-1)
+        end = time.perf_counter()
+        if index >= warmup:
+            if start is None:
+                start = submit_time
+            latencies.append(end - submit_time)
+            frames += batch_frames
+        if submitted < total:
+            submit(request)
+
+    return latencies, frames, end - start
+
+
+def metric_value(metrics, metric=None):
+    """
+    Selects the value of the metric the frontier is built for, the first metric by default.
+
+    Args:
+        metrics: dictionary of metric names and their values, per class values are averaged.
+        metric: name of the metric.
+    """
+
+    if not metrics:
+        raise ConfigError('sweep requires at least one metric')
+    if metric is None:
+        return float(np.mean(next(iter(metrics.values()))))
+    if metric not in metrics:
+        raise ConfigError('metric {} is not found among {}'.format(metric, ', '.join(metrics)))
+
+    return float(np.mean(metrics[metric]))
+
+
+def pareto_frontier(points, lower_is_better=False, objective='throughput'):
+    """
+    Returns indices of the points which are not dominated by any other point.
+
+    Args:
+        points: list of (metric value, performance value) pairs, None marks a failed point.
+        lower_is_better: whether lower metric values are better.
+        objective: throughput is maximized, latency is minimized.
+    """
+
+    sign_metric = -1 if lower_is_better else 1
+    sign_performance = -1 if objective == 'latency' else 1
+    scores = [
+        None if point is None else (sign_metric * point[0], sign_performance * point[1]) for point in points
+    ]
+
+    def dominates(first, second):
+        return first[0] >= second[0] and first[1] >= second[1] and first != second
+
+    return [
+        index for index, score in enumerate(scores)
+        if score is not None and not any(other is not None and dominates(other, score) for other in scores)
+    ]
+
+
+class SweepEvaluator:
+    def __init__(self, sweep_config, data_loader_workers=0, data_loader_prefetch=None):
+        self.sweep_config = sweep_config
+        self.data_loader_workers = data_loader_workers
+        self.data_loader_prefetch = data_loader_prefetch
+
+    def evaluate_point(self, launcher_config, dataset_config, progress_reporter=None):
+        config = self.sweep_config
+        if config.subsample_size is not None:
+            dataset_config['subsample_size'] = config.subsample_size
+
+        model_evaluator = ModelEvaluator.from_configs(
+            launcher_config, dataset_config, self.data_loader_workers, self.data_loader_prefetch
+        )
+        try:
+            if progress_reporter:
+                progress_reporter.reset(model_evaluator.dataset.size)
+            model_evaluator.dataset_processor(None, progress_reporter=progress_reporter)
+            metrics = OrderedDict(
+                (result.name, float(np.mean(result.evaluated_value)))
+                for result in model_evaluator.metrics_results()
+            )
+
+            batches = collect_benchmark_batches(model_evaluator, config.benchmark_batches)
+            async_mode = bool(launcher_config.get('async_mode')) and hasattr(model_evaluator.launcher, 'infer_requests')
+            performance = measure_performance(
+                model_evaluator.launcher, batches, config.benchmark_iterations, config.benchmark_warmup, async_mode
+            )
+        finally:
+            model_evaluator.release()
+
+        return metrics, performance
+
+    def run(self, launcher_config, dataset_config, arguments=None, progress_reporter=None):
+        results = []
+        points = self.sweep_config.points()
+        for point_id, point in enumerate(points):
+            print_info('sweep point {} of {}: {}'.format(point_id + 1, len(points), point.name))
+            launcher_entry, dataset_entry = apply_overrides(launcher_config, dataset_config, point.overrides, arguments)
+            try:
+                metrics, performance = self.evaluate_point(launcher_entry, dataset_entry, progress_reporter)
+            except Exception as exception:  # pylint: disable=W0703
+                # e.g. a batch or an input shape which is not supported by the model
+                warning('sweep point {} failed: {}'.format(point.name, exception))
+                results.append(SweepResult(point, None, None, str(exception)))
+                continue
+            results.append(SweepResult(point, metrics, performance, None))
+
+        return results
+
+    def frontier(self, results):
+        config = self.sweep_config
+        performance_key = 'throughput' if config.objective == 'throughput' else 'latency_mean'
+        values = [
+            None if result.error else (
+                metric_value(result.metrics, config.metric), result.performance[performance_key]
+            )
+            for result in results
+        ]
+
+        return pareto_frontier(values, config.lower_is_better, config.objective)
+
+    def report(self, results, output_callback=print_info):
+        frontier = set(self.frontier(results))
+        metric_names = []
+        for result in results:
+            for name in result.metrics or []:
+                if name not in metric_names:
+                    metric_names.append(name)
+
+        header = ['point'] + metric_names + ['throughput, fps', 'latency, ms', 'p90 latency, ms', 'pareto']
+        rows = []
+        for index, result in enumerate(results):
+            if result.error:
+                rows.append([result.point.name] + ['-'] * (len(header) - 2) + ['failed'])
+                continue
+            rows.append(
+                [result.point.name] +
+                ['{:.4f}'.format(result.metrics[name]) if name in result.metrics else '-' for name in metric_names] +
+                ['{:.2f}'.format(result.performance['throughput']),
+                 '{:.2f}'.format(result.performance['latency_mean']),
+                 '{:.2f}'.format(result.performance['latency_p90']),
+                 '*' if index in frontier else '']
+            )
+
+        widths = [max(len(row[column]) for row in [header] + rows) for column in range(len(header))]
+        output_callback('Sweep results, Pareto frontier points are marked with *:')
+        for row in [header] + rows:
+            output_callback('  '.join(value.ljust(width) for value, width in zip(row, widths)).rstrip())
+
+        if self.sweep_config.output:
+            self.write_csv(self.sweep_config.output, results, metric_names, frontier)
+
+    def write_csv(self, output, results, metric_names, frontier):
+        override_keys = []
+        for result in results:
+            for key in result.point.overrides:
+                if key not in override_keys:
+                    override_keys.append(key)
+
+        performance_keys = ['throughput', 'latency_mean', 'latency_median', 'latency_p90']
+        with open(str(output), 'w', newline='') as content:
+            writer = csv.writer(content)
+            writer.writerow(['point'] + override_keys + metric_names + performance_keys + ['pareto', 'error'])
+            for index, result in enumerate(results):
+                overrides = result.point.overrides
+                writer.writerow(
+                    [result.point.name] +
+                    [overrides.get(key, '') for key in override_keys] +
+                    [(result.metrics or {}).get(name, '') for name in metric_names] +
+                    [(result.performance or {}).get(key, '') for key in performance_keys] +
+                    [int(index in frontier), result.error or '']
+                )
+        print_info('sweep results are saved to {}'.format(output))
+
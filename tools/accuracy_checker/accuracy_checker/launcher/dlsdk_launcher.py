@@ -157,6 +157,10 @@ class DLSDKLauncher(Launcher):
             'outputs': ListField(optional=True, description="Outputs."),
             'allow_reshape_input': BoolField(optional=True, default=False, description="Allows reshape input."),
             'affinity_map': PathField(optional=True, description="Affinity map."),
+            'device_config': DictField(
+                optional=True, allow_empty=False,
+                description="Plugin configuration, for example CPU_THROUGHPUT_STREAMS or CPU_THREADS_NUM."
+            ),
             'batch': NumberField(value_type=int, min_value=1, optional=True, default=1, description="Batch size."),
             'should_log_cmd': BoolField(optional=True, description="Log Model Optimizer command."),
             'async_mode': BoolField(optional=True, description="Allows asynchronous mode."),
@@ -492,6 +496,9 @@ class DLSDKLauncher(Launcher):
             log_level = self.config.get('_vpu_log_level')
             if log_level:
                 self.plugin.set_config({'VPU_LOG_LEVEL': log_level})
+        device_config = self.config.get('device_config')
+        if device_config:
+            self.plugin.set_config({key: str(value) for key, value in device_config.items()})
 
     def _create_network(self, input_shapes=None):
         assert self.plugin, "_create_ie_plugin should be called before _create_network"
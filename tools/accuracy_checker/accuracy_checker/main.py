@@ -22,7 +22,7 @@ import cv2
 
 from .config import ConfigReader
 from .logging import print_info, add_file_handler
-from .evaluators import ModelEvaluator, PipeLineEvaluator, get_processing_info
+from .evaluators import ModelEvaluator, PipeLineEvaluator, SweepConfig, SweepEvaluator, get_processing_info
 from .progress_reporters import ProgressReporter
 from .utils import get_path
 
@@ -185,6 +185,36 @@ def build_arguments_parser():
         choices=['LOG_NONE', 'LOG_WARNING', 'LOG_INFO', 'LOG_DEBUG'],
         default='LOG_WARNING'
     )
+    parser.add_argument(
+        '--data_loader_workers',
+        help='number of processes reading and preprocessing data in parallel with inference, '
+             '0 means data is loaded by the main process',
+        required=False,
+        type=int,
+        default=0
+    )
+    parser.add_argument(
+        '--data_loader_prefetch',
+        help='number of batches prepared ahead of inference by data loader workers, '
+             'twice the number of workers by default',
+        required=False,
+        type=int
+    )
+    parser.add_argument(
+        '--early_termination',
+        help='process dataset in randomized stratified order and stop as soon as confidence intervals of metrics '
+             'with reference and threshold resolve whether the check passes',
+        required=False,
+        action='store_true'
+    )
+    parser.add_argument(
+        '--sweep',
+        help='path to the yml file with the grid of launcher and dataset parameters for accuracy versus '
+             'performance sweep. Each point is evaluated on the dataset subset and measured, '
+             'the Pareto frontier of the points is reported',
+        type=get_path,
+        required=False
+    )
 
     return parser
 
@@ -197,7 +227,11 @@ def main():
         add_file_handler(args.log_file)
 
     config, mode = ConfigReader.merge(args)
-    if mode == 'models':
+    if args.sweep:
+        if mode != 'models':
+            raise ValueError('sweep is supported for models configuration only')
+        sweep_evaluation_mode(config, progress_reporter, args)
+    elif mode == 'models':
         model_evaluation_mode(config, progress_reporter, args)
     else:
         pipeline_evaluation_mode(config, progress_reporter, args)
@@ -214,7 +248,10 @@ def model_evaluation_mode(config, progress_reporter, args):
                     launcher_config.get('tags'),
                     dataset_config['name']
                 )
-                model_evaluator = ModelEvaluator.from_configs(launcher_config, dataset_config)
+                model_evaluator = ModelEvaluator.from_configs(
+                    launcher_config, dataset_config, args.data_loader_workers, args.data_loader_prefetch,
+                    args.early_termination
+                )
                 progress_reporter.reset(model_evaluator.dataset.size)
                 model_evaluator.dataset_processor(args.stored_predictions, progress_reporter=progress_reporter)
                 model_evaluator.compute_metrics(ignore_results_formatting=args.ignore_result_formatting)
@@ -222,6 +259,24 @@ def model_evaluation_mode(config, progress_reporter, args):
                 model_evaluator.release()
 
 
+def sweep_evaluation_mode(config, progress_reporter, args):
+    sweep_evaluator = SweepEvaluator(
+        SweepConfig.from_file(args.sweep), args.data_loader_workers, args.data_loader_prefetch
+    )
+    for model in config['models']:
+        for launcher_config in model['launchers']:
+            for dataset_config in model['datasets']:
+                print_processing_info(
+                    model['name'],
+                    launcher_config['framework'],
+                    launcher_config['device'],
+                    launcher_config.get('tags'),
+                    dataset_config['name']
+                )
+                results = sweep_evaluator.run(launcher_config, dataset_config, args, progress_reporter)
+                sweep_evaluator.report(results)
+
+
 def pipeline_evaluation_mode(config, progress_reporter, args):
     for pipeline_config in config['pipelines']:
         print_processing_info(*get_processing_info(pipeline_config))
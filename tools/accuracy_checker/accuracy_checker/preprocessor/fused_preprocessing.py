@@ -0,0 +1,185 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import cv2
+import numpy as np
+
+from .preprocessors import (
+    AutoResize, BgrToRgb, Crop, Flip, GeometricOperationMetadata, Normalize, Resize, _OpenCVResizer
+)
+
+# depths supported by cv2.cvtColor, other data types make bgr_to_rgb fail
+_CVT_COLOR_DTYPES = (np.dtype(np.uint8), np.dtype(np.uint16), np.dtype(np.float32))
+
+
+class _FusedData:
+    """
+    Data of an image passing through a fused chain. The channel swap, flip and crop are kept as views of the last
+    computed array, the data type is the type the separate preprocessors would give, so the cast is postponed
+    to the next computation.
+    """
+
+    def __init__(self, data):
+        self.view = data
+        self.dtype = data.dtype
+
+    def materialize(self):
+        self.view = np.ascontiguousarray(self.view, dtype=self.dtype)
+        return self.view
+
+    def result(self):
+        if self.view.dtype != self.dtype:
+            return self.view.astype(self.dtype)
+        if any(stride < 0 for stride in self.view.strides):
+            return np.ascontiguousarray(self.view)
+
+        return self.view
+
+
+def _resize(processor, image, state):
+    dst_height, dst_width = processor.destination_size(image, state.view.shape[:2])
+    # the float32 cast of the resized data is postponed to the next computation
+    data = state.view if state.view.dtype == state.dtype else state.materialize()
+    data = cv2.resize(
+        np.ascontiguousarray(data), (dst_width, dst_height), interpolation=processor.resizer.interpolation
+    )
+    state.view = np.expand_dims(data, axis=-1) if data.ndim == 2 else data
+    state.dtype = np.dtype(np.float32)
+
+
+def _auto_resize(processor, image, state):
+    data = state.view if state.view.dtype == state.dtype else state.materialize()
+    data = cv2.resize(np.ascontiguousarray(data), (processor.dst_width, processor.dst_height))
+    state.view = np.expand_dims(data, axis=-1) if data.ndim == 2 else data
+    state.dtype = np.dtype(np.float32)
+    image.metadata.setdefault('geometric_operations', []).append(GeometricOperationMetadata('auto_resize', {}))
+
+
+def _crop(processor, image, state):
+    height, width = state.view.shape[:2]
+    new_height, new_width = processor.crop_size(height, width)
+    if width < new_width or height < new_height:
+        state.view = processor.fit_to_crop(state.materialize(), new_height, new_width)
+    image.metadata.setdefault('geometric_operations', []).append(GeometricOperationMetadata('crop', {}))
+    state.view = processor.central_crop(state.view, new_height, new_width)
+
+
+def _flip(processor, image, state):
+    # cv2.flip with code 0 reverses rows, with positive code reverses columns
+    state.view = state.view[::-1] if processor.mode == 0 else state.view[:, ::-1]
+    image.metadata.setdefault(
+        'geometric_operations', []).append(GeometricOperationMetadata('flip', {'mode': processor.mode}))
+
+
+def _bgr_to_rgb(processor, image, state):
+    if state.dtype not in _CVT_COLOR_DTYPES or state.view.ndim != 3 or state.view.shape[-1] != 3:
+        # let OpenCV report unsupported data as the separate preprocessor does
+        state.view = cv2.cvtColor(state.materialize(), cv2.COLOR_BGR2RGB)
+        return
+    state.view = state.view[..., ::-1]
+
+
+def _normalize(processor, image, state):
+    # the same operands as of `data - mean` and `data / std` give the same results,
+    # the source values are exact in the postponed type, so the cast is done by the subtraction
+    data = state.view
+    if processor.mean:
+        mean = np.asarray(processor.mean)
+        data = np.subtract(data, mean, dtype=np.result_type(state.dtype, mean))
+    elif data.dtype != state.dtype:
+        data = data.astype(state.dtype)
+    if processor.std:
+        std = np.asarray(processor.std)
+        divided_dtype = np.true_divide(np.zeros(1, data.dtype), std).dtype
+        if data is state.view or divided_dtype != data.dtype:
+            data = np.true_divide(data, std)
+        else:
+            np.true_divide(data, std, out=data)
+    state.view = data
+    state.dtype = data.dtype
+
+
+FUSED_STEPS = {
+    Resize: _resize,
+    AutoResize: _auto_resize,
+    Crop: _crop,
+    Flip: _flip,
+    BgrToRgb: _bgr_to_rgb,
+    Normalize: _normalize,
+}
+
+
+def is_fusible(processor):
+    if type(processor) not in FUSED_STEPS:
+        return False
+    if isinstance(processor, Resize):
+        return isinstance(processor.resizer, _OpenCVResizer)
+    if isinstance(processor, Crop):
+        return not processor.use_pillow
+
+    return True
+
+
+class FusedPreprocessing:
+    """
+    Runs a sequence of resize, crop, flip, bgr_to_rgb and normalization preprocessors in one pass over an image:
+    geometric and channel order steps become views, the float cast is merged into the normalization
+    and the normalization result is divided in place. Results are identical to the separate preprocessors.
+    """
+
+    def __init__(self, processors):
+        self.processors = processors
+        self.steps = [FUSED_STEPS[type(processor)] for processor in processors]
+
+    def __call__(self, image, annotation_meta=None):
+        if not isinstance(image.data, np.ndarray):
+            # pyramids, tiles, etc are processed by the separate preprocessors
+            for processor in self.processors:
+                image = processor(image=image, annotation_meta=annotation_meta)
+            return image
+
+        state = _FusedData(image.data)
+        for processor, step in zip(self.processors, self.steps):
+            step(processor, image, state)
+        image.data = state.result()
+
+        return image
+
+
+def fuse_preprocessors(processors):
+    """
+    Returns:
+        preprocessors where each sequence of at least two fusible preprocessors is replaced by FusedPreprocessing.
+    """
+    chain = []
+    sequence = []
+
+    def flush():
+        if len(sequence) > 1:
+            chain.append(FusedPreprocessing(list(sequence)))
+        else:
+            chain.extend(sequence)
+        sequence.clear()
+
+    for processor in processors:
+        if is_fusible(processor):
+            sequence.append(processor)
+        else:
+            flush()
+            chain.append(processor)
+    flush()
+
+    return chain
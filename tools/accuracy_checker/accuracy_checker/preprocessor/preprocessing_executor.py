@@ -16,11 +16,15 @@ limitations under the License.
 
 from ..config import ConfigValidator, StringField
 from ..preprocessor.preprocessors import Preprocessor
+from .fused_preprocessing import fuse_preprocessors
 
 
 class PreprocessingExecutor:
-    def __init__(self, processors=None, dataset_name='custom', dataset_meta=None, input_shapes=None):
+    def __init__(
+            self, processors=None, dataset_name='custom', dataset_meta=None, input_shapes=None, enable_fusion=True
+    ):
         self.processors = []
+        self._chain = []
         self.dataset_meta = dataset_meta
         self.input_shapes = input_shapes
 
@@ -41,6 +45,8 @@ class PreprocessingExecutor:
 
             self.processors.append(preprocessor)
 
+        self._chain = fuse_preprocessors(self.processors) if enable_fusion else self.processors
+
     def __call__(self, context, *args, **kwargs):
         batch_data = context.data_batch
         batch_annotation = context.annotation_batch
@@ -48,7 +54,7 @@ class PreprocessingExecutor:
 
     def process(self, images, batch_annotation=None):
         for i, _ in enumerate(images):
-            for processor in self.processors:
+            for processor in self._chain:
                 images[i] = processor(
                     image=images[i], annotation_meta=batch_annotation[i].metadata if batch_annotation else None
                 )
@@ -287,48 +287,50 @@ class Resize(Preprocessor):
 
     def process(self, image, annotation_meta=None):
         data = image.data
-        new_height, new_width = self.dst_height, self.dst_width
 
         is_simple_case = not isinstance(data, list) # otherwise -- pyramid, tiling, etc
 
-        def process_data(data, new_height, new_width, scale_func, resize_func):
-            dst_width, dst_height = new_width, new_height
-            image_h, image_w = data.shape[:2]
-            if scale_func:
-                dst_width, dst_height = scale_func(new_width, new_height, image_w, image_h)
-
-            resize_meta = {}
-            resize_meta['preferable_width'] = max(dst_width, new_width)
-            resize_meta['preferable_height'] = max(dst_height, new_height)
-            resize_meta['image_info'] = [dst_height, dst_width, 1]
-            resize_meta['scale_x'] = float(dst_width) / image_w
-            resize_meta['scale_y'] = float(dst_height) / image_h
-            resize_meta['original_width'] = image_w
-            resize_meta['original_height'] = image_h
-
-            if is_simple_case:
-                # support GeometricOperationMetadata array for simple case only -- without tiling, pyramids, etc
-                image.metadata.setdefault('geometric_operations', []).append(GeometricOperationMetadata('resize',
-                                                                                                        resize_meta))
-
-            image.metadata.update(resize_meta)
+        def process_data(data):
+            dst_height, dst_width = self.destination_size(image, data.shape[:2], is_simple_case)
 
-            data = resize_func(data, dst_height, dst_width)
+            data = self.resizer(data, dst_height, dst_width)
             if len(data.shape) == 2:
                 data = np.expand_dims(data, axis=-1)
 
             return data
 
-        image.data = (
-            process_data(data, new_height, new_width, self.scaling_func, self.resizer)
-            if is_simple_case else [
-                process_data(data_fragment, new_height, new_width, self.scaling_func, self.resizer)
-                for data_fragment in data
-            ]
-        )
+        image.data = process_data(data) if is_simple_case else [process_data(data_fragment) for data_fragment in data]
 
         return image
 
+    def destination_size(self, image, data_size, is_simple_case=True):
+        """
+        Computes the size of resized data and stores the resize parameters in the image metadata.
+        """
+        new_height, new_width = self.dst_height, self.dst_width
+        dst_width, dst_height = new_width, new_height
+        image_h, image_w = data_size
+        if self.scaling_func:
+            dst_width, dst_height = self.scaling_func(new_width, new_height, image_w, image_h)
+
+        resize_meta = {}
+        resize_meta['preferable_width'] = max(dst_width, new_width)
+        resize_meta['preferable_height'] = max(dst_height, new_height)
+        resize_meta['image_info'] = [dst_height, dst_width, 1]
+        resize_meta['scale_x'] = float(dst_width) / image_w
+        resize_meta['scale_y'] = float(dst_height) / image_h
+        resize_meta['original_width'] = image_w
+        resize_meta['original_height'] = image_h
+
+        if is_simple_case:
+            # support GeometricOperationMetadata array for simple case only -- without tiling, pyramids, etc
+            image.metadata.setdefault('geometric_operations', []).append(GeometricOperationMetadata('resize',
+                                                                                                    resize_meta))
+
+        image.metadata.update(resize_meta)
+
+        return dst_height, dst_width
+
 
 class AutoResize(Preprocessor):
     __provider__ = 'auto_resize'
@@ -519,14 +521,9 @@ class Crop(Preprocessor):
         is_simple_case = not isinstance(image.data, list) # otherwise -- pyramid, tiling, etc
         data = image.data
 
-        def process_data(data, dst_height, dst_width, central_fraction, use_pillow):
+        def process_data(data, use_pillow):
             height, width = data.shape[:2]
-            if not central_fraction:
-                new_height = dst_height
-                new_width = dst_width
-            else:
-                new_height = int(height * central_fraction)
-                new_width = int(width * central_fraction)
+            new_height, new_width = self.crop_size(height, width)
 
             if use_pillow:
                 i = int(round((height - new_height) / 2.))
@@ -534,35 +531,51 @@ class Crop(Preprocessor):
                 cropped_data = Image.fromarray(data).crop((j, i, j + new_width, i + new_height))
                 return np.array(cropped_data)
 
-            if width < new_width or height < new_height:
-                resized = np.array([width, height])
-                if resized[0] < new_width:
-                    resized = resized * new_width / resized[0]
-                if resized[1] < new_height:
-                    resized = resized * new_height / resized[1]
-
-                data = cv2.resize(data, tuple(np.ceil(resized).astype(int)))
-
-            height, width = data.shape[:2]
-            start_height = (height - new_height) // 2
-            start_width = (width - new_width) // 2
+            data = self.fit_to_crop(data, new_height, new_width)
 
             if is_simple_case:
                 # support GeometricOperationMetadata array for simple case only -- without tiling, pyramids, etc
                 image.metadata.setdefault('geometric_operations', []).append(GeometricOperationMetadata('crop', {}))
 
-            return data[start_height:start_height + new_height, start_width:start_width + new_width]
+            return self.central_crop(data, new_height, new_width)
 
-        image.data = process_data(
-            data, self.dst_height, self.dst_width, self.central_fraction, self.use_pillow
-        ) if not isinstance(data, list) else [
-            process_data(
-                fragment, self.dst_height, self.dst_width, self.central_fraction, self.use_pillow
-            ) for fragment in image.data
+        image.data = process_data(data, self.use_pillow) if not isinstance(data, list) else [
+            process_data(fragment, self.use_pillow) for fragment in image.data
         ]
 
         return image
 
+    def crop_size(self, height, width):
+        if not self.central_fraction:
+            return self.dst_height, self.dst_width
+
+        return int(height * self.central_fraction), int(width * self.central_fraction)
+
+    @staticmethod
+    def fit_to_crop(data, new_height, new_width):
+        """
+        Upscales data smaller than the crop size keeping aspect ratio.
+        """
+        height, width = data.shape[:2]
+        if width < new_width or height < new_height:
+            resized = np.array([width, height])
+            if resized[0] < new_width:
+                resized = resized * new_width / resized[0]
+            if resized[1] < new_height:
+                resized = resized * new_height / resized[1]
+
+            data = cv2.resize(data, tuple(np.ceil(resized).astype(int)))
+
+        return data
+
+    @staticmethod
+    def central_crop(data, new_height, new_width):
+        height, width = data.shape[:2]
+        start_height = (height - new_height) // 2
+        start_width = (width - new_width) // 2
+
+        return data[start_height:start_height + new_height, start_width:start_width + new_width]
+
 
 class CropRect(Preprocessor):
     __provider__ = 'crop_rect'
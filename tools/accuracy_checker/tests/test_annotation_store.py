@@ -0,0 +1,152 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import pytest
+
+from accuracy_checker.annotation_converters import make_subset, save_annotation
+from accuracy_checker.annotation_store import AnnotationStore, identifier_index, write_annotation_store
+from accuracy_checker.dataset import read_annotation
+from accuracy_checker.representation import ClassificationAnnotation, ReIdentificationClassificationAnnotation
+
+
+def make_classification(size):
+    return [ClassificationAnnotation('{}.png'.format(identifier), identifier % 3) for identifier in range(size)]
+
+
+def make_pairwise():
+    return [
+        ReIdentificationClassificationAnnotation('0.png', ['1.png'], ['2.png']),
+        ReIdentificationClassificationAnnotation('1.png', [], []),
+        ReIdentificationClassificationAnnotation('2.png', [], []),
+        ReIdentificationClassificationAnnotation('3.png', ['4.png'], []),
+        ReIdentificationClassificationAnnotation('4.png', [], ['5.png']),
+        ReIdentificationClassificationAnnotation('5.png', [], []),
+    ]
+
+
+class TestAnnotationStore:
+    def test_store_keeps_representations_in_order(self, tmp_path):
+        annotation = make_classification(10)
+        write_annotation_store(annotation, tmp_path / 'annotation.pickle')
+
+        store = AnnotationStore(tmp_path / 'annotation.pickle')
+
+        assert len(store) == 10
+        assert [(entry.identifier, entry.label) for entry in store] == [
+            (entry.identifier, entry.label) for entry in annotation
+        ]
+        assert store[-1].identifier == '9.png'
+        assert [entry.identifier for entry in store[2:5]] == ['2.png', '3.png', '4.png']
+
+    def test_store_index_out_of_range(self, tmp_path):
+        write_annotation_store(make_classification(2), tmp_path / 'annotation.pickle')
+
+        with pytest.raises(IndexError):
+            AnnotationStore(tmp_path / 'annotation.pickle')[2]
+
+    def test_store_finds_representation_by_identifier(self, tmp_path):
+        write_annotation_store(make_classification(100), tmp_path / 'annotation.pickle')
+
+        store = AnnotationStore(tmp_path / 'annotation.pickle')
+
+        assert all(store.index_of('{}.png'.format(identifier)) == identifier for identifier in range(100))
+        assert store.get('42.png').label == 0
+        assert store.get('100.png') is None
+        with pytest.raises(KeyError):
+            store.index_of('100.png')
+
+    def test_store_finds_first_of_repeated_identifiers(self, tmp_path):
+        annotation = make_classification(3) + [ClassificationAnnotation('1.png', 2)]
+        write_annotation_store(annotation, tmp_path / 'annotation.pickle')
+
+        assert AnnotationStore(tmp_path / 'annotation.pickle').index_of('1.png') == 1
+
+    def test_store_supports_not_string_identifiers(self, tmp_path):
+        annotation = [ClassificationAnnotation(['0.png', '1.png'], 0), ClassificationAnnotation(('2.png', 3), 1)]
+        write_annotation_store(annotation, tmp_path / 'annotation.pickle')
+
+        store = AnnotationStore(tmp_path / 'annotation.pickle')
+
+        assert store.index_of(['0.png', '1.png']) == 0
+        assert store.index_of(('2.png', 3)) == 1
+
+    def test_empty_store(self, tmp_path):
+        write_annotation_store([], tmp_path / 'annotation.pickle')
+
+        store = AnnotationStore(tmp_path / 'annotation.pickle')
+
+        assert len(store) == 0
+        assert store.get('0.png') is None
+
+    def test_truncated_store_raises_error(self, tmp_path):
+        write_annotation_store(make_classification(5), tmp_path / 'annotation.pickle')
+        data = (tmp_path / 'annotation.pickle').read_bytes()
+        (tmp_path / 'annotation.pickle').write_bytes(data[:-4])
+
+        with pytest.raises(ValueError):
+            AnnotationStore(tmp_path / 'annotation.pickle')
+
+    def test_read_saved_annotation_as_store(self, tmp_path):
+        save_annotation(make_classification(5), None, tmp_path / 'annotation.pickle', None)
+
+        annotation = read_annotation(tmp_path / 'annotation.pickle')
+
+        assert isinstance(annotation, AnnotationStore)
+        assert [entry.identifier for entry in annotation] == ['{}.png'.format(identifier) for identifier in range(5)]
+
+    def test_read_annotation_of_pickled_representations(self, tmp_path):
+        with (tmp_path / 'annotation.pickle').open('wb') as file:
+            for representation in make_classification(3):
+                representation.dump(file)
+
+        annotation = read_annotation(tmp_path / 'annotation.pickle')
+
+        assert [entry.identifier for entry in annotation] == ['0.png', '1.png', '2.png']
+
+    def test_identifier_index_of_list(self):
+        index_of = identifier_index(make_classification(5))
+
+        assert index_of('3.png') == 3
+        with pytest.raises(KeyError):
+            index_of('5.png')
+
+
+class TestMakeSubset:
+    def test_subset_of_store_matches_subset_of_list(self, tmp_path):
+        annotation = make_classification(20)
+        write_annotation_store(annotation, tmp_path / 'annotation.pickle')
+
+        expected = make_subset(annotation, 5, 42)
+        actual = make_subset(AnnotationStore(tmp_path / 'annotation.pickle'), 5, 42)
+
+        assert [entry.identifier for entry in actual] == [entry.identifier for entry in expected]
+
+    def test_pairwise_subset_contains_pairs(self):
+        subset = make_subset(make_pairwise(), 4, 1)
+        identifiers = [entry.identifier for entry in subset]
+
+        assert len(identifiers) == len(set(identifiers))
+        assert len(identifiers) >= 3
+        for entry in subset:
+            assert entry.positive_pairs.issubset(identifiers)
+            assert entry.negative_pairs.issubset(identifiers)
+
+    def test_pairwise_subset_of_store_has_no_duplicates(self, tmp_path):
+        write_annotation_store(make_pairwise(), tmp_path / 'annotation.pickle')
+
+        subset = make_subset(AnnotationStore(tmp_path / 'annotation.pickle'), 6, 1)
+
+        assert sorted(entry.identifier for entry in subset) == ['{}.png'.format(index) for index in range(6)]
@@ -0,0 +1,148 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import multiprocessing
+from unittest.mock import Mock
+
+import numpy as np
+import pytest
+
+from accuracy_checker.evaluators.data_loader import (
+    ParallelDataLoader, SequentialDataLoader, create_data_loader, _pack_inputs, _unpack_inputs
+)
+
+fork_required = pytest.mark.skipif(
+    'fork' not in multiprocessing.get_all_start_methods(), reason='parallel data loading requires fork'
+)
+
+
+class Annotation:
+    def __init__(self, identifier):
+        self.identifier = identifier
+        self.metadata = {}
+
+
+class BatchedDataset:
+    def __init__(self, size, batch):
+        self.annotation = [Annotation(identifier) for identifier in range(size)]
+        self.batch = batch
+
+    def __getitem__(self, item):
+        if len(self.annotation) <= item * self.batch:
+            raise IndexError
+
+        return self.annotation[item * self.batch:(item + 1) * self.batch]
+
+
+def prepare_batch(batch_annotation):
+    identifiers = [annotation.identifier for annotation in batch_annotation]
+    for annotation in batch_annotation:
+        annotation.metadata['image_size'] = [(annotation.identifier, 1)]
+    # later batches are larger than the first one, so a part of them does not fit the shared memory slot
+    data = np.full((len(identifiers), 3, 2 + identifiers[0], 2), identifiers[0], dtype=np.float32)
+    return [{'data': data, 'identifiers': identifiers}], [{'id': identifier} for identifier in identifiers], identifiers
+
+
+def failing_prepare_batch(batch_annotation):
+    if batch_annotation[0].identifier == 4:
+        raise ValueError('broken image')
+
+    return prepare_batch(batch_annotation)
+
+
+def collect(loader, dataset):
+    result = []
+    for batch_id, batch_annotation, filled_inputs, batch_meta, batch_identifiers in loader.iterate(dataset):
+        # shared memory slots are reused after the next batch is requested, so the inputs are copied here
+        result.append((
+            batch_id, [annotation.identifier for annotation in batch_annotation],
+            [annotation.metadata for annotation in batch_annotation],
+            filled_inputs[0]['data'].copy(), filled_inputs[0]['identifiers'], batch_meta, batch_identifiers
+        ))
+
+    return result
+
+
+def assert_same_batches(expected, actual):
+    assert len(expected) == len(actual)
+    for expected_batch, actual_batch in zip(expected, actual):
+        assert expected_batch[:3] == actual_batch[:3]
+        assert np.array_equal(expected_batch[3], actual_batch[3])
+        assert expected_batch[4:] == actual_batch[4:]
+
+
+class TestDataLoader:
+    def test_sequential_loader_iterates_in_dataset_order(self):
+        batches = collect(SequentialDataLoader(prepare_batch), BatchedDataset(5, 2))
+
+        assert [batch[0] for batch in batches] == [0, 1, 2]
+        assert [batch[1] for batch in batches] == [[0, 1], [2, 3], [4]]
+
+    def test_create_sequential_loader_without_workers(self):
+        assert isinstance(create_data_loader(prepare_batch, Mock(), 0), SequentialDataLoader)
+
+    def test_create_sequential_loader_for_reader_with_state(self):
+        reader = Mock()
+        reader.multiprocessing_safe = False
+        reader.__provider__ = 'opencv_capture'
+
+        assert isinstance(create_data_loader(prepare_batch, reader, 2), SequentialDataLoader)
+
+    @fork_required
+    def test_create_parallel_loader(self):
+        reader = Mock()
+        reader.multiprocessing_safe = True
+
+        loader = create_data_loader(prepare_batch, reader, 2)
+
+        assert isinstance(loader, ParallelDataLoader)
+        assert loader.prefetch == 4
+
+    def test_packed_inputs_share_buffer(self):
+        buffer = np.zeros(1024, dtype=np.uint8)
+        inputs = [{'data': np.arange(6, dtype=np.float32).reshape(2, 3), 'scale': 0.5}]
+
+        unpacked = _unpack_inputs(_pack_inputs(inputs, buffer), buffer)
+
+        assert np.array_equal(unpacked[0]['data'], inputs[0]['data'])
+        assert unpacked[0]['data'].base is not None
+        assert unpacked[0]['scale'] == 0.5
+
+    def test_inputs_not_fitting_buffer_are_passed_as_is(self):
+        buffer = np.zeros(8, dtype=np.uint8)
+        inputs = [{'data': np.arange(6, dtype=np.float32)}]
+
+        packed = _pack_inputs(inputs, buffer)
+
+        assert packed[0]['data'] is inputs[0]['data']
+
+    @fork_required
+    @pytest.mark.parametrize('workers,prefetch', [(1, 1), (2, None), (3, 2)])
+    def test_parallel_loader_matches_sequential(self, workers, prefetch):
+        expected = collect(SequentialDataLoader(prepare_batch), BatchedDataset(11, 2))
+
+        actual = collect(ParallelDataLoader(prepare_batch, workers, prefetch), BatchedDataset(11, 2))
+
+        assert_same_batches(expected, actual)
+
+    @fork_required
+    def test_parallel_loader_on_empty_dataset(self):
+        assert collect(ParallelDataLoader(prepare_batch, 2), BatchedDataset(0, 2)) == []
+
+    @fork_required
+    def test_parallel_loader_reports_worker_error(self):
+        with pytest.raises(RuntimeError, match='broken image'):
+            collect(ParallelDataLoader(failing_prepare_batch, 2), BatchedDataset(8, 2))
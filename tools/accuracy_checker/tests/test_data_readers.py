@@ -0,0 +1,145 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+from pathlib import Path
+
+import cv2
+import numpy as np
+import pytest
+
+from accuracy_checker.data_readers import BaseReader
+
+FRAMES_NUM = 12
+
+
+def frame_value(frame_id):
+    return 20 * frame_id
+
+
+def frame_index(frame):
+    return int(round(float(frame.mean()) / 20))
+
+
+@pytest.fixture(scope='module')
+def video(tmpdir_factory):
+    path = Path(str(tmpdir_factory.mktemp('video'))) / 'video.avi'
+    writer = cv2.VideoWriter(str(path), cv2.VideoWriter_fourcc(*'MJPG'), 10, (32, 24))
+    if not writer.isOpened():
+        pytest.skip('video writer is not available')
+    for frame_id in range(FRAMES_NUM):
+        writer.write(np.full((24, 32, 3), frame_value(frame_id), dtype=np.uint8))
+    writer.release()
+
+    return path
+
+
+class CountingCapture:
+    def __init__(self, capture):
+        self.capture = capture
+        self.reads = 0
+        self.seeks = 0
+
+    def read(self):
+        self.reads += 1
+        return self.capture.read()
+
+    def set(self, prop, value):
+        self.seeks += 1
+        return self.capture.set(prop, value)
+
+
+def create_reader(video, **config):
+    reader = BaseReader.provide('opencv_capture', str(video), dict(config, type='opencv_capture'))
+    reader.videocap = CountingCapture(reader.videocap)
+
+    return reader
+
+
+class TestOpenCVFrameReader:
+    def test_cached_frames_are_not_decoded_again(self, video):
+        reader = create_reader(video, cache_size=4)
+
+        assert [frame_index(frame) for frame in reader.read_dispatcher([0, 1, 2])] == [0, 1, 2]
+        reads = reader.videocap.reads
+        assert [frame_index(frame) for frame in reader.read_dispatcher([1, 2])] == [1, 2]
+
+        assert reader.videocap.reads == reads
+        assert reader.videocap.seeks == 0
+
+    def test_least_recently_used_frames_are_evicted(self, video):
+        reader = create_reader(video, cache_size=2)
+
+        reader.read_dispatcher([0, 1, 2, 3])
+        assert list(reader.cache) == [2, 3]
+
+        reader.read(2)
+        reader.read(4)
+        assert list(reader.cache) == [2, 4]
+
+        assert frame_index(reader.read(0)) == 0
+        assert reader.videocap.seeks == 1
+
+    def test_out_of_order_requests_return_frames_in_requested_order(self, video):
+        reader = create_reader(video, cache_size=8)
+
+        frames = reader.read_dispatcher([5, 1, 3, 1])
+
+        assert [frame_index(frame) for frame in frames] == [5, 1, 3, 1]
+        # missed frames are decoded in one forward run
+        assert reader.videocap.reads == 6
+        assert reader.videocap.seeks == 0
+
+    def test_backward_request_seeks(self, video):
+        reader = create_reader(video, cache_size=2)
+
+        reader.read(6)
+        assert frame_index(reader.read(1)) == 1
+
+        assert reader.videocap.seeks == 1
+
+    def test_returned_frames_do_not_share_memory_with_cache(self, video):
+        reader = create_reader(video, cache_size=4)
+
+        frames = reader.read_dispatcher([2, 2])
+        frames[0][:] = 0
+
+        assert frame_index(frames[1]) == 2
+        assert frame_index(reader.read(2)) == 2
+
+    def test_zero_cache_size_disables_cache(self, video):
+        reader = create_reader(video, cache_size=0)
+
+        frames = reader.read_dispatcher([1, 3, 3])
+        assert [frame_index(frame) for frame in frames] == [1, 3, 3]
+        assert frames[1] is not frames[2]
+        assert not reader.cache
+
+        assert frame_index(reader.read(3)) == 3
+        assert reader.videocap.seeks == 1
+
+    def test_frame_beyond_end_raises_eof_error(self, video):
+        reader = create_reader(video, cache_size=0)
+
+        with pytest.raises(EOFError):
+            reader.read(FRAMES_NUM)
+        with pytest.raises(EOFError):
+            reader.read(FRAMES_NUM + 5)
+
+    def test_negative_frame_raises_index_error(self, video):
+        reader = create_reader(video)
+
+        with pytest.raises(IndexError):
+            reader.read(-1)
@@ -0,0 +1,233 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+from collections import Counter
+
+import numpy as np
+import pytest
+
+from accuracy_checker.config import ConfigError
+from accuracy_checker.dataset import ReorderedAnnotation
+from accuracy_checker.evaluators.early_termination import (
+    FAILED, PASSED, EarlyTermination, decide, stratified_order, wilson_interval
+)
+from accuracy_checker.metrics import MetricsExecutor
+from accuracy_checker.representation import (
+    ClassificationAnnotation, ClassificationPrediction, ReIdentificationAnnotation, ReIdentificationPrediction
+)
+from tests.common import make_representation, single_class_dataset
+
+
+def classification_data(size, accuracy, classes=4, seed=0):
+    random_state = np.random.RandomState(seed)
+    annotations, predictions = [], []
+    for identifier in range(size):
+        label = identifier % classes
+        predicted = label if random_state.uniform() < accuracy else (label + 1) % classes
+        annotations.append(ClassificationAnnotation(identifier, label))
+        predictions.append(ClassificationPrediction(identifier, np.eye(classes)[predicted]))
+
+    return annotations, predictions
+
+
+def detection_data(size, recall, seed=0):
+    random_state = np.random.RandomState(seed)
+    annotations, predictions = [], []
+    for identifier in range(size):
+        annotation = make_representation('0 0 0 10 10', is_ground_truth=True)[0]
+        box = '0 0 0 10 10' if random_state.uniform() < recall else '0 20 20 30 30'
+        prediction = make_representation(box, score=random_state.uniform())[0]
+        annotation.identifier = prediction.identifier = identifier
+        annotations.append(annotation)
+        predictions.append(prediction)
+
+    return annotations, predictions
+
+
+def reid_data(persons, queries, seed=0):
+    random_state = np.random.RandomState(seed)
+    centers = random_state.normal(size=(persons, 16))
+    annotations, predictions = [], []
+    for identifier in range(persons + queries):
+        query = identifier >= persons
+        person = identifier % persons
+        annotations.append(ReIdentificationAnnotation(identifier, int(query), person, query))
+        embedding = centers[person] + random_state.normal(scale=0.3, size=16)
+        predictions.append(ReIdentificationPrediction(identifier, embedding))
+
+    return annotations, predictions
+
+
+def run(termination, annotations, predictions, batch=10):
+    for end in range(batch, len(annotations) + 1, batch):
+        if termination.should_stop(annotations[:end], predictions[:end]):
+            return end
+
+    return len(annotations)
+
+
+def accuracy_termination(reference, threshold, **config):
+    executor = MetricsExecutor([{'type': 'accuracy', 'reference': reference, 'threshold': threshold}])
+    return EarlyTermination(executor, config, 10000)
+
+
+class TestStratifiedOrder:
+    def test_order_is_permutation_with_proportional_prefixes(self):
+        annotation = [ClassificationAnnotation(i, 0 if i < 900 else 1) for i in range(1000)]
+
+        order = stratified_order(annotation, seed=1)
+
+        assert sorted(order) == list(range(1000))
+        prefix_labels = Counter(annotation[position].label for position in order[:100])
+        assert 8 <= prefix_labels[1] <= 12
+        assert order != stratified_order(annotation, seed=2)
+
+    def test_reid_gallery_precedes_queries(self):
+        annotation = [ReIdentificationAnnotation(i, 0, i % 5, i % 3 == 0) for i in range(30)]
+
+        order = stratified_order(annotation)
+
+        queries = [annotation[position].query for position in order]
+        assert queries == sorted(queries)
+
+    def test_reordered_annotation_supports_slices(self):
+        annotation = ReorderedAnnotation(['a', 'b', 'c', 'd'], [2, 0, 3, 1])
+
+        assert len(annotation) == 4
+        assert annotation[0] == 'c'
+        assert annotation[1:3] == ['a', 'd']
+
+
+class TestIntervals:
+    def test_wilson_interval_contains_proportion_and_narrows(self):
+        lower, upper = wilson_interval(90, 100, 0.05)
+        narrow_lower, narrow_upper = wilson_interval(9000, 10000, 0.05)
+
+        assert lower < 0.9 < upper
+        assert narrow_lower < 0.9 < narrow_upper
+        assert narrow_upper - narrow_lower < upper - lower
+
+    def test_decision_requires_interval_on_one_side_of_threshold(self):
+        assert decide(75.8, 76.4, 76.15, 0.5) == PASSED
+        assert decide(74.0, 75.5, 76.15, 0.5) == FAILED
+        assert decide(75.5, 76.4, 76.15, 0.5) is None
+        assert decide(76.7, 77.0, 76.15, 0.5) == FAILED
+
+
+class TestEarlyTermination:
+    def test_matching_accuracy_stops_with_pass(self):
+        annotations, predictions = classification_data(10000, 0.8)
+        termination = accuracy_termination(80, 3)
+
+        processed = run(termination, annotations, predictions)
+
+        assert termination.stopped
+        assert processed < 5000
+        assert termination.intervals[0].decision == PASSED
+
+    def test_different_accuracy_stops_with_fail(self):
+        annotations, predictions = classification_data(10000, 0.7)
+        termination = accuracy_termination(80, 2)
+
+        processed = run(termination, annotations, predictions)
+
+        assert termination.stopped
+        assert processed < 1000
+        assert termination.intervals[0].decision == FAILED
+
+    def test_tight_threshold_is_not_resolved(self):
+        annotations, predictions = classification_data(2000, 0.8)
+        termination = accuracy_termination(80, 0.01)
+
+        assert run(termination, annotations, predictions) == 2000
+        assert not termination.stopped
+
+    def test_first_check_waits_for_min_size(self):
+        annotations, predictions = classification_data(1000, 0.7)
+        termination = accuracy_termination(20, 1, min_size=500)
+
+        assert not termination.should_stop(annotations[:499], predictions[:499])
+        assert termination.should_stop(annotations[:500], predictions[:500])
+
+    def test_map_interval_is_bootstrapped_without_changing_metric_meta(self):
+        annotations, predictions = detection_data(600, 0.9)
+        executor = MetricsExecutor([{'type': 'map', 'reference': 40, 'threshold': 5}], single_class_dataset())
+        metric_fn = executor.metrics[0].metric_fn
+        names = list(metric_fn.meta['names'])
+        termination = EarlyTermination(executor, {'bootstrap_samples': 50, 'min_size': 100}, 600)
+
+        run(termination, annotations, predictions, batch=50)
+
+        assert termination.stopped
+        assert termination.intervals[0].decision == FAILED
+        assert metric_fn.meta['names'] == names
+
+    def test_cmc_interval_is_available_after_gallery(self):
+        annotations, predictions = reid_data(100, 400)
+        order = stratified_order(annotations)
+        annotations = [annotations[position] for position in order]
+        predictions = [predictions[position] for position in order]
+        executor = MetricsExecutor([{'type': 'cmc', 'reference': 90, 'threshold': 5}])
+        termination = EarlyTermination(executor, {'bootstrap_samples': 50, 'min_size': 100}, 500)
+
+        assert not termination.should_stop(annotations[:100], predictions[:100])
+        assert termination.intervals[0].lower is None
+        assert run(termination, annotations, predictions, batch=20) < 500
+        assert termination.intervals[0].decision == PASSED
+
+    def test_metrics_without_reference_are_not_checked(self):
+        executor = MetricsExecutor([
+            {'type': 'accuracy', 'name': 'top1', 'reference': 80, 'threshold': 1},
+            {'type': 'accuracy', 'name': 'top5', 'top_k': 2}
+        ])
+
+        termination = EarlyTermination(executor)
+
+        assert [metric.name for metric in termination.metrics] == ['top1']
+        assert termination.alpha == pytest.approx(0.05)
+
+    def test_no_checked_metrics_raise_config_error(self):
+        with pytest.raises(ConfigError):
+            EarlyTermination(MetricsExecutor([{'type': 'accuracy'}]))
+
+    def test_unsupported_metric_raises_config_error(self):
+        executor = MetricsExecutor(
+            [{'type': 'accuracy_per_class', 'reference': 80, 'threshold': 1}], single_class_dataset()
+        )
+
+        with pytest.raises(ConfigError):
+            EarlyTermination(executor)
+
+    def test_error_probability_is_spent_over_checks(self):
+        annotations, predictions = classification_data(2000, 0.8)
+        termination = accuracy_termination(80, 0.01, min_size=100)
+
+        run(termination, annotations, predictions, batch=100)
+
+        assert termination.checks > 1
+        assert termination.check_alpha == pytest.approx(0.05 * 6 / (np.pi ** 2 * termination.checks ** 2))
+
+    def test_wrong_decision_rate_under_null_hypothesis_is_bounded(self):
+        # accuracy is on the threshold boundary, so both a pass and a fail exclude the true value,
+        # with the same confidence at every one of ~40 checks nearly a fifth of the runs is resolved
+        runs, resolved = 100, 0
+        for seed in range(runs):
+            annotations, predictions = classification_data(2000, 0.78, seed=seed)
+            termination = accuracy_termination(80, 2, min_size=50, check_growth=1.01)
+            run(termination, annotations, predictions, batch=50)
+            resolved += int(termination.stopped)
+
+        assert resolved <= 0.05 * runs
@@ -0,0 +1,117 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import numpy as np
+import pytest
+
+from accuracy_checker.data_readers import DataRepresentation
+from accuracy_checker.preprocessor import Normalize, Resize
+from accuracy_checker.preprocessor.fused_preprocessing import FusedPreprocessing
+from accuracy_checker.preprocessor.preprocessing_executor import PreprocessingExecutor
+
+CHAINS = [
+    [
+        {'type': 'resize', 'size': 256},
+        {'type': 'crop', 'size': 224},
+        {'type': 'bgr_to_rgb'},
+        {'type': 'normalization', 'mean': '(123.675, 116.28, 103.53)', 'std': '(58.395, 57.12, 57.375)'},
+    ],
+    [
+        {'type': 'resize', 'dst_width': 40, 'dst_height': 30, 'aspect_ratio_scale': 'greater'},
+        {'type': 'flip', 'mode': 'vertical'},
+        {'type': 'normalization', 'mean': 'imagenet'},
+    ],
+    [
+        {'type': 'bgr_to_rgb'},
+        {'type': 'flip', 'mode': 'horizontal'},
+        {'type': 'crop', 'central_fraction': 0.5},
+        {'type': 'normalization', 'mean': '(1, 2, 3)'},
+    ],
+    [
+        {'type': 'crop', 'size': 80},
+        {'type': 'resize', 'size': 20, 'interpolation': 'CUBIC'},
+        {'type': 'normalization', 'std': '255'},
+    ],
+    [
+        {'type': 'resize', 'size': 32, 'interpolation': 'NEAREST'},
+        {'type': 'bgr_to_rgb'},
+        {'type': 'flip'},
+    ],
+]
+
+
+def preprocess(config, image, enable_fusion):
+    executor = PreprocessingExecutor(config, enable_fusion=enable_fusion)
+    return executor.process([DataRepresentation(image.copy())])[0]
+
+
+class TestFusedPreprocessing:
+    @pytest.mark.parametrize('config', CHAINS)
+    def test_fused_chain_is_identical_to_separate_preprocessors(self, config):
+        image = np.random.RandomState(0).randint(0, 256, size=(61, 77, 3), dtype=np.uint8)
+
+        expected = preprocess(config, image, enable_fusion=False)
+        actual = preprocess(config, image, enable_fusion=True)
+
+        assert actual.data.dtype == expected.data.dtype
+        assert actual.data.shape == expected.data.shape
+        assert np.array_equal(actual.data, expected.data)
+        assert actual.metadata == expected.metadata
+
+    def test_fused_chain_of_float_image(self):
+        image = np.random.RandomState(0).uniform(0, 255, size=(50, 50, 3)).astype(np.float32)
+
+        expected = preprocess(CHAINS[2], image, enable_fusion=False)
+        actual = preprocess(CHAINS[2], image, enable_fusion=True)
+
+        assert actual.data.dtype == expected.data.dtype
+        assert np.array_equal(actual.data, expected.data)
+
+    def test_fused_chain_does_not_change_source_image(self):
+        image = np.random.RandomState(0).randint(0, 256, size=(40, 40, 3), dtype=np.uint8)
+        source = image.copy()
+        executor = PreprocessingExecutor(CHAINS[2])
+
+        executor.process([DataRepresentation(image)])
+
+        assert np.array_equal(image, source)
+
+    def test_crop_smaller_image_is_identical_to_separate_preprocessors(self):
+        image = np.random.RandomState(0).randint(0, 256, size=(20, 30, 3), dtype=np.uint8)
+        config = [{'type': 'resize', 'size': 16}, {'type': 'crop', 'size': 24}, {'type': 'normalization', 'std': '2'}]
+
+        expected = preprocess(config, image, enable_fusion=False)
+        actual = preprocess(config, image, enable_fusion=True)
+
+        assert np.array_equal(actual.data, expected.data)
+
+    def test_executor_fuses_sequences_of_fusible_preprocessors(self):
+        executor = PreprocessingExecutor([
+            {'type': 'resize', 'size': 32},
+            {'type': 'normalization', 'mean': '1'},
+            {'type': 'bgr_to_gray'},
+            {'type': 'resize', 'size': 16},
+            {'type': 'resize', 'size': 8, 'use_pillow': True},
+        ])
+
+        assert len(executor.processors) == 5
+        assert isinstance(executor.processors[0], Resize)
+        assert isinstance(executor.processors[1], Normalize)
+        chain = executor._chain
+        assert len(chain) == 4
+        assert isinstance(chain[0], FusedPreprocessing)
+        assert chain[0].processors == executor.processors[:2]
+        assert chain[1:] == executor.processors[2:]
@@ -155,6 +155,17 @@ class TestModelEvaluator:
         assert not self.postprocessor.process_dataset.called
         assert self.postprocessor.full_process.called
 
+    def test_process_dataset_stops_when_early_termination_resolves_check(self):
+        self.postprocessor.has_dataset_processors = False
+        self.evaluator.early_termination = Mock()
+        self.evaluator.early_termination.should_stop = Mock(return_value=True)
+
+        self.evaluator.dataset_processor(None, None)
+
+        assert self.launcher.predict.call_count == 1
+        assert self.metric.update_metrics_on_batch.call_count == 1
+        assert self.evaluator.early_termination.should_stop.call_count == 1
+
 
 class TestModelEvaluatorAsync:
     def setup_method(self):
@@ -277,3 +288,13 @@ class TestModelEvaluatorAsync:
         assert self.metric.update_metrics_on_batch.call_count == 1
         assert not self.postprocessor.process_dataset.called
         assert self.postprocessor.full_process.called
+
+    def test_process_dataset_does_not_submit_batches_after_early_termination(self):
+        self.postprocessor.has_dataset_processors = False
+        self.evaluator.early_termination = Mock()
+        self.evaluator.early_termination.should_stop = Mock(return_value=True)
+
+        self.evaluator.dataset_processor(None, None)
+
+        assert self.launcher.predict_async.call_count == 1
+        assert self.metric.update_metrics_on_batch.call_count == 1
@@ -0,0 +1,170 @@
+"""
+Copyright (c) 2019 Intel Corporation
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+from pathlib import Path
+from unittest.mock import Mock
+
+import pytest
+
+from accuracy_checker.config import ConfigError
+from accuracy_checker.evaluators.sweep import (
+    SweepConfig, SweepEvaluator, SweepPoint, SweepResult, apply_overrides, measure_performance, pareto_frontier
+)
+
+
+class FakeRequest:
+    def __init__(self):
+        self.waits = 0
+
+    def wait(self, timeout):
+        self.waits += 1
+        return 0
+
+
+class TestSweepConfig:
+    def test_points_are_product_of_grid_and_variants(self):
+        config = SweepConfig({
+            'grid': {'launcher.batch': [1, 4], 'launcher.device_config.CPU_THROUGHPUT_STREAMS': [1, 2]},
+            'variants': {'FP32': {'launcher.model': 'fp32.xml'}, 'INT8': {'launcher.model': 'int8.xml'}}
+        })
+
+        points = config.points()
+
+        assert len(points) == 8
+        assert points[0].name == 'FP32, batch=1, CPU_THROUGHPUT_STREAMS=1'
+        assert points[0].overrides == {
+            'launcher.batch': 1, 'launcher.device_config.CPU_THROUGHPUT_STREAMS': 1, 'launcher.model': 'fp32.xml'
+        }
+        assert points[-1].overrides['launcher.model'] == 'int8.xml'
+
+    def test_empty_config_has_one_default_point(self):
+        assert SweepConfig({}).points() == [SweepPoint('default', {})]
+
+    def test_entry_outside_of_launcher_and_dataset_raises_config_error(self):
+        with pytest.raises(ConfigError):
+            SweepConfig({'grid': {'model.batch': [1]}})
+
+    def test_empty_grid_values_raise_config_error(self):
+        with pytest.raises(ConfigError):
+            SweepConfig({'grid': {'launcher.batch': []}})
+
+
+class TestApplyOverrides:
+    def test_nested_entries_and_list_items_are_overridden_in_copies(self):
+        launcher = {'framework': 'dlsdk', 'batch': 1}
+        dataset = {'name': 'dataset', 'preprocessing': [{'type': 'resize', 'size': 224}]}
+
+        launcher_entry, dataset_entry = apply_overrides(launcher, dataset, {
+            'launcher.device_config.CPU_THREADS_NUM': 4, 'launcher.batch': 8, 'dataset.preprocessing.0.size': 192
+        })
+
+        assert launcher_entry == {'framework': 'dlsdk', 'batch': 8, 'device_config': {'CPU_THREADS_NUM': 4}}
+        assert dataset_entry['preprocessing'] == [{'type': 'resize', 'size': 192}]
+        assert launcher == {'framework': 'dlsdk', 'batch': 1}
+        assert dataset['preprocessing'][0]['size'] == 224
+
+    def test_relative_paths_of_overridden_entries_are_prefixed(self):
+        launcher = {'framework': 'dlsdk', 'model': Path('/models/fp32.xml'), 'weights': Path('/models/fp32.bin')}
+        arguments = {'models': Path('/models')}
+
+        launcher_entry, _ = apply_overrides(launcher, {'name': 'dataset'}, {
+            'launcher.model': 'int8/model.xml', 'launcher.weights': '/weights/model.bin'
+        }, arguments)
+
+        assert launcher_entry['model'] == Path('/models/int8/model.xml')
+        assert launcher_entry['weights'] == Path('/weights/model.bin')
+
+
+class TestParetoFrontier:
+    def test_dominated_points_are_excluded(self):
+        points = [(0.75, 100), (0.76, 80), (0.70, 90), (0.76, 100), None]
+
+        assert pareto_frontier(points) == [3]
+
+    def test_trade_off_points_are_kept(self):
+        points = [(0.76, 50), (0.75, 100), (0.70, 200), (0.69, 150)]
+
+        assert pareto_frontier(points) == [0, 1, 2]
+
+    def test_lower_metric_and_latency_are_minimized(self):
+        points = [(0.1, 5.0), (0.2, 2.0), (0.2, 6.0)]
+
+        assert pareto_frontier(points, lower_is_better=True, objective='latency') == [0, 1]
+
+    def test_equal_points_are_both_kept(self):
+        assert pareto_frontier([(0.5, 10), (0.5, 10)]) == [0, 1]
+
+
+class TestMeasurePerformance:
+    def test_sync_mode_measures_every_iteration(self):
+        launcher = Mock()
+        batches = [([{'data': 1}], [{}, {}]), ([{'data': 2}], [{}])]
+
+        performance = measure_performance(launcher, batches, iterations=4, warmup=1)
+
+        assert launcher.predict.call_count == 5
+        assert launcher.predict.call_args_list[2][0] == batches[1]
+        assert performance['throughput'] > 0
+        assert set(performance) == {'throughput', 'latency_mean', 'latency_median', 'latency_p90'}
+
+    def test_async_mode_keeps_all_requests_busy(self):
+        launcher = Mock()
+        launcher.infer_requests = [FakeRequest(), FakeRequest()]
+        batches = [([{'data': 1}], [{}])]
+
+        performance = measure_performance(launcher, batches, iterations=5, warmup=1, async_mode=True)
+
+        assert launcher.predict_async.call_count == 6
+        assert sum(request.waits for request in launcher.infer_requests) == 6
+        assert performance['throughput'] > 0
+
+    def test_no_batches_raise_error(self):
+        with pytest.raises(ValueError):
+            measure_performance(Mock(), [], iterations=1)
+
+
+class TestSweepEvaluator:
+    def test_failed_points_are_reported_and_skipped_by_frontier(self, tmpdir):
+        output = Path(str(tmpdir)) / 'sweep.csv'
+        evaluator = SweepEvaluator(SweepConfig({'grid': {'launcher.batch': [1, 2, 4]}, 'output': str(output)}))
+        performance = {'throughput': 10, 'latency_mean': 1, 'latency_median': 1, 'latency_p90': 1}
+
+        def evaluate_point(launcher_config, dataset_config, progress_reporter=None):
+            if launcher_config['batch'] == 4:
+                raise RuntimeError('batch is not supported')
+            return {'accuracy': 0.5}, dict(performance, throughput=10 * launcher_config['batch'])
+
+        evaluator.evaluate_point = evaluate_point
+        results = evaluator.run({'framework': 'dlsdk', 'batch': 1}, {'name': 'dataset'})
+        lines = []
+        evaluator.report(results, lines.append)
+
+        assert [result.error for result in results] == [None, None, 'batch is not supported']
+        assert evaluator.frontier(results) == [1]
+        assert any(line.startswith('batch=2') and line.endswith('*') for line in lines)
+        rows = output.read_text().splitlines()
+        assert rows[0] == 'point,launcher.batch,accuracy,throughput,latency_mean,latency_median,latency_p90,pareto,error'
+        assert rows[2].startswith('batch=2,2,0.5,20,') and rows[2].endswith(',1,')
+
+    def test_frontier_metric_is_selected_by_name(self):
+        evaluator = SweepEvaluator(SweepConfig({'metric': 'map'}))
+        performance = {'throughput': 10}
+        results = [
+            SweepResult(SweepPoint('a', {}), {'recall': 0.9, 'map': 0.5}, performance, None),
+            SweepResult(SweepPoint('b', {}), {'recall': 0.8, 'map': 0.6}, performance, None),
+        ]
+
+        assert evaluator.frontier(results) == [1]
@@ -85,6 +85,36 @@ class TaggedBase:
         except KeyError:
             raise DeserializationError('Unknown "$type": "{}"'.format(value['$type']))
 
+def get_resumable(session, url, offset, **kwargs):
+    """
+    Requests the content of the file starting at offset. Returns the response and the offset
+    its content starts at, which is 0 if the server does not support ranges.
+    """
+    headers = {'Range': 'bytes={}-'.format(offset)} if offset else {}
+    response = session.get(url, stream=True, timeout=DOWNLOAD_TIMEOUT, headers=headers, **kwargs)
+
+    if offset and response.status_code == 416:
+        # the partial file is not shorter than the file, so it cannot be its beginning
+        response.close()
+        return get_resumable(session, url, 0, **kwargs)
+
+    response.raise_for_status()
+
+    if response.status_code == 206:
+        if response.headers.get('content-range', '').startswith('bytes {}-'.format(offset)):
+            return response, offset
+        response.close()
+        return get_resumable(session, url, 0, **kwargs)
+
+    return response, 0
+
+def download_size(response, offset, total_size):
+    if total_size is not None:
+        return total_size
+
+    content_length = int(response.headers.get('content-length', 0))
+    return offset + content_length if content_length else 0
+
 class FileSource(TaggedBase):
     types = {}
 
@@ -102,16 +132,9 @@ class FileSourceHttp(FileSource):
     def deserialize(cls, source):
         return FileSourceHttp(validate_string('"url"', source['url']))
 
-    def start_download(self, session, chunk_size, total_size=None):
-        response = session.get(self.url, stream=True, timeout=DOWNLOAD_TIMEOUT)
-        response.raise_for_status()
-
-        if total_size is None:
-            size = int(response.headers.get('content-length', 0))
-        else:
-            size = total_size
-
-        return response.iter_content(chunk_size=chunk_size), size
+    def start_download(self, session, chunk_size, offset=0, total_size=None):
+        response, offset = get_resumable(session, self.url, offset)
+        return response.iter_content(chunk_size=chunk_size), download_size(response, offset, total_size), offset
 
 FileSource.types['http'] = FileSourceHttp
 
@@ -123,18 +146,17 @@ class FileSourceGoogleDrive(FileSource):
     def deserialize(cls, source):
         return FileSourceGoogleDrive(validate_string('"id"', source['id']))
 
-    def start_download(self, session, chunk_size, total_size):
+    def start_download(self, session, chunk_size, offset=0, total_size=None):
         URL = 'https://docs.google.com/uc?export=download'
-        response = session.get(URL, params={'id' : self.id}, stream=True, timeout=DOWNLOAD_TIMEOUT)
-        response.raise_for_status()
+        response, response_offset = get_resumable(session, URL, offset, params={'id' : self.id})
 
         for key, value in response.cookies.items():
             if key.startswith('download_warning'):
                 params = {'id': self.id, 'confirm': value}
-                response = session.get(URL, params=params, stream=True, timeout=DOWNLOAD_TIMEOUT)
-                response.raise_for_status()
+                response, response_offset = get_resumable(session, URL, offset, params=params)
 
-        return response.iter_content(chunk_size=chunk_size), total_size
+        return (response.iter_content(chunk_size=chunk_size), download_size(response, response_offset, total_size),
+            response_offset)
 
 FileSource.types['google_drive'] = FileSourceGoogleDrive
 
@@ -17,6 +17,7 @@
 """
 
 import argparse
+import concurrent.futures
 import hashlib
 import re
 import requests
@@ -25,6 +26,7 @@ import shutil
 import ssl
 import sys
 import tempfile
+import threading
 import time
 
 from pathlib import Path
@@ -33,19 +35,23 @@ import common
 
 CHUNK_SIZE = 1 << 15 if sys.stdout.isatty() else 1 << 20
 
-failed_topologies = set()
+RETRY_DELAY = 10
 
-def process_download(chunk_iterable, size, file):
+def process_download(chunk_iterable, size, file, hasher, show_progress=True):
     start_time = time.monotonic()
-    progress_size = 0
+    start_size = file.tell()
+    progress_size = start_size
 
     try:
         for chunk in chunk_iterable:
             if chunk:
+                file.write(chunk)
+                hasher.update(chunk)
+
                 duration = time.monotonic() - start_time
                 progress_size += len(chunk)
-                if duration != 0:
-                    speed = progress_size // (1024 * duration)
+                if show_progress and duration != 0:
+                    speed = (progress_size - start_size) // (1024 * duration)
                     if size == 0:
                         percent = '---'
                     else:
@@ -54,25 +60,42 @@ def process_download(chunk_iterable, size, file):
                     print('... %s%%, %d KB, %d KB/s, %d seconds passed' %
                             (percent, progress_size / 1024, speed, duration),
                         end='\r' if sys.stdout.isatty() else '\n', flush=True)
-
-                file.write(chunk)
     finally:
-        if sys.stdout.isatty():
+        if show_progress and sys.stdout.isatty():
             print()
 
-def try_download(name, file, num_attempts, start_download):
+def try_download(file, num_attempts, start_download, size=None, show_progress=True):
+    """
+    Appends the rest of the file to the partial file and returns the hash of the whole file, or None
+    if all attempts have failed. Every attempt resumes from the data downloaded by the previous ones.
+    """
+    # the partial file may be left by an earlier run, its hash is computed once before resuming it
+    hasher = hashlib.sha256()
+    file.seek(0)
+    while True:
+        chunk = file.read(1 << 20)
+        if not chunk: break
+        hasher.update(chunk)
+
+    if size is not None and file.tell() == size:
+        return hasher
+
     for attempt in range(num_attempts):
         if attempt != 0:
-            retry_delay = 10
-            print("Will retry in {} seconds...".format(retry_delay))
-            time.sleep(retry_delay)
+            print("Will retry in {} seconds...".format(RETRY_DELAY))
+            time.sleep(RETRY_DELAY)
 
         try:
-            chunk_iterable, size = start_download()
-            file.seek(0)
-            file.truncate()
-            process_download(chunk_iterable, size, file)
-            return True
+            chunk_iterable, download_size, offset = start_download(file.tell())
+            if offset != file.tell():
+                # the server cannot resume the download, so it starts over
+                file.seek(0)
+                file.truncate()
+                hasher = hashlib.sha256()
+            elif offset != 0:
+                print('Resuming from {} KB'.format(offset // 1024))
+            process_download(chunk_iterable, download_size, file, hasher, show_progress)
+            return hasher
         except requests.exceptions.ConnectionError as e:
             print("Error Connecting:", e)
         except requests.exceptions.Timeout as e:
@@ -82,21 +105,13 @@ def try_download(name, file, num_attempts, start_download):
         except (requests.exceptions.RequestException, ssl.SSLError) as e:
             print(e)
 
-    failed_topologies.add(name)
-    return False
-
-def verify_hash(file, expected_hash, path, top_name):
-    actual_hash = hashlib.sha256()
-    while True:
-        chunk = file.read(1 << 20)
-        if not chunk: break
-        actual_hash.update(chunk)
+    return None
 
+def verify_hash(actual_hash, expected_hash, path):
     if actual_hash.digest() != bytes.fromhex(expected_hash):
         print('########## Error: Hash mismatch for "{}" ##########'.format(path))
         print('##########     Expected: {}'.format(expected_hash))
         print('##########     Actual:   {}'.format(actual_hash.hexdigest()))
-        failed_topologies.add(top_name)
         return False
     return True
 
@@ -162,21 +177,99 @@ def try_update_cache(cache, hash, source):
         print(e)
         print('########## Warning: Failed to update the cache ##########')
 
-def try_retrieve(name, destination, expected_hash, cache, num_attempts, start_download):
+def partial_path(destination):
+    return destination.with_name(destination.name + '.part')
+
+def try_retrieve(destination, expected_hash, cache, num_attempts, start_download, size=None, show_progress=True):
     destination.parent.mkdir(parents=True, exist_ok=True)
 
     if try_retrieve_from_cache(cache, [[expected_hash, destination]]):
-        return
+        return True
 
     print('========= Downloading {}'.format(destination))
 
-    with destination.open('w+b') as f:
-        if try_download(name, f, num_attempts, start_download):
-            f.seek(0)
-            if verify_hash(f, expected_hash, destination, name):
-                try_update_cache(cache, expected_hash, destination)
+    # the file is downloaded to a partial file, which is kept on failure to resume the download later
+    partial_destination = partial_path(destination)
+    with partial_destination.open('a+b') as f:
+        actual_hash = try_download(f, num_attempts, start_download, size, show_progress)
+
+    if actual_hash is None:
+        print('')
+        return False
+
+    if not verify_hash(actual_hash, expected_hash, destination):
+        partial_destination.unlink()
+        print('')
+        return False
+
+    partial_destination.replace(destination)
+    try_update_cache(cache, expected_hash, destination)
 
+    if not show_progress:
+        print('========= Downloaded {}'.format(destination))
     print('')
+    return True
+
+class SessionPool:
+    """
+    Gives each download thread its own session, since sessions cannot be shared between threads.
+    """
+    def __init__(self):
+        self._local = threading.local()
+        self._sessions = []
+        self._lock = threading.Lock()
+
+    def get(self):
+        session = getattr(self._local, 'session', None)
+        if session is None:
+            session = self._local.session = requests.Session()
+            with self._lock:
+                self._sessions.append(session)
+        return session
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        for session in self._sessions:
+            session.close()
+
+def download_topologies(topologies, output_dir, cache, num_attempts, jobs=1, chunk_size=CHUNK_SIZE):
+    """
+    Downloads the files of the topologies with up to jobs concurrent connections.
+    Returns the names of the topologies which were not downloaded.
+    """
+    failed_topologies = set()
+    # progress lines of concurrent downloads would be interleaved
+    show_progress = jobs == 1
+
+    def download_file(session_pool, top, top_file):
+        if top.name in failed_topologies:
+            return # another file of the topology has failed
+
+        destination = output_dir / top.subdirectory / top_file.name
+        if not try_retrieve(destination, top_file.sha256, cache, num_attempts,
+                lambda offset: top_file.source.start_download(session_pool.get(), chunk_size, offset, top_file.size),
+                top_file.size, show_progress):
+            failed_topologies.add(top.name)
+
+    with SessionPool() as session_pool, \
+            concurrent.futures.ThreadPoolExecutor(max_workers=jobs) as executor:
+        futures = [executor.submit(download_file, session_pool, top, top_file)
+            for top in topologies for top_file in top.files]
+        for future in futures:
+            future.result()
+
+    for top in topologies:
+        if top.name not in failed_topologies: continue
+
+        # the partial files are kept to resume their downloads by the next run
+        for top_file in top.files:
+            destination = output_dir / top.subdirectory / top_file.name
+            if destination.exists():
+                destination.unlink()
+
+    return failed_topologies
 
 class DownloaderArgumentParser(argparse.ArgumentParser):
     def error(self, message):
@@ -193,56 +286,49 @@ def positive_int_arg(value_str):
 
     raise argparse.ArgumentTypeError('must be a positive integer (got {!r})'.format(value_str))
 
-parser = DownloaderArgumentParser(epilog = 'list_topologies.yml - default configuration file')
-parser.add_argument('-c', '--config', type = Path, metavar = 'CONFIG.YML',
-    default = common.get_default_config_path(), help = 'path to YML configuration file')
-parser.add_argument('--name', metavar = 'PAT[,PAT...]',
-    help = 'download only topologies whose names match at least one of the specified patterns')
-parser.add_argument('--list', type = Path, metavar = 'FILE.LST',
-    help = 'download only topologies whose names match at least one of the patterns in the specified file')
-parser.add_argument('--all',  action = 'store_true', help = 'download all topologies from the configuration file')
-parser.add_argument('--print_all', action = 'store_true', help = 'print all available topologies')
-parser.add_argument('-o', '--output_dir', type = Path, metavar = 'DIR',
-    default = Path.cwd(), help = 'path where to save topologies')
-parser.add_argument('--cache_dir', type = Path, metavar = 'DIR',
-    help = 'directory to use as a cache for downloaded files')
-parser.add_argument('--num_attempts', type = positive_int_arg, metavar = 'N', default = 1,
-    help = 'attempt each download up to N times')
-
-args = parser.parse_args()
-cache = NullCache() if args.cache_dir is None else DirCache(args.cache_dir)
-topologies = common.load_topologies_from_args(parser, args)
-
-print('')
-print('###############|| Downloading topologies ||###############')
-print('')
-with requests.Session() as session:
-    for top in topologies:
-        output = args.output_dir / top.subdirectory
-        output.mkdir(parents=True, exist_ok=True)
-
-        for top_file in top.files:
-            destination = output / top_file.name
+def main():
+    parser = DownloaderArgumentParser(epilog = 'list_topologies.yml - default configuration file')
+    parser.add_argument('-c', '--config', type = Path, metavar = 'CONFIG.YML',
+        default = common.get_default_config_path(), help = 'path to YML configuration file')
+    parser.add_argument('--name', metavar = 'PAT[,PAT...]',
+        help = 'download only topologies whose names match at least one of the specified patterns')
+    parser.add_argument('--list', type = Path, metavar = 'FILE.LST',
+        help = 'download only topologies whose names match at least one of the patterns in the specified file')
+    parser.add_argument('--all',  action = 'store_true', help = 'download all topologies from the configuration file')
+    parser.add_argument('--print_all', action = 'store_true', help = 'print all available topologies')
+    parser.add_argument('-o', '--output_dir', type = Path, metavar = 'DIR',
+        default = Path.cwd(), help = 'path where to save topologies')
+    parser.add_argument('--cache_dir', type = Path, metavar = 'DIR',
+        help = 'directory to use as a cache for downloaded files')
+    parser.add_argument('--num_attempts', type = positive_int_arg, metavar = 'N', default = 1,
+        help = 'attempt each download up to N times')
+    parser.add_argument('-j', '--jobs', type = positive_int_arg, metavar = 'N', default = 1,
+        help = 'download up to N files concurrently')
+
+    args = parser.parse_args()
+    cache = NullCache() if args.cache_dir is None else DirCache(args.cache_dir)
+    topologies = common.load_topologies_from_args(parser, args)
 
-            try_retrieve(top.name, destination, top_file.sha256, cache, args.num_attempts,
-                lambda: top_file.source.start_download(session, CHUNK_SIZE, top_file.size))
+    print('')
+    print('###############|| Downloading topologies ||###############')
+    print('')
+    failed_topologies = download_topologies(topologies, args.output_dir, cache, args.num_attempts, args.jobs)
 
-            if top.name in failed_topologies:
-                shutil.rmtree(str(output))
-                break
+    print('')
+    print('###############|| Post processing ||###############')
+    print('')
+    for top in topologies:
+        if top.name in failed_topologies: continue
 
-print('')
-print('###############|| Post processing ||###############')
-print('')
-for top in topologies:
-    if top.name in failed_topologies: continue
+        output = args.output_dir / top.subdirectory
 
-    output = args.output_dir / top.subdirectory
+        for postproc in top.postprocessing:
+            postproc.apply(output)
 
-    for postproc in top.postprocessing:
-        postproc.apply(output)
+    if failed_topologies:
+        print('FAILED:')
+        print(*sorted(failed_topologies), sep='\n')
+        sys.exit(1)
 
-if failed_topologies:
-    print('FAILED:')
-    print(*sorted(failed_topologies), sep='\n')
-    sys.exit(1)
+if __name__ == '__main__':
+    main()
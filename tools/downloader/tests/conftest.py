@@ -0,0 +1,118 @@
+# Copyright (c) 2019 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import http.server
+import re
+import socketserver
+import sys
+import threading
+import time
+
+from pathlib import Path
+
+import pytest
+
+# the tools are scripts importing their modules from their directory
+sys.path.insert(0, str(Path(__file__).resolve().parents[1]))
+
+class ServedFile:
+    def __init__(self, content, supports_ranges=True, drops=(), latency=0):
+        self.content = content
+        self.supports_ranges = supports_ranges
+        # numbers of bytes after which the connection is dropped, one for each of the first requests
+        self.drops = list(drops)
+        self.latency = latency
+        self.requested_ranges = []
+
+class FlakyServer(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    """
+    Local stand-in of a file server which sends files slowly, drops connections in the middle of files
+    and optionally ignores Range requests.
+    """
+    daemon_threads = True
+
+    def __init__(self):
+        super().__init__(('127.0.0.1', 0), FlakyRequestHandler)
+        self.files = {}
+        self.active_connections = 0
+        self.max_active_connections = 0
+        self.lock = threading.Lock()
+
+    def url(self, path):
+        return 'http://127.0.0.1:{}/{}'.format(self.server_address[1], path)
+
+class FlakyRequestHandler(http.server.BaseHTTPRequestHandler):
+    chunk_size = 1024
+
+    def do_GET(self):
+        served = self.server.files.get(self.path.lstrip('/'))
+        if served is None:
+            self.send_error(404)
+            return
+
+        with self.server.lock:
+            self.server.active_connections += 1
+            self.server.max_active_connections = max(
+                self.server.max_active_connections, self.server.active_connections)
+            drop = served.drops.pop(0) if served.drops else None
+        try:
+            self.send_file(served, drop)
+        finally:
+            with self.server.lock:
+                self.server.active_connections -= 1
+
+    def send_file(self, served, drop):
+        content = served.content
+        match = re.fullmatch(r'bytes=(\d+)-', self.headers.get('Range', ''))
+        served.requested_ranges.append(int(match.group(1)) if match else None)
+
+        start = 0
+        if match and served.supports_ranges:
+            start = int(match.group(1))
+            if start >= len(content):
+                self.send_response(416)
+                self.send_header('Content-Range', 'bytes */{}'.format(len(content)))
+                self.send_header('Content-Length', '0')
+                self.end_headers()
+                return
+            self.send_response(206)
+            self.send_header('Content-Range', 'bytes {}-{}/{}'.format(start, len(content) - 1, len(content)))
+        else:
+            self.send_response(200)
+        self.send_header('Content-Length', str(len(content) - start))
+        self.end_headers()
+
+        sent = 0
+        for offset in range(start, len(content), self.chunk_size):
+            chunk = content[offset:offset + self.chunk_size]
+            if drop is not None and sent + len(chunk) > drop:
+                self.wfile.write(chunk[:drop - sent])
+                self.wfile.flush()
+                self.close_connection = True
+                return
+            time.sleep(served.latency)
+            self.wfile.write(chunk)
+            sent += len(chunk)
+
+    def log_message(self, *args):
+        pass
+
+@pytest.fixture
+def flaky_server():
+    server = FlakyServer()
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    yield server
+    server.shutdown()
+    server.server_close()
@@ -0,0 +1,158 @@
+# Copyright (c) 2019 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import hashlib
+import os
+
+from collections import namedtuple
+from pathlib import Path
+
+import pytest
+
+import common
+import downloader
+
+from conftest import ServedFile
+
+Topology = namedtuple('Topology', ['name', 'subdirectory', 'files'])
+
+@pytest.fixture(autouse=True)
+def no_retry_delay(monkeypatch):
+    monkeypatch.setattr(downloader, 'RETRY_DELAY', 0)
+
+def serve(server, path, content, **kwargs):
+    server.files[path] = ServedFile(content, **kwargs)
+    return server.files[path]
+
+def topology_file(server, path, content, size=True, sha256=None):
+    return common.TopologyFile(path, len(content) if size else None,
+        sha256 or hashlib.sha256(content).hexdigest(), common.FileSourceHttp(server.url(path)))
+
+def download(topologies, output_dir, num_attempts=1, jobs=1):
+    return downloader.download_topologies(topologies, output_dir, downloader.NullCache(), num_attempts, jobs,
+        chunk_size=4096)
+
+class TestDownloader:
+    def test_downloads_files(self, flaky_server, tmp_path):
+        content = os.urandom(50000)
+        serve(flaky_server, 'model.bin', content)
+
+        failed = download([Topology('model', Path('model'), [topology_file(flaky_server, 'model.bin', content)])],
+            tmp_path)
+
+        assert failed == set()
+        assert (tmp_path / 'model' / 'model.bin').read_bytes() == content
+        assert not (tmp_path / 'model' / 'model.bin.part').exists()
+
+    def test_resumes_dropped_connection(self, flaky_server, tmp_path):
+        content = os.urandom(50000)
+        served = serve(flaky_server, 'model.bin', content, drops=[10000, 20000])
+
+        failed = download([Topology('model', Path('model'), [topology_file(flaky_server, 'model.bin', content)])],
+            tmp_path, num_attempts=3)
+
+        assert failed == set()
+        assert (tmp_path / 'model' / 'model.bin').read_bytes() == content
+        assert served.requested_ranges[0] is None
+        assert 0 < served.requested_ranges[1] <= 10000
+        assert served.requested_ranges[1] < served.requested_ranges[2] <= 30000
+
+    def test_restarts_when_server_ignores_ranges(self, flaky_server, tmp_path):
+        content = os.urandom(50000)
+        served = serve(flaky_server, 'model.bin', content, supports_ranges=False, drops=[10000])
+
+        failed = download([Topology('model', Path('model'), [topology_file(flaky_server, 'model.bin', content)])],
+            tmp_path, num_attempts=2)
+
+        assert failed == set()
+        assert (tmp_path / 'model' / 'model.bin').read_bytes() == content
+        assert served.requested_ranges[1] is not None
+
+    def test_keeps_partial_file_of_failed_download_for_next_run(self, flaky_server, tmp_path):
+        content = os.urandom(50000)
+        served = serve(flaky_server, 'model.bin', content, drops=[20000])
+        topology = Topology('model', Path('model'), [topology_file(flaky_server, 'model.bin', content)])
+
+        assert download([topology], tmp_path) == {'model'}
+        assert not (tmp_path / 'model' / 'model.bin').exists()
+        assert 0 < (tmp_path / 'model' / 'model.bin.part').stat().st_size <= 20000
+
+        assert download([topology], tmp_path) == set()
+        assert (tmp_path / 'model' / 'model.bin').read_bytes() == content
+        assert served.requested_ranges[1] > 0
+
+    def test_resumes_without_known_size(self, flaky_server, tmp_path):
+        content = os.urandom(50000)
+        serve(flaky_server, 'model.bin', content, drops=[10000])
+
+        failed = download([Topology('model', Path('model'),
+                [topology_file(flaky_server, 'model.bin', content, size=False)])],
+            tmp_path, num_attempts=2)
+
+        assert failed == set()
+        assert (tmp_path / 'model' / 'model.bin').read_bytes() == content
+
+    def test_restarts_when_partial_file_is_too_long(self, flaky_server, tmp_path):
+        content = os.urandom(5000)
+        serve(flaky_server, 'model.bin', content)
+        (tmp_path / 'model').mkdir()
+        (tmp_path / 'model' / 'model.bin.part').write_bytes(os.urandom(6000))
+
+        failed = download([Topology('model', Path('model'),
+                [topology_file(flaky_server, 'model.bin', content, size=False)])],
+            tmp_path)
+
+        assert failed == set()
+        assert (tmp_path / 'model' / 'model.bin').read_bytes() == content
+
+    def test_hash_mismatch_removes_partial_file(self, flaky_server, tmp_path):
+        content = os.urandom(5000)
+        serve(flaky_server, 'model.bin', content)
+
+        failed = download([Topology('model', Path('model'),
+                [topology_file(flaky_server, 'model.bin', content, sha256='0' * 64)])],
+            tmp_path)
+
+        assert failed == {'model'}
+        assert not (tmp_path / 'model' / 'model.bin').exists()
+        assert not (tmp_path / 'model' / 'model.bin.part').exists()
+
+    def test_failed_file_fails_topology(self, flaky_server, tmp_path):
+        content = os.urandom(5000)
+        serve(flaky_server, 'a.bin', content)
+        topology = Topology('model', Path('model'), [
+            topology_file(flaky_server, 'a.bin', content),
+            common.TopologyFile('b.bin', None, '0' * 64, common.FileSourceHttp(flaky_server.url('missing'))),
+        ])
+
+        assert download([topology], tmp_path) == {'model'}
+        assert not (tmp_path / 'model' / 'a.bin').exists()
+
+    @pytest.mark.parametrize('jobs', [2, 4])
+    def test_concurrent_downloads(self, flaky_server, tmp_path, jobs):
+        topologies = []
+        contents = {}
+        for index in range(6):
+            name = 'model{}.bin'.format(index)
+            contents[name] = os.urandom(20000 + index * 1000)
+            serve(flaky_server, name, contents[name], drops=[5000] if index % 2 else [], latency=0.002)
+            topologies.append(Topology('model{}'.format(index), Path('model{}'.format(index)),
+                [topology_file(flaky_server, name, contents[name])]))
+
+        failed = download(topologies, tmp_path, num_attempts=2, jobs=jobs)
+
+        assert failed == set()
+        for index, (name, content) in enumerate(sorted(contents.items())):
+            assert (tmp_path / 'model{}'.format(index) / name).read_bytes() == content
+        assert 1 < flaky_server.max_active_connections <= jobs